@@ -13,6 +13,7 @@
 #	pragma message("WITH_COROUTINES is not defined, building without asynchronous loading support")
 #endif
 
+#include "Application.h"
 #include "Primitives/Matrix4x4.h"
 #include "Base/Random.h"
 #include "Base/FrameTimer.h"
@@ -21,6 +22,41 @@ using namespace nCine;
 
 namespace Jazz2::Actors
 {
+	// Every PerPixelCollisionStep-th bit starting at bit 0, 1 and 2
+	static constexpr uint64_t CollisionSamplePatterns[] = { 0x9249249249249249ull, 0x2492492492492492ull, 0x4924924924924924ull };
+
+	/** @brief Returns 64 pixels of collision mask row starting at specified pixel, pixels outside of the row are empty */
+	static uint64_t GetCollisionMaskBits(const uint64_t* row, int32_t stride, int32_t start)
+	{
+		int32_t word = (start >> 6);
+		int32_t shift = (start & 63);
+		uint64_t low = (word >= 0 && word < stride ? row[word] : 0);
+		if (shift == 0) {
+			return low;
+		}
+		uint64_t high = (word + 1 >= 0 && word + 1 < stride ? row[word + 1] : 0);
+		return (low >> shift) | (high << (64 - shift));
+	}
+
+	/** @brief Tests every PerPixelCollisionStep-th pixel of both rows 64 pixels at once, the second row is optional */
+	static bool TestCollisionMaskRows(const uint64_t* row1, int32_t stride1, int32_t start1, const uint64_t* row2, int32_t stride2, int32_t start2, int32_t length)
+	{
+		for (int32_t offset = 0; offset < length; offset += 64) {
+			uint64_t bits = CollisionSamplePatterns[(3 - offset % 3) % 3];
+			if (length - offset < 64) {
+				bits &= (1ull << (length - offset)) - 1;
+			}
+			bits &= GetCollisionMaskBits(row1, stride1, start1 + offset);
+			if (row2 != nullptr) {
+				bits &= GetCollisionMaskBits(row2, stride2, start2 + offset);
+			}
+			if (bits != 0) {
+				return true;
+			}
+		}
+		return false;
+	}
+
 	ActorBase::ActorBase()
 		:
 		_state(ActorState::None),
@@ -32,6 +68,7 @@ namespace Jazz2::Actors
 		_frozenTimeLeft(0.0f),
 		_maxHealth(1),
 		_health(1),
+		_collisionCategory(CollisionCategory::Other),
 		_spawnFrames(0.0f),
 		_metadata(nullptr),
 		_renderer(this),
@@ -88,7 +125,7 @@ namespace Jazz2::Actors
 
 		bool success = async_await OnActivatedAsync(details);
 
-		_renderer.setPosition(std::round(_pos.X), std::round(_pos.Y));
+		_renderer.SetLogicPosition(_pos);
 
 		OnUpdateHitbox();
 
@@ -167,7 +204,7 @@ namespace Jazz2::Actors
 		// Objects should override this if they need to.
 	}
 
-	bool ActorBase::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool ActorBase::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (GetState(ActorState::CanBeFrozen)) {
 			HandleFrozenStateChange(other.get());
@@ -428,8 +465,7 @@ namespace Jazz2::Actors
 	{
 		auto it = _metadata->Sounds.find(String::nullTerminatedView(identifier));
 		if (it != _metadata->Sounds.end()) {
-			int idx = (it->second.Buffers.size() > 1 ? Random().Next(0, (int)it->second.Buffers.size()) : 0);
-			return _levelHandler->PlaySfx(it->second.Buffers[idx].get(), Vector3f(_pos.X, _pos.Y, 0.0f), false, gain, pitch);
+			return _levelHandler->PlaySfx(it->second, Vector3f(_pos.X, _pos.Y, 0.0f), false, gain, pitch);
 		} else {
 			return nullptr;
 		}
@@ -669,16 +705,11 @@ namespace Jazz2::Actors
 				return true;
 			}
 
-			//PixelData p;
-			uint8_t* p;
 			GraphicResource* res;
-			bool isFacingLeftCurrent;
-			int x1, y1, x2, y2, xs, dx, dy, stride;
+			const uint64_t* mask;
+			int x1, y1, x2, y2, xs, ys;
 			if (perPixel1) {
 				res = res1;
-				p = res->Base->Mask.get();
-
-				isFacingLeftCurrent = GetState(ActorState::IsFacingLeft);
 
 				x1 = (int)std::max(inter.L, other->AABBInner.L);
 				y1 = (int)std::max(inter.T, other->AABBInner.T);
@@ -686,16 +717,12 @@ namespace Jazz2::Actors
 				y2 = (int)std::min(inter.B, other->AABBInner.B);
 
 				xs = (int)aabb1.L;
+				ys = (int)aabb1.T;
 
 				int frame1 = std::min(_renderer.CurrentFrame, res->FrameCount - 1);
-				dx = (frame1 % res->Base->FrameConfiguration.X) * res->Base->FrameDimensions.X;
-				dy = (frame1 / res->Base->FrameConfiguration.X) * res->Base->FrameDimensions.Y - (int)aabb1.T;
-
+				mask = res->Base->GetCollisionMask(frame1, GetState(ActorState::IsFacingLeft));
 			} else {
 				res = res2;
-				p = res->Base->Mask.get();
-
-				isFacingLeftCurrent = other->GetState(ActorState::IsFacingLeft);
 
 				x1 = (int)std::max(inter.L, AABBInner.L);
 				y1 = (int)std::max(inter.T, AABBInner.T);
@@ -703,25 +730,25 @@ namespace Jazz2::Actors
 				y2 = (int)std::min(inter.B, AABBInner.B);
 
 				xs = (int)aabb2.L;
+				ys = (int)aabb2.T;
 
 				int frame2 = std::min(other->_renderer.CurrentFrame, res->FrameCount - 1);
-				dx = (frame2 % res->Base->FrameConfiguration.X) * res->Base->FrameDimensions.X;
-				dy = (frame2 / res->Base->FrameConfiguration.X) * res->Base->FrameDimensions.Y - (int)aabb2.T;
+				mask = res->Base->GetCollisionMask(frame2, other->GetState(ActorState::IsFacingLeft));
 			}
 
-			stride = res->Base->FrameConfiguration.X * res->Base->FrameDimensions.X;
+			// Graphics without a mask is solid in the whole frame
+			if (mask == nullptr) {
+				return true;
+			}
 
-			// Per-pixel collision check
-			for (int i = x1; i < x2; i += PerPixelCollisionStep) {
-				for (int j = y1; j < y2; j += PerPixelCollisionStep) {
-					int i1 = i - xs;
-					if (isFacingLeftCurrent) {
-						i1 = res->Base->FrameDimensions.X - i1 - 1;
-					}
+			int stride = res->Base->CollisionMaskStride;
+			int height = res->Base->FrameDimensions.Y;
 
-					if (p[((j + dy) * stride) + i1 + dx] > AlphaThreshold) {
-						return true;
-					}
+			// Per-pixel collision check, mirrored mask is used for actors facing left, so pixels are always indexed from the left
+			for (int j = y1; j < y2; j += PerPixelCollisionStep) {
+				int y = j - ys;
+				if (y >= 0 && y < height && TestCollisionMaskRows(mask + y * stride, stride, x1 - xs, nullptr, 0, 0, x2 - x1)) {
+					return true;
 				}
 			}
 		} else {
@@ -731,36 +758,31 @@ namespace Jazz2::Actors
 			int y2 = (int)inter.B;
 
 			int x1s = (int)aabb1.L;
+			int y1s = (int)aabb1.T;
 			int x2s = (int)aabb2.L;
+			int y2s = (int)aabb2.T;
 
 			int frame1 = std::min(_renderer.CurrentFrame, res1->FrameCount - 1);
-			int dx1 = (frame1 % res1->Base->FrameConfiguration.X) * res1->Base->FrameDimensions.X;
-			int dy1 = (frame1 / res1->Base->FrameConfiguration.X) * res1->Base->FrameDimensions.Y - (int)aabb1.T;
-			int stride1 = res1->Base->FrameConfiguration.X * res1->Base->FrameDimensions.X;
+			const uint64_t* mask1 = res1->Base->GetCollisionMask(frame1, GetState(ActorState::IsFacingLeft));
+			int stride1 = res1->Base->CollisionMaskStride;
+			int height1 = res1->Base->FrameDimensions.Y;
 
 			int frame2 = std::min(other->_renderer.CurrentFrame, res2->FrameCount - 1);
-			int dx2 = (frame2 % res2->Base->FrameConfiguration.X) * res2->Base->FrameDimensions.X;
-			int dy2 = (frame2 / res2->Base->FrameConfiguration.X) * res2->Base->FrameDimensions.Y - (int)aabb2.T;
-			int stride2 = res2->Base->FrameConfiguration.X * res2->Base->FrameDimensions.X;
-
-			// Per-pixel collision check
-			auto p1 = res1->Base->Mask.get();
-			auto p2 = res2->Base->Mask.get();
-
-			for (int i = x1; i < x2; i += PerPixelCollisionStep) {
-				for (int j = y1; j < y2; j += PerPixelCollisionStep) {
-					int i1 = i - x1s;
-					if (GetState(ActorState::IsFacingLeft)) {
-						i1 = res1->Base->FrameDimensions.X - i1 - 1;
-					}
-					int i2 = i - x2s;
-					if (other->GetState(ActorState::IsFacingLeft)) {
-						i2 = res2->Base->FrameDimensions.X - i2 - 1;
-					}
+			const uint64_t* mask2 = res2->Base->GetCollisionMask(frame2, other->GetState(ActorState::IsFacingLeft));
+			int stride2 = res2->Base->CollisionMaskStride;
+			int height2 = res2->Base->FrameDimensions.Y;
 
-					if (p1[((j + dy1) * stride1) + i1 + dx1] > AlphaThreshold && p2[((j + dy2) * stride2) + i2 + dx2] > AlphaThreshold) {
-						return true;
-					}
+			if (mask1 == nullptr || mask2 == nullptr) {
+				return true;
+			}
+
+			// Per-pixel collision check, rows of both masks are shifted to the same position and compared 64 pixels at once
+			for (int j = y1; j < y2; j += PerPixelCollisionStep) {
+				int j1 = j - y1s;
+				int j2 = j - y2s;
+				if (j1 >= 0 && j1 < height1 && j2 >= 0 && j2 < height2 &&
+					TestCollisionMaskRows(mask1 + j1 * stride1, stride1, x1 - x1s, mask2 + j2 * stride2, stride2, x1 - x2s, x2 - x1)) {
+					return true;
 				}
 			}
 		}
@@ -809,30 +831,117 @@ namespace Jazz2::Actors
 		int y2 = (int)std::min(inter.B, aabb.B);
 
 		int xs = (int)aabbSelf.L;
+		int ys = (int)aabbSelf.T;
 
 		int frame1 = std::min(_renderer.CurrentFrame, res->FrameCount - 1);
-		int dx = (frame1 % res->Base->FrameConfiguration.X) * res->Base->FrameDimensions.X;
-		int dy = (frame1 / res->Base->FrameConfiguration.X) * res->Base->FrameDimensions.Y - (int)aabbSelf.T;
-		int stride = res->Base->FrameConfiguration.X * res->Base->FrameDimensions.X;
+		const uint64_t* mask = res->Base->GetCollisionMask(frame1, GetState(ActorState::IsFacingLeft));
+		int stride = res->Base->CollisionMaskStride;
+		int height = res->Base->FrameDimensions.Y;
+		if (mask == nullptr) {
+			return true;
+		}
 
-		// Per-pixel collision check
-		auto p = res->Base->Mask.get();
+		// Per-pixel collision check, mirrored mask is used for actors facing left, so pixels are always indexed from the left
+		for (int j = y1; j < y2; j += PerPixelCollisionStep) {
+			int y = j - ys;
+			if (y >= 0 && y < height && TestCollisionMaskRows(mask + y * stride, stride, x1 - xs, nullptr, 0, 0, x2 - x1)) {
+				return true;
+			}
+		}
 
-		for (int i = x1; i < x2; i += PerPixelCollisionStep) {
-			for (int j = y1; j < y2; j += PerPixelCollisionStep) {
-				int i1 = i - xs;
-				if (GetState(ActorState::IsFacingLeft)) {
-					i1 = res->Base->FrameDimensions.X - i1 - 1;
+		return false;
+	}
+
+#if defined(DEATH_DEBUG)
+	bool ActorBase::VerifyCollisionMask(const GenericGraphicResource& base)
+	{
+		int32_t width = base.FrameDimensions.X;
+		int32_t height = base.FrameDimensions.Y;
+		int32_t framesX = base.FrameConfiguration.X;
+		int32_t frameCount = framesX * base.FrameConfiguration.Y;
+		int32_t stride = base.CollisionMaskStride;
+		if (base.Mask == nullptr || base.CollisionMask == nullptr || width <= 0 || height <= 0 || frameCount <= 0) {
+			return true;
+		}
+
+		// Reads the byte mask the same way as per-pixel collisions did before the masks were bit-packed
+		auto isPixelSolid = [&](int32_t frame, bool facingLeft, int32_t x, int32_t y) {
+			if (facingLeft) {
+				x = width - x - 1;
+			}
+			int32_t dx = (frame % framesX) * width;
+			int32_t dy = (frame / framesX) * height;
+			return (base.Mask[(y + dy) * width * framesX + x + dx] > AlphaThreshold);
+		};
+
+		// The first and the last frame of the first row and the last frame of the sheet lie at the sheet edges
+		int32_t frames[] = { 0, framesX - 1, frameCount - 1 };
+		int32_t starts[] = { 0, 1, 2, width / 2, width - 1 };
+
+		// Single mask against a rectangle
+		for (int32_t frame : frames) {
+			for (int32_t facing = 0; facing < 2; facing++) {
+				const uint64_t* mask = base.GetCollisionMask(frame, facing != 0);
+				for (int32_t x1 : starts) {
+					int32_t ends[] = { x1 + 1, std::min(x1 + 65, width), width };
+					for (int32_t x2 : ends) {
+						for (int32_t y1 : { 0, 1, height / 2 }) {
+							bool expected = false;
+							for (int32_t i = x1; i < x2 && !expected; i += PerPixelCollisionStep) {
+								for (int32_t j = y1; j < height && !expected; j += PerPixelCollisionStep) {
+									expected = isPixelSolid(frame, facing != 0, i, j);
+								}
+							}
+
+							bool actual = false;
+							for (int32_t j = y1; j < height && !actual; j += PerPixelCollisionStep) {
+								actual = TestCollisionMaskRows(mask + j * stride, stride, x1, nullptr, 0, 0, x2 - x1);
+							}
+
+							if (expected != actual) {
+								LOGE("Collision mask mismatch in frame %i (facing %s) for [%i, %i) x [%i, %i)", frame, facing != 0 ? "left" : "right", x1, x2, y1, height);
+								return false;
+							}
+						}
+					}
 				}
+			}
+		}
 
-				if (p[((j + dy) * stride) + i1 + dx] > AlphaThreshold) {
-					return true;
+		// Two masks facing opposite directions, the second one is moved by the offset
+		int32_t frame1 = frames[0];
+		int32_t frame2 = frames[2];
+		for (int32_t facing = 0; facing < 2; facing++) {
+			const uint64_t* mask1 = base.GetCollisionMask(frame1, facing != 0);
+			const uint64_t* mask2 = base.GetCollisionMask(frame2, facing == 0);
+			for (int32_t ox : { 1 - width, -width / 2, -1, 0, 1, width / 2, width - 1 }) {
+				for (int32_t oy : { 1 - height, -1, 0, 2, height / 2 }) {
+					int32_t x1 = std::max(0, ox), x2 = std::min(width, ox + width);
+					int32_t y1 = std::max(0, oy), y2 = std::min(height, oy + height);
+
+					bool expected = false;
+					for (int32_t i = x1; i < x2 && !expected; i += PerPixelCollisionStep) {
+						for (int32_t j = y1; j < y2 && !expected; j += PerPixelCollisionStep) {
+							expected = (isPixelSolid(frame1, facing != 0, i, j) && isPixelSolid(frame2, facing == 0, i - ox, j - oy));
+						}
+					}
+
+					bool actual = false;
+					for (int32_t j = y1; j < y2 && !actual; j += PerPixelCollisionStep) {
+						actual = TestCollisionMaskRows(mask1 + j * stride, stride, x1, mask2 + (j - oy) * stride, stride, x1 - ox, x2 - x1);
+					}
+
+					if (expected != actual) {
+						LOGE("Collision mask mismatch between frames %i and %i (facing %s) at offset [%i, %i]", frame1, frame2, facing != 0 ? "left" : "right", ox, oy);
+						return false;
+					}
 				}
 			}
 		}
 
-		return false;
+		return true;
 	}
+#endif
 
 	bool ActorBase::IsCollidingWithAngled(ActorBase* other)
 	{
@@ -1061,6 +1170,7 @@ namespace Jazz2::Actors
 
 		_renderer.FrameConfiguration = res->Base->FrameConfiguration;
 		_renderer.FrameDimensions = res->Base->FrameDimensions;
+		_renderer.FrameOffset = Vector2i(res->Base->TextureRect.X, res->Base->TextureRect.Y);
 		if (res->AnimDuration < 0.0f) {
 			if (res->FrameCount > 1) {
 				_renderer.FirstFrame = res->FrameOffset + nCine::Random().Next(0, res->FrameCount);
@@ -1082,6 +1192,7 @@ namespace Jazz2::Actors
 		_renderer.Hotspot.X = -((res->Base->FrameDimensions.X / 2) - (IsFacingLeft() ? (res->Base->FrameDimensions.X - res->Base->Hotspot.X) : res->Base->Hotspot.X));
 		_renderer.Hotspot.Y = -((res->Base->FrameDimensions.Y / 2) - res->Base->Hotspot.Y);
 
+		_renderer.SetIndexed(res->Base->IsIndexed());
 		_renderer.setTexture(res->Base->TextureDiffuse.get());
 		_renderer.UpdateVisibleFrames();
 
@@ -1099,19 +1210,16 @@ namespace Jazz2::Actors
 			return 0;
 		}
 
+		// Graphics are indexed by state when metadata is loaded, so only matching entries are visited
 		int i = 0;
-		auto it = _metadata->Graphics.begin();
-		while (it != _metadata->Graphics.end()) {
+		for (auto& entry : _metadata->FindByState(state)) {
 			if (i >= AnimationCandidatesCount) {
 				break;
 			}
 
-			if (it->second.HasState(state)) {
-				candidates[i].Identifier = &it->first;
-				candidates[i].Resource = &it->second;
-				i++;
-			}
-			++it;
+			candidates[i].Identifier = entry.Identifier;
+			candidates[i].Resource = entry.Resource;
+			i++;
 		}
 
 		return i;
@@ -1211,7 +1319,7 @@ namespace Jazz2::Actors
 		if (free) {
 			AABBInner = aabb;
 			_pos = newPos;
-			_renderer.setPosition(std::round(newPos.X), std::round(newPos.Y));
+			_renderer.SetLogicPosition(newPos);
 
 			if ((_state & ActorState::ForceDisableCollisions) != ActorState::ForceDisableCollisions) {
 				_state |= ActorState::IsDirty;
@@ -1234,18 +1342,7 @@ namespace Jazz2::Actors
 
 		_rendererType = type;
 
-		bool shaderChanged;
-		switch (type) {
-			case ActorRendererType::Outline: shaderChanged = renderCommand_.material().setShader(ContentResolver::Get().GetShader(PrecompiledShader::Outline)); break;
-			case ActorRendererType::WhiteMask: shaderChanged = renderCommand_.material().setShader(ContentResolver::Get().GetShader(PrecompiledShader::WhiteMask)); break;
-			case ActorRendererType::PartialWhiteMask: shaderChanged = renderCommand_.material().setShader(ContentResolver::Get().GetShader(PrecompiledShader::PartialWhiteMask)); break;
-			case ActorRendererType::FrozenMask: shaderChanged = renderCommand_.material().setShader(ContentResolver::Get().GetShader(PrecompiledShader::FrozenMask)); break;
-			default: shaderChanged = renderCommand_.material().setShaderProgramType(Material::ShaderProgramType::SPRITE); break;
-		}
-		if (shaderChanged) {
-			shaderHasChanged();
-			renderCommand_.geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, 4);
-
+		if (RefreshShader()) {
 			if (type == ActorRendererType::Outline || type == ActorRendererType::FrozenMask) {
 				_rendererTransition = 0.0f;
 				if (texture_ != nullptr) {
@@ -1258,8 +1355,61 @@ namespace Jazz2::Actors
 		}
 	}
 
+	void ActorBase::ActorRenderer::SetIndexed(bool value)
+	{
+		if (_isIndexed == value) {
+			return;
+		}
+
+		_isIndexed = value;
+		RefreshShader();
+	}
+
+	bool ActorBase::ActorRenderer::RefreshShader()
+	{
+		ContentResolver& resolver = ContentResolver::Get();
+
+		bool shaderChanged;
+		if (_isIndexed) {
+			switch (_rendererType) {
+				case ActorRendererType::Outline: shaderChanged = renderCommand_.material().setShader(resolver.GetShader(PrecompiledShader::IndexedOutline)); break;
+				case ActorRendererType::WhiteMask: shaderChanged = renderCommand_.material().setShader(resolver.GetShader(PrecompiledShader::IndexedWhiteMask)); break;
+				case ActorRendererType::PartialWhiteMask: shaderChanged = renderCommand_.material().setShader(resolver.GetShader(PrecompiledShader::IndexedPartialWhiteMask)); break;
+				case ActorRendererType::FrozenMask: shaderChanged = renderCommand_.material().setShader(resolver.GetShader(PrecompiledShader::IndexedFrozenMask)); break;
+				default: shaderChanged = renderCommand_.material().setShader(resolver.GetShader(PrecompiledShader::Indexed)); break;
+			}
+		} else {
+			switch (_rendererType) {
+				case ActorRendererType::Outline: shaderChanged = renderCommand_.material().setShader(resolver.GetShader(PrecompiledShader::Outline)); break;
+				case ActorRendererType::WhiteMask: shaderChanged = renderCommand_.material().setShader(resolver.GetShader(PrecompiledShader::WhiteMask)); break;
+				case ActorRendererType::PartialWhiteMask: shaderChanged = renderCommand_.material().setShader(resolver.GetShader(PrecompiledShader::PartialWhiteMask)); break;
+				case ActorRendererType::FrozenMask: shaderChanged = renderCommand_.material().setShader(resolver.GetShader(PrecompiledShader::FrozenMask)); break;
+				default: shaderChanged = renderCommand_.material().setShaderProgramType(Material::ShaderProgramType::SPRITE); break;
+			}
+		}
+		if (shaderChanged) {
+			shaderHasChanged();
+			renderCommand_.geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, 4);
+			if (_isIndexed) {
+				resolver.BindPaletteTexture(renderCommand_.material());
+			} else {
+				renderCommand_.material().setTexture(1, nullptr);
+			}
+		}
+		return shaderChanged;
+	}
+
 	void ActorBase::ActorRenderer::OnUpdate(float timeMult)
 	{
+		if (_isInterpolated) {
+			// Restore the position from the last update, so the interpolated one is never used by the game logic,
+			// the flag is cleared by SetLogicPosition() if the actor was moved since the draw
+			setPosition(_updatedPos);
+			_isInterpolated = false;
+		}
+		_lastPos = position();
+		_canInterpolate = true;
+
 		_owner->OnUpdate(timeMult);
 
 		if (IsAnimationRunning()) {
@@ -1310,6 +1460,20 @@ namespace Jazz2::Actors
 
 	bool ActorBase::ActorRenderer::OnDraw(RenderQueue& renderQueue)
 	{
+		float factor = theApplication().interpolationFactor();
+		if (factor < 1.0f && _canInterpolate) {
+			if (!_isInterpolated) {
+				_updatedPos = position();
+			}
+			Vector2f diff = _updatedPos - _lastPos;
+			if (diff != Vector2f::Zero && diff.SqrLength() < MaxInterpolationDistance * MaxInterpolationDistance) {
+				setPosition(std::round(_lastPos.X + diff.X * factor), std::round(_lastPos.Y + diff.Y * factor));
+				// Transformation was already computed during the update, so it has to be refreshed here
+				transform();
+				_isInterpolated = true;
+			}
+		}
+
 		if (_owner->OnDraw(renderQueue)) {
 			return true;
 		}
@@ -1366,7 +1530,7 @@ namespace Jazz2::Actors
 		// Set current animation frame rectangle
 		int col = CurrentFrame % FrameConfiguration.X;
 		int row = CurrentFrame / FrameConfiguration.X;
-		setTexRect(Recti(FrameDimensions.X * col, FrameDimensions.Y * row, FrameDimensions.X, FrameDimensions.Y));
+		setTexRect(Recti(FrameOffset.X + FrameDimensions.X * col, FrameOffset.Y + FrameDimensions.Y * row, FrameDimensions.X, FrameDimensions.Y));
 		setAbsAnchorPoint((float)Hotspot.X, (float)Hotspot.Y);
 	}
 
@@ -115,6 +115,23 @@ namespace Jazz2::Actors
 		FrozenMask
 	};
 
+	/** @brief Category of actor stored in collision proxy, so queries can skip actors of other types without casting */
+	enum class CollisionCategory : uint32_t {
+		None = 0,
+
+		Player = 0x01,
+		Enemy = 0x02,
+		Shot = 0x04,
+		SolidObject = 0x08,
+		Collectible = 0x10,
+		/** @brief Actors that don't derive from any of the base classes above */
+		Other = 0x80000000,
+
+		All = 0xFFFFFFFF
+	};
+
+	DEFINE_ENUM_OPERATORS(CollisionCategory);
+
 	class ActorBase : public std::enable_shared_from_this<ActorBase>
 	{
 		friend class Jazz2::LevelHandler;
@@ -131,7 +148,7 @@ namespace Jazz2::Actors
 
 		void SetParent(SceneNode* parent);
 		Task<bool> OnActivated(const ActorActivationDetails& details);
-		virtual bool OnHandleCollision(std::shared_ptr<ActorBase> other);
+		virtual bool OnHandleCollision(const std::shared_ptr<ActorBase>& other);
 
 		bool IsInvulnerable();
 		int GetHealth();
@@ -152,6 +169,11 @@ namespace Jazz2::Actors
 		bool IsCollidingWith(const AABBf& aabb);
 		void UpdateAABB();
 
+#if defined(DEATH_DEBUG)
+		/// @brief Checks that bit-packed collision masks give the same results as sampling the byte mask pixel by pixel
+		static bool VerifyCollisionMask(const GenericGraphicResource& base);
+#endif
+
 		const Vector2f& GetPos() {
 			return _pos;
 		}
@@ -170,6 +192,11 @@ namespace Jazz2::Actors
 			return (_state & flag) == flag;
 		}
 
+		constexpr CollisionCategory GetCollisionCategory() const noexcept
+		{
+			return _collisionCategory;
+		}
+
 	protected:
 		struct AnimationCandidate {
 			const String* Identifier;
@@ -184,9 +211,9 @@ namespace Jazz2::Actors
 			ActorRenderer(ActorBase* owner)
 				:
 				BaseSprite(nullptr, nullptr, 0.0f, 0.0f), AnimPaused(false),
-				FrameConfiguration(), FrameDimensions(), LoopMode(AnimationLoopMode::Loop),
+				FrameConfiguration(), FrameDimensions(), FrameOffset(), LoopMode(AnimationLoopMode::Loop),
 				FirstFrame(0), FrameCount(0), AnimDuration(0.0f), AnimTime(0.0f), CurrentFrame(0), Hotspot(),
-				_owner(owner), _rendererType((ActorRendererType)-1), _rendererTransition(0.0f)
+				_owner(owner), _rendererType((ActorRendererType)-1), _rendererTransition(0.0f), _isIndexed(false), _canInterpolate(false), _isInterpolated(false)
 			{
 				type_ = ObjectType::Sprite;
 				Initialize(ActorRendererType::Default);
@@ -196,6 +223,8 @@ namespace Jazz2::Actors
 
 			Vector2i FrameConfiguration;
 			Vector2i FrameDimensions;
+			// Position of the sprite sheet in the texture, it's non-zero if the sheet is packed in the sprite atlas
+			Vector2i FrameOffset;
 			AnimationLoopMode LoopMode;
 			int FirstFrame;
 			int FrameCount;
@@ -205,6 +234,8 @@ namespace Jazz2::Actors
 			Vector2i Hotspot;
 
 			void Initialize(ActorRendererType type);
+			/** @brief Sets whether the current texture contains palette indices, so palette lookup variants of shaders are used */
+			void SetIndexed(bool value);
 
 			void OnUpdate(float timeMult) override;
 			bool OnDraw(RenderQueue& renderQueue) override;
@@ -215,16 +246,33 @@ namespace Jazz2::Actors
 			void textureHasChanged(Texture* newTexture) override;
 
 		private:
+			// Larger movements between two updates (e.g., teleports) are not interpolated
+			static constexpr float MaxInterpolationDistance = 64.0f;
+
 			ActorBase* _owner;
 			ActorRendererType _rendererType;
 			float _rendererTransition;
+			bool _isIndexed;
+			// Positions before and after the last update, used to interpolate rendering with fixed update rate
+			Vector2f _lastPos;
+			Vector2f _updatedPos;
+			bool _canInterpolate;
+			bool _isInterpolated;
+
+			/** @brief Moves the sprite from the game logic, the position is kept on the next update even if the last draw was interpolated */
+			void SetLogicPosition(const Vector2f& pos) {
+				setPosition(std::round(pos.X), std::round(pos.Y));
+				_isInterpolated = false;
+			}
 
+			bool RefreshShader();
 			void UpdateVisibleFrames();
 			static int NormalizeFrame(int frame, int min, int max);
 		};
 
-		static constexpr uint8_t AlphaThreshold = 40;
+		static constexpr uint8_t AlphaThreshold = GenericGraphicResource::AlphaThreshold;
 		static constexpr float CollisionCheckStep = 0.5f;
+		// Collision masks are sampled using precomputed bit patterns, see CollisionSamplePatterns
 		static constexpr int PerPixelCollisionStep = 3;
 		static constexpr int AnimationCandidatesCount = 5;
 
@@ -240,6 +288,7 @@ namespace Jazz2::Actors
 		float _frozenTimeLeft;
 		int _maxHealth;
 		int _health;
+		CollisionCategory _collisionCategory;
 
 		Vector2i _originTile;
 		float _spawnFrames;
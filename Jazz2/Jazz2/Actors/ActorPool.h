@@ -0,0 +1,104 @@
+﻿#pragma once
+
+#include "../../Common.h"
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace Jazz2::Actors
+{
+	/** @brief Allocator that reuses memory of destroyed actors of the same type, should be used through @ref CreatePooled() */
+	template<typename T>
+	class PoolAllocator
+	{
+		template<typename U>
+		friend class PoolAllocator;
+
+	public:
+		using value_type = T;
+
+		// Number of free blocks kept for each type, the rest is returned to the system
+		static constexpr std::int32_t MaxPooledCount = 64;
+
+		PoolAllocator() noexcept { }
+
+		template<typename U>
+		PoolAllocator(const PoolAllocator<U>&) noexcept { }
+
+		T* allocate(std::size_t n)
+		{
+			if (n == 1) {
+				Pool& pool = GetPool();
+				if (pool.Head != nullptr) {
+					FreeBlock* block = pool.Head;
+					pool.Head = block->Next;
+					pool.Count--;
+					return reinterpret_cast<T*>(block);
+				}
+			}
+			return static_cast<T*>(::operator new(n * sizeof(T)));
+		}
+
+		void deallocate(T* p, std::size_t n) noexcept
+		{
+			if (n == 1) {
+				Pool& pool = GetPool();
+				if (pool.Count < MaxPooledCount) {
+					FreeBlock* block = reinterpret_cast<FreeBlock*>(p);
+					block->Next = pool.Head;
+					pool.Head = block;
+					pool.Count++;
+					return;
+				}
+			}
+			::operator delete(p);
+		}
+
+		template<typename U>
+		bool operator==(const PoolAllocator<U>&) const noexcept {
+			return true;
+		}
+
+		template<typename U>
+		bool operator!=(const PoolAllocator<U>&) const noexcept {
+			return false;
+		}
+
+	private:
+		struct FreeBlock {
+			FreeBlock* Next;
+		};
+
+		struct Pool {
+			FreeBlock* Head = nullptr;
+			std::int32_t Count = 0;
+
+			~Pool()
+			{
+				while (Head != nullptr) {
+					FreeBlock* next = Head->Next;
+					::operator delete(Head);
+					Head = next;
+				}
+			}
+		};
+
+		static_assert(sizeof(T) >= sizeof(FreeBlock), "Pooled type is too small");
+
+		// Each type (including the control block of std::shared_ptr) has its own free list, so blocks always have the same size
+		static Pool& GetPool()
+		{
+			thread_local Pool pool;
+			return pool;
+		}
+	};
+
+	/** @brief Creates a new actor, memory of destroyed actors of the same type is reused */
+	template<typename T, typename... Args>
+	std::shared_ptr<T> CreatePooled(Args&&... args)
+	{
+		return std::allocate_shared<T>(PoolAllocator<T>(), std::forward<Args>(args)...);
+	}
+}
@@ -19,6 +19,7 @@ namespace Jazz2::Actors::Collectibles
 		_timeLeft(0.0f),
 		_startingY(0.0f)
 	{
+		_collisionCategory = CollisionCategory::Collectible;
 	}
 
 	Task<bool> CollectibleBase::OnActivatedAsync(const ActorActivationDetails& details)
@@ -91,7 +92,7 @@ namespace Jazz2::Actors::Collectibles
 		}
 	}
 
-	bool CollectibleBase::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool CollectibleBase::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (auto player = dynamic_cast<Player*>(other.get())) {
 			OnCollect(player);
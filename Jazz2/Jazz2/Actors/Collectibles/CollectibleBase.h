@@ -14,7 +14,7 @@ namespace Jazz2::Actors::Collectibles
 	public:
 		CollectibleBase();
 
-		bool OnHandleCollision(std::shared_ptr<ActorBase> other) override;
+		bool OnHandleCollision(const std::shared_ptr<ActorBase>& other) override;
 
 	protected:
 		static constexpr int IlluminateLightCount = 20;
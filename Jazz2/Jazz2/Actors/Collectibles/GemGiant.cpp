@@ -32,7 +32,7 @@ namespace Jazz2::Actors::Collectibles
 		async_return true;
 	}
 
-	bool GemGiant::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool GemGiant::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (auto shotBase = dynamic_cast<Weapons::ShotBase*>(other.get())) {
 			if (shotBase->GetStrength() > 0) {
@@ -271,7 +271,7 @@ namespace Jazz2::Actors::Bosses
 		light.RadiusFar = 30.0f;
 	}
 
-	bool Bilsy::Fireball::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool Bilsy::Fireball::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (auto player = dynamic_cast<Player*>(other.get())) {
 			DecreaseHealth(INT32_MAX);
@@ -368,7 +368,7 @@ namespace Jazz2::Actors::Bosses
 		light.RadiusFar = 12.0f;
 	}
 
-	bool Bolly::Rocket::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool Bolly::Rocket::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (auto player = dynamic_cast<Player*>(other.get())) {
 			DecreaseHealth(INT32_MAX);
@@ -47,7 +47,7 @@ namespace Jazz2::Actors::Bosses
 			friend class Bolly;
 
 		public:
-			bool OnHandleCollision(std::shared_ptr<ActorBase> other) override;
+			bool OnHandleCollision(const std::shared_ptr<ActorBase>& other) override;
 
 		protected:
 			Task<bool> OnActivatedAsync(const ActorActivationDetails& details) override;
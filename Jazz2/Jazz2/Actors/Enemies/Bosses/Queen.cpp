@@ -97,7 +97,7 @@ namespace Jazz2::Actors::Bosses
 						return false;
 					}
 					return true;
-				});
+				}, CollisionCategory::Player);
 				break;
 			}
 
@@ -228,7 +228,7 @@ namespace Jazz2::Actors::Bosses
 		_stateTime -= timeMult;
 	}
 
-	bool Queen::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool Queen::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (auto spring = dynamic_cast<Environment::Spring*>(other.get())) {
 			// Collide only with hitbox
@@ -121,7 +121,7 @@ namespace Jazz2::Actors::Bosses
 		_stateTime -= timeMult;
 	}
 
-	bool TurtleBoss::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool TurtleBoss::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (_state == StateAttacking && _stateTime <= 0.0f) {
 			if (auto mace = dynamic_cast<Mace*>(other.get())) {
@@ -251,7 +251,7 @@ namespace Jazz2::Actors::Bosses
 		UpdateHitbox(6, 6);
 	}
 
-	bool Uterus::ShieldPart::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool Uterus::ShieldPart::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (auto shotBase = dynamic_cast<Weapons::ShotBase*>(other.get())) {
 			DecreaseHealth(shotBase->GetStrength(), shotBase);
@@ -36,7 +36,7 @@ namespace Jazz2::Actors::Bosses
 			float Phase;
 			float FallTime;
 
-			bool OnHandleCollision(std::shared_ptr<ActorBase> other) override;
+			bool OnHandleCollision(const std::shared_ptr<ActorBase>& other) override;
 
 			void Recover(float phase);
 
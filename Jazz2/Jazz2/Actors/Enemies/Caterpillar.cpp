@@ -89,7 +89,7 @@ namespace Jazz2::Actors::Enemies
 		}
 	}
 
-	bool Caterpillar::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool Caterpillar::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (auto shotBase = dynamic_cast<Weapons::ShotBase*>(other.get())) {
 			if (_state != StateDisoriented) {
@@ -149,7 +149,7 @@ namespace Jazz2::Actors::Enemies
 		}
 	}
 
-	bool Caterpillar::Smoke::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool Caterpillar::Smoke::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (auto player = dynamic_cast<Player*>(other.get())) {
 			if (player->SetDizzyTime(180.0f)) {
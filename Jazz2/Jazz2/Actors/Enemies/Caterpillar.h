@@ -11,7 +11,7 @@ namespace Jazz2::Actors::Enemies
 
 		static void Preload(const ActorActivationDetails& details);
 
-		bool OnHandleCollision(std::shared_ptr<ActorBase> other) override;
+		bool OnHandleCollision(const std::shared_ptr<ActorBase>& other) override;
 
 	protected:
 		Task<bool> OnActivatedAsync(const ActorActivationDetails& details) override;
@@ -25,7 +25,7 @@ namespace Jazz2::Actors::Enemies
 		class Smoke : public EnemyBase
 		{
 		public:
-			bool OnHandleCollision(std::shared_ptr<ActorBase> other) override;
+			bool OnHandleCollision(const std::shared_ptr<ActorBase>& other) override;
 
 		protected:
 			Task<bool> OnActivatedAsync(const ActorActivationDetails& details) override;
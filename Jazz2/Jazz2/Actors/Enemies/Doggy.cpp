@@ -110,7 +110,7 @@ namespace Jazz2::Actors::Enemies
 		UpdateHitbox(50, 30);
 	}
 
-	bool Doggy::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool Doggy::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (auto shotBase = dynamic_cast<Weapons::ShotBase*>(other.get())) {
 			DecreaseHealth(shotBase->GetStrength(), shotBase);
@@ -26,6 +26,8 @@ namespace Jazz2::Actors::Enemies
 		_lastHitDir(LastHitDirection::None),
 		_blinkingTimeout(0.0f)
 	{
+		_collisionCategory = CollisionCategory::Enemy;
+
 		SetState(ActorState::TriggersTNT, true);
 	}
 
@@ -155,7 +157,7 @@ namespace Jazz2::Actors::Enemies
 		}
 	}
 
-	bool EnemyBase::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool EnemyBase::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (!GetState(ActorState::IsInvulnerable)) {
 			if (auto shotBase = dynamic_cast<Weapons::ShotBase*>(other.get())) {
@@ -232,6 +234,7 @@ namespace Jazz2::Actors::Enemies
 			constexpr int DebrisSize = 3;
 
 			Vector2i texSize = res->Base->TextureDiffuse->size();
+			Vector2i framePos = res->Base->GetFrameTexturePosition(_renderer.CurrentFrame);
 
 			for (int fy = 0; fy < res->Base->FrameDimensions.Y; fy += DebrisSize + 1) {
 				for (int fx = 0; fx < res->Base->FrameDimensions.X; fx += DebrisSize + 1) {
@@ -252,12 +255,15 @@ namespace Jazz2::Actors::Enemies
 					debris.Time = 320.0f;
 
 					debris.TexScaleX = (currentSize / float(texSize.X));
-					debris.TexBiasX = (((float)(_renderer.CurrentFrame % res->Base->FrameConfiguration.X) / res->Base->FrameConfiguration.X) + ((float)fx / float(texSize.X)));
+					debris.TexBiasX = ((float)(framePos.X + fx) / float(texSize.X));
 					debris.TexScaleY = (currentSize / float(texSize.Y));
-					debris.TexBiasY = (((float)(_renderer.CurrentFrame / res->Base->FrameConfiguration.X) / res->Base->FrameConfiguration.Y) + ((float)fy / float(texSize.Y)));
+					debris.TexBiasY = ((float)(framePos.Y + fy) / float(texSize.Y));
 
 					debris.DiffuseTexture = texture;
 					debris.Flags = Tiles::TileMap::DebrisFlags::Bounce;
+					if (res->Base->IsIndexed()) {
+						debris.Flags |= Tiles::TileMap::DebrisFlags::Indexed;
+					}
 
 					tilemap->CreateDebris(debris);
 				}
@@ -269,6 +275,7 @@ namespace Jazz2::Actors::Enemies
 			constexpr int DebrisSize = 3;
 
 			Vector2i texSize = res->Base->TextureDiffuse->size();
+			Vector2i framePos = res->Base->GetFrameTexturePosition(_renderer.CurrentFrame);
 
 			for (int fy = 0; fy < res->Base->FrameDimensions.Y; fy += DebrisSize + 1) {
 				for (int fx = 0; fx < res->Base->FrameDimensions.X; fx += DebrisSize + 1) {
@@ -290,12 +297,15 @@ namespace Jazz2::Actors::Enemies
 					debris.Time = Random().FastFloat(10.0f, 50.0f);
 
 					debris.TexScaleX = (currentSize / float(texSize.X));
-					debris.TexBiasX = (((float)(_renderer.CurrentFrame % res->Base->FrameConfiguration.X) / res->Base->FrameConfiguration.X) + ((float)fx / float(texSize.X)));
+					debris.TexBiasX = ((float)(framePos.X + fx) / float(texSize.X));
 					debris.TexScaleY = (currentSize / float(texSize.Y));
-					debris.TexBiasY = (((float)(_renderer.CurrentFrame / res->Base->FrameConfiguration.X) / res->Base->FrameConfiguration.Y) + ((float)fy / float(texSize.Y)));
+					debris.TexBiasY = ((float)(framePos.Y + fy) / float(texSize.Y));
 
 					debris.DiffuseTexture = texture;
 					debris.Flags = Tiles::TileMap::DebrisFlags::Disappear;
+					if (res->Base->IsIndexed()) {
+						debris.Flags |= Tiles::TileMap::DebrisFlags::Indexed;
+					}
 
 					tilemap->CreateDebris(debris);
 				}
@@ -307,6 +317,7 @@ namespace Jazz2::Actors::Enemies
 			constexpr int DebrisSize = 3;
 
 			Vector2i texSize = res->Base->TextureDiffuse->size();
+			Vector2i framePos = res->Base->GetFrameTexturePosition(_renderer.CurrentFrame);
 
 			for (int fy = 0; fy < res->Base->FrameDimensions.Y; fy += DebrisSize + 1) {
 				for (int fx = 0; fx < res->Base->FrameDimensions.X; fx += DebrisSize + 1) {
@@ -327,12 +338,15 @@ namespace Jazz2::Actors::Enemies
 					debris.Time = Random().FastFloat(300.0f, 340.0f);;
 
 					debris.TexScaleX = (currentSize / float(texSize.X));
-					debris.TexBiasX = (((float)(_renderer.CurrentFrame % res->Base->FrameConfiguration.X) / res->Base->FrameConfiguration.X) + ((float)fx / float(texSize.X)));
+					debris.TexBiasX = ((float)(framePos.X + fx) / float(texSize.X));
 					debris.TexScaleY = (currentSize / float(texSize.Y));
-					debris.TexBiasY = (((float)(_renderer.CurrentFrame / res->Base->FrameConfiguration.X) / res->Base->FrameConfiguration.Y) + ((float)fy / float(texSize.Y)));
+					debris.TexBiasY = ((float)(framePos.Y + fy) / float(texSize.Y));
 
 					debris.DiffuseTexture = texture;
 					debris.Flags = Tiles::TileMap::DebrisFlags::Disappear;
+					if (res->Base->IsIndexed()) {
+						debris.Flags |= Tiles::TileMap::DebrisFlags::Indexed;
+					}
 
 					tilemap->CreateDebris(debris);
 				}
@@ -23,7 +23,7 @@ namespace Jazz2::Actors::Enemies
 		class BulletSpit : public EnemyBase
 		{
 		public:
-			bool OnHandleCollision(std::shared_ptr<ActorBase> other) override;
+			bool OnHandleCollision(const std::shared_ptr<ActorBase>& other) override;
 
 		protected:
 			Task<bool> OnActivatedAsync(const ActorActivationDetails& details) override;
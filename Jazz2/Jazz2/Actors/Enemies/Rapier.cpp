@@ -103,6 +103,7 @@ namespace Jazz2::Actors::Enemies
 
 			GraphicResource* res = (_currentTransitionState != AnimState::Idle ? _currentTransition : _currentAnimation);
 			Vector2i texSize = res->Base->TextureDiffuse->size();
+			Vector2i framePos = res->Base->GetFrameTexturePosition(_renderer.CurrentFrame);
 
 			float x = _pos.X - res->Base->Hotspot.X;
 			float y = _pos.Y - res->Base->Hotspot.Y;
@@ -127,12 +128,15 @@ namespace Jazz2::Actors::Enemies
 					debris.Time = 280.0f;
 
 					debris.TexScaleX = (currentSize / float(texSize.X));
-					debris.TexBiasX = (((float)(_renderer.CurrentFrame % res->Base->FrameConfiguration.X) / res->Base->FrameConfiguration.X) + ((float)fx / float(texSize.X)));
+					debris.TexBiasX = ((float)(framePos.X + fx) / float(texSize.X));
 					debris.TexScaleY = (currentSize / float(texSize.Y));
-					debris.TexBiasY = (((float)(_renderer.CurrentFrame / res->Base->FrameConfiguration.X) / res->Base->FrameConfiguration.Y) + ((float)fy / float(texSize.Y)));
+					debris.TexBiasY = ((float)(framePos.Y + fy) / float(texSize.Y));
 
 					debris.DiffuseTexture = res->Base->TextureDiffuse.get();
 					debris.Flags = Tiles::TileMap::DebrisFlags::Disappear;
+					if (res->Base->IsIndexed()) {
+						debris.Flags |= Tiles::TileMap::DebrisFlags::Indexed;
+					}
 
 					tilemap->CreateDebris(debris);
 				}
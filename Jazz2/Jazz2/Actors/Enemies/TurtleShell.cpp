@@ -114,7 +114,7 @@ namespace Jazz2::Actors::Enemies
 		return EnemyBase::OnPerish(collider);
 	}
 
-	bool TurtleShell::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool TurtleShell::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		EnemyBase::OnHandleCollision(other);
 
@@ -170,7 +170,7 @@ namespace Jazz2::Actors::Enemies
 		UpdateHitbox(10, 10);
 	}
 
-	bool Witch::MagicBullet::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool Witch::MagicBullet::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (auto player = dynamic_cast<Player*>(other.get())) {
 			DecreaseHealth(INT32_MAX);
@@ -38,7 +38,7 @@ namespace Jazz2::Actors::Environment
 		}
 	}
 
-	bool AirboardGenerator::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool AirboardGenerator::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (auto player = dynamic_cast<Player*>(other.get())) {
 			if (_active && player->SetModifier(Player::Modifier::Airboard)) {
@@ -1,5 +1,6 @@
 ﻿#include "Bird.h"
 #include "../../ILevelHandler.h"
+#include "../ActorPool.h"
 #include "../Player.h"
 #include "../Enemies/EnemyBase.h"
 #include "../Weapons/BlasterShot.h"
@@ -115,7 +116,7 @@ namespace Jazz2::Actors::Environment
 		PlaySfx("Fly"_s, 0.3f);
 	}
 
-	bool Bird::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool Bird::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (_attackTime > 0.0f && !other->IsInvulnerable()) {
 			if (auto enemy = dynamic_cast<Enemies::EnemyBase*>(other.get())) {
@@ -162,7 +163,7 @@ namespace Jazz2::Actors::Environment
 							uint8_t shotParams[1] = { 0 };
 							std::shared_ptr<ActorBase> sharedOwner = _owner->shared_from_this();
 
-							std::shared_ptr<Weapons::BlasterShot> shot1 = std::make_shared<Weapons::BlasterShot>();
+							std::shared_ptr<Weapons::BlasterShot> shot1 = CreatePooled<Weapons::BlasterShot>();
 							shot1->OnActivated({
 								.LevelHandler = _levelHandler,
 								.Pos = Vector3i((int)_pos.X, (int)_pos.Y, _renderer.layer() - 2),
@@ -171,7 +172,7 @@ namespace Jazz2::Actors::Environment
 							shot1->OnFire(sharedOwner, _pos, _speed, 0.0f, IsFacingLeft());
 							_levelHandler->AddActor(shot1);
 
-							std::shared_ptr<Weapons::BlasterShot> shot2 = std::make_shared<Weapons::BlasterShot>();
+							std::shared_ptr<Weapons::BlasterShot> shot2 = CreatePooled<Weapons::BlasterShot>();
 							shot2->OnActivated({
 								.LevelHandler = _levelHandler,
 								.Pos = Vector3i((int)_pos.X, (int)_pos.Y, _renderer.layer() - 2),
@@ -210,7 +211,7 @@ namespace Jazz2::Actors::Environment
 				}
 			}
 			return true;
-		});
+		}, CollisionCategory::Enemy);
 
 	}
 }
\ No newline at end of file
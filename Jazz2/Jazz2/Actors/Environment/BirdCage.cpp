@@ -53,7 +53,7 @@ namespace Jazz2::Actors::Environment
 		async_return true;
 	}
 
-	bool BirdCage::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool BirdCage::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (!_activated) {
 			if (auto shotBase = dynamic_cast<Weapons::ShotBase*>(other.get())) {
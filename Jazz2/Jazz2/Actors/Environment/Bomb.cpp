@@ -71,7 +71,7 @@ namespace Jazz2::Actors::Environment
 				}
 			}
 			return true;
-		});
+		}, CollisionCategory::Player);
 
 		// Explosion.Large is the same as Explosion.Bomb
 		Explosion::Create(_levelHandler, Vector3i((int)_pos.X, (int)_pos.Y, _renderer.layer()), Explosion::Type::Large);
@@ -66,7 +66,7 @@ namespace Jazz2::Actors::Environment
 		UpdateHitbox(20, 20);
 	}
 
-	bool Checkpoint::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool Checkpoint::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (_activated) {
 			return true;
@@ -68,7 +68,7 @@ namespace Jazz2::Actors::Environment
 		}
 	}
 
-	bool Copter::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool Copter::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (_state == State::Free || _state == State::Unmounted) {
 			if (auto player = dynamic_cast<Player*>(other.get())) {
@@ -15,7 +15,7 @@ namespace Jazz2::Actors::Environment
 			PreloadMetadataAsync("Enemy/LizardFloat"_s);
 		}
 
-		bool OnHandleCollision(std::shared_ptr<ActorBase> other) override;
+		bool OnHandleCollision(const std::shared_ptr<ActorBase>& other) override;
 
 		void Unmount(float timeLeft);
 
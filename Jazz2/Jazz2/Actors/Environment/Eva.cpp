@@ -37,7 +37,7 @@ namespace Jazz2::Actors::Environment
 		}
 	}
 
-	bool Eva::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool Eva::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (auto player = dynamic_cast<Player*>(other.get())) {
 			if (player->GetPlayerType() == PlayerType::Frog && player->DisableControllable(160.0f)) {
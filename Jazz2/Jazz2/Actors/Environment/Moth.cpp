@@ -63,7 +63,7 @@ namespace Jazz2::Actors::Environment
 		}
 	}
 
-	bool Moth::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool Moth::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (auto player = dynamic_cast<Player*>(other.get())) {
 			if (_timer <= 50.0f) {
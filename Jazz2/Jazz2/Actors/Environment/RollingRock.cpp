@@ -125,7 +125,7 @@ namespace Jazz2::Actors::Environment
 		UpdateHitbox(50, 50);
 	}
 
-	bool RollingRock::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool RollingRock::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (auto rollingRock = dynamic_cast<RollingRock*>(other.get())) {
 			float dx = (rollingRock->_pos.X - _pos.X);
@@ -161,7 +161,7 @@ namespace Jazz2::Actors::Environment
 		}
 	}
 
-	bool Spring::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool Spring::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (_state == State::Frozen) {
 			ActorBase* actorBase = other.get();
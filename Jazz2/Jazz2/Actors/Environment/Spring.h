@@ -11,7 +11,7 @@ namespace Jazz2::Actors::Environment
 
 		bool KeepSpeedX, KeepSpeedY;
 
-		bool OnHandleCollision(std::shared_ptr<ActorBase> other) override;
+		bool OnHandleCollision(const std::shared_ptr<ActorBase>& other) override;
 
 		static void Preload(const ActorActivationDetails& details)
 		{
@@ -42,16 +42,9 @@ namespace Jazz2::Actors::Environment
 
 		for (int i = 0; i < ChunkCount; i++) {
 			_chunks[i] = std::make_unique<RenderCommand>();
-			_chunks[i]->material().setShaderProgramType(Material::ShaderProgramType::SPRITE);
 			_chunks[i]->material().setBlendingEnabled(true);
-			_chunks[i]->material().reserveUniformsDataMemory();
 			_chunks[i]->geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, 4);
 			_chunks[i]->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-			GLUniformCache* textureUniform = _chunks[i]->material().uniform(Material::TextureUniformName);
-			if (textureUniform && textureUniform->intValue(0) != 0) {
-				textureUniform->setIntValue(0); // GL_TEXTURE0
-			}
 		}
 
 		async_return true;
@@ -121,6 +114,8 @@ namespace Jazz2::Actors::Environment
 				float chunkTexSize = ChunkSize / texSize.Y;
 				float chunkAngle = sinf(_phase - i * 0.08f) * 1.2f;
 
+				ContentResolver::Get().ApplySpriteShader(command->material(), resBase->IsIndexed());
+
 				auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
 				instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(1.0f, 0.0f, chunkTexSize, chunkTexSize * i);
 				instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(texSize.X, ChunkSize);
@@ -139,7 +134,7 @@ namespace Jazz2::Actors::Environment
 		return true;
 	}
 
-	bool SwingingVine::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool SwingingVine::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (auto player = dynamic_cast<Player*>(other.get())) {
 			if (player->_springCooldown <= 0.0f) {
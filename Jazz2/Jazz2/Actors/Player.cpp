@@ -3,6 +3,7 @@
 #include "../Events/EventMap.h"
 #include "../Tiles/TileMap.h"
 #include "../PreferencesCache.h"
+#include "ActorPool.h"
 #include "SolidObjectBase.h"
 #include "Explosion.h"
 #include "PlayerCorpse.h"
@@ -79,6 +80,7 @@ namespace Jazz2::Actors
 		_weaponAllowed(true),
 		_weaponWheelState(WeaponWheelState::Hidden)
 	{
+		_collisionCategory = CollisionCategory::Player;
 	}
 
 	Player::~Player()
@@ -310,12 +312,15 @@ namespace Jazz2::Actors
 							debris.Time = 160.0f;
 
 							debris.TexScaleX = (size.X / float(texSize.X));
-							debris.TexBiasX = 0.0f;
+							debris.TexBiasX = (it->second.Base->TextureRect.X / float(texSize.X));
 							debris.TexScaleY = (size.Y / float(texSize.Y));
-							debris.TexBiasY = 0.0f;
+							debris.TexBiasY = (it->second.Base->TextureRect.Y / float(texSize.Y));
 
 							debris.DiffuseTexture = it->second.Base->TextureDiffuse.get();
 							debris.Flags = Tiles::TileMap::DebrisFlags::AdditiveBlending;
+							if (it->second.Base->IsIndexed()) {
+								debris.Flags |= Tiles::TileMap::DebrisFlags::Indexed;
+							}
 
 							tilemap->CreateDebris(debris);
 						}
@@ -441,8 +446,8 @@ namespace Jazz2::Actors
 						if (it != _metadata->Graphics.end()) {
 							Vector2i texSize = it->second.Base->TextureDiffuse->size();
 							Vector2i size = it->second.Base->FrameDimensions;
-							Vector2i frameConf = it->second.Base->FrameConfiguration;
 							int frame = it->second.FrameOffset + Random().Next(0, it->second.FrameCount);
+							Vector2i framePos = it->second.Base->GetFrameTexturePosition(frame);
 							float speedX = Random().FastFloat(-4.0f, 4.0f);
 
 							Tiles::TileMap::DestructibleDebris debris = { };
@@ -462,11 +467,14 @@ namespace Jazz2::Actors
 							debris.Time = 160.0f;
 
 							debris.TexScaleX = (size.X / float(texSize.X));
-							debris.TexBiasX = ((float)(frame % frameConf.X) / frameConf.X);
+							debris.TexBiasX = (framePos.X / float(texSize.X));
 							debris.TexScaleY = (size.Y / float(texSize.Y));
-							debris.TexBiasY = ((float)(frame / frameConf.X) / frameConf.Y);
+							debris.TexBiasY = (framePos.Y / float(texSize.Y));
 
 							debris.DiffuseTexture = it->second.Base->TextureDiffuse.get();
+							if (it->second.Base->IsIndexed()) {
+								debris.Flags |= Tiles::TileMap::DebrisFlags::Indexed;
+							}
 
 							tilemap->CreateDebris(debris);
 						}
@@ -1053,27 +1061,20 @@ namespace Jazz2::Actors
 						command->material().setBlendingEnabled(true);
 					}
 
-					if (command->material().setShaderProgramType(Material::ShaderProgramType::SPRITE)) {
-						command->material().reserveUniformsDataMemory();
+					if (ContentResolver::Get().ApplySpriteShader(command->material(), it->second.Base->IsIndexed())) {
 						command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE);
 						command->geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, 4);
-
-						GLUniformCache* textureUniform = command->material().uniform(Material::TextureUniformName);
-						if (textureUniform && textureUniform->intValue(0) != 0) {
-							textureUniform->setIntValue(0); // GL_TEXTURE0
-						}
 					}
 
 					float frames = _levelHandler->ElapsedFrames();
 
 					Vector2i texSize = it->second.Base->TextureDiffuse->size();
 					int curAnimFrame = it->second.FrameOffset + ((int)(frames * 0.24f) % it->second.FrameCount);
-					int col = curAnimFrame % it->second.Base->FrameConfiguration.X;
-					int row = curAnimFrame / it->second.Base->FrameConfiguration.X;
+					Vector2i framePos = it->second.Base->GetFrameTexturePosition(curAnimFrame);
 					float texScaleX = (float(it->second.Base->FrameDimensions.X) / float(texSize.X));
-					float texBiasX = (float(it->second.Base->FrameDimensions.X * col) / float(texSize.X));
+					float texBiasX = (float(framePos.X) / float(texSize.X));
 					float texScaleY = (float(it->second.Base->FrameDimensions.Y) / float(texSize.Y));
-					float texBiasY = (float(it->second.Base->FrameDimensions.Y * row) / float(texSize.Y));
+					float texBiasY = (float(framePos.Y) / float(texSize.Y));
 
 					auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
 					instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
@@ -1242,7 +1243,7 @@ namespace Jazz2::Actors
 		}
 	}
 
-	bool Player::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool Player::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		bool handled = false;
 		bool removeSpecialMove = false;
@@ -2231,8 +2232,7 @@ namespace Jazz2::Actors
 	{
 		auto it = _metadata->Sounds.find(String::nullTerminatedView(identifier));
 		if (it != _metadata->Sounds.end()) {
-			int idx = (it->second.Buffers.size() > 1 ? Random().Next(0, (int)it->second.Buffers.size()) : 0);
-			return _levelHandler->PlaySfx(it->second.Buffers[idx].get(), Vector3f(0.0f, 0.0f, 0.0f), true, gain, pitch);
+			return _levelHandler->PlaySfx(it->second, Vector3f(0.0f, 0.0f, 0.0f), true, gain, pitch);
 		} else {
 			return nullptr;
 		}
@@ -2391,7 +2391,7 @@ namespace Jazz2::Actors
 		float angle;
 		GetFirePointAndAngle(initialPos, gunspotPos, angle);
 
-		std::shared_ptr<T> shot = std::make_shared<T>();
+		std::shared_ptr<T> shot = CreatePooled<T>();
 		uint8_t shotParams[1] = { _weaponUpgrades[(int)weaponType] };
 		shot->OnActivated({
 			.LevelHandler = _levelHandler,
@@ -2414,7 +2414,7 @@ namespace Jazz2::Actors
 		uint8_t shotParams[1] = { _weaponUpgrades[(int)WeaponType::RF] };
 
 		if ((_weaponUpgrades[(int)WeaponType::RF] & 0x1) != 0) {
-			std::shared_ptr<Weapons::RFShot> shot1 = std::make_shared<Weapons::RFShot>();
+			std::shared_ptr<Weapons::RFShot> shot1 = CreatePooled<Weapons::RFShot>();
 			shot1->OnActivated({
 				.LevelHandler = _levelHandler,
 				.Pos = initialPos,
@@ -2423,7 +2423,7 @@ namespace Jazz2::Actors
 			shot1->OnFire(shared_from_this(), gunspotPos, _speed, angle - 0.3f, IsFacingLeft());
 			_levelHandler->AddActor(shot1);
 
-			std::shared_ptr<Weapons::RFShot> shot2 = std::make_shared<Weapons::RFShot>();
+			std::shared_ptr<Weapons::RFShot> shot2 = CreatePooled<Weapons::RFShot>();
 			shot2->OnActivated({
 				.LevelHandler = _levelHandler,
 				.Pos = initialPos,
@@ -2432,7 +2432,7 @@ namespace Jazz2::Actors
 			shot2->OnFire(shared_from_this(), gunspotPos, _speed, angle, IsFacingLeft());
 			_levelHandler->AddActor(shot2);
 
-			std::shared_ptr<Weapons::RFShot> shot3 = std::make_shared<Weapons::RFShot>();
+			std::shared_ptr<Weapons::RFShot> shot3 = CreatePooled<Weapons::RFShot>();
 			shot3->OnActivated({
 				.LevelHandler = _levelHandler,
 				.Pos = initialPos,
@@ -2441,7 +2441,7 @@ namespace Jazz2::Actors
 			shot3->OnFire(shared_from_this(), gunspotPos, _speed, angle + 0.3f, IsFacingLeft());
 			_levelHandler->AddActor(shot3);
 		} else {
-			std::shared_ptr<Weapons::RFShot> shot1 = std::make_shared<Weapons::RFShot>();
+			std::shared_ptr<Weapons::RFShot> shot1 = CreatePooled<Weapons::RFShot>();
 			shot1->OnActivated({
 				.LevelHandler = _levelHandler,
 				.Pos = initialPos,
@@ -2450,7 +2450,7 @@ namespace Jazz2::Actors
 			shot1->OnFire(shared_from_this(), gunspotPos, _speed, angle - 0.22f, IsFacingLeft());
 			_levelHandler->AddActor(shot1);
 
-			std::shared_ptr<Weapons::RFShot> shot2 = std::make_shared<Weapons::RFShot>();
+			std::shared_ptr<Weapons::RFShot> shot2 = CreatePooled<Weapons::RFShot>();
 			shot2->OnActivated({
 				.LevelHandler = _levelHandler,
 				.Pos = initialPos,
@@ -2472,7 +2472,7 @@ namespace Jazz2::Actors
 
 		uint8_t shotParams[1] = { _weaponUpgrades[(int)WeaponType::Pepper] };
 
-		std::shared_ptr<Weapons::PepperShot> shot1 = std::make_shared<Weapons::PepperShot>();
+		std::shared_ptr<Weapons::PepperShot> shot1 = CreatePooled<Weapons::PepperShot>();
 		shot1->OnActivated({
 			.LevelHandler = _levelHandler,
 			.Pos = initialPos,
@@ -2481,7 +2481,7 @@ namespace Jazz2::Actors
 		shot1->OnFire(shared_from_this(), gunspotPos, _speed, angle - Random().NextFloat(-0.2f, 0.2f), IsFacingLeft());
 		_levelHandler->AddActor(shot1);
 
-		std::shared_ptr<Weapons::PepperShot> shot2 = std::make_shared<Weapons::PepperShot>();
+		std::shared_ptr<Weapons::PepperShot> shot2 = CreatePooled<Weapons::PepperShot>();
 		shot2->OnActivated({
 			.LevelHandler = _levelHandler,
 			.Pos = initialPos,
@@ -2495,7 +2495,7 @@ namespace Jazz2::Actors
 
 	void Player::FireWeaponTNT()
 	{
-		std::shared_ptr<Weapons::TNT> tnt = std::make_shared<Weapons::TNT>();
+		std::shared_ptr<Weapons::TNT> tnt = CreatePooled<Weapons::TNT>();
 		tnt->OnActivated({
 			.LevelHandler = _levelHandler,
 			.Pos = Vector3i((int)_pos.X, (int)_pos.Y, _renderer.layer() - 2)
@@ -2518,7 +2518,7 @@ namespace Jazz2::Actors
 		float angle;
 		GetFirePointAndAngle(initialPos, gunspotPos, angle);
 
-		std::shared_ptr<Weapons::Thunderbolt> shot = std::make_shared<Weapons::Thunderbolt>();
+		std::shared_ptr<Weapons::Thunderbolt> shot = CreatePooled<Weapons::Thunderbolt>();
 		uint8_t shotParams[1] = { _weaponUpgrades[(int)WeaponType::Thunderbolt] };
 		shot->OnActivated({
 			.LevelHandler = _levelHandler,
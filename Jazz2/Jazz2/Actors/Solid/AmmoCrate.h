@@ -9,7 +9,7 @@ namespace Jazz2::Actors::Solid
 	public:
 		AmmoCrate();
 
-		bool OnHandleCollision(std::shared_ptr<ActorBase> other) override;
+		bool OnHandleCollision(const std::shared_ptr<ActorBase>& other) override;
 
 		static void Preload(const ActorActivationDetails& details);
 
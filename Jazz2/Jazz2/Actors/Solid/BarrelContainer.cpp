@@ -33,7 +33,7 @@ namespace Jazz2::Actors::Solid
 		async_return true;
 	}
 
-	bool BarrelContainer::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool BarrelContainer::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (_health == 0) {
 			return GenericContainer::OnHandleCollision(other);
@@ -72,16 +72,9 @@ namespace Jazz2::Actors::Solid
 			BridgePiece& piece = _pieces.emplace_back();
 			piece.Pos = Vector2f(_pos.X + widthCovered - 16, _pos.Y);
 			piece.Command = std::make_unique<RenderCommand>();
-			piece.Command->material().setShaderProgramType(Material::ShaderProgramType::SPRITE);
 			piece.Command->material().setBlendingEnabled(true);
-			piece.Command->material().reserveUniformsDataMemory();
 			piece.Command->geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, 4);
 
-			GLUniformCache* textureUniform = piece.Command->material().uniform(Material::TextureUniformName);
-			if (textureUniform && textureUniform->intValue(0) != 0) {
-				textureUniform->setIntValue(0); // GL_TEXTURE0
-			}
-
 			widthCovered += (_widths[i % _widthsCount] + _widths[(i + 1) % _widthsCount]) / 2;
 		}
 
@@ -167,12 +160,13 @@ namespace Jazz2::Actors::Solid
 				auto command = _pieces[i].Command.get();
 
 				int curAnimFrame = _currentAnimation->FrameOffset + (i % _currentAnimation->FrameCount);
-				int col = curAnimFrame % _currentAnimation->Base->FrameConfiguration.X;
-				int row = curAnimFrame / _currentAnimation->Base->FrameConfiguration.X;
+				Vector2i framePos = _currentAnimation->Base->GetFrameTexturePosition(curAnimFrame);
 				float texScaleX = (float(_currentAnimation->Base->FrameDimensions.X) / float(texSize.X));
-				float texBiasX = (float(_currentAnimation->Base->FrameDimensions.X * col) / float(texSize.X));
+				float texBiasX = (float(framePos.X) / float(texSize.X));
 				float texScaleY = (float(_currentAnimation->Base->FrameDimensions.Y) / float(texSize.Y));
-				float texBiasY = (float(_currentAnimation->Base->FrameDimensions.Y * row) / float(texSize.Y));
+				float texBiasY = (float(framePos.Y) / float(texSize.Y));
+
+				ContentResolver::Get().ApplySpriteShader(command->material(), _currentAnimation->Base->IsIndexed());
 
 				auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
 				instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
@@ -68,15 +68,8 @@ namespace Jazz2::Actors::Solid
 		for (int i = 0; i < length; i++) {
 			ChainPiece& piece = _pieces.emplace_back();
 			piece.Command = std::make_unique<RenderCommand>();
-			piece.Command->material().setShaderProgramType(Material::ShaderProgramType::SPRITE);
 			piece.Command->material().setBlendingEnabled(true);
-			piece.Command->material().reserveUniformsDataMemory();
 			piece.Command->geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, 4);
-
-			GLUniformCache* textureUniform = piece.Command->material().uniform(Material::TextureUniformName);
-			if (textureUniform && textureUniform->intValue(0) != 0) {
-				textureUniform->setIntValue(0); // GL_TEXTURE0
-			}
 		}
 
 		async_return true;
@@ -218,12 +211,13 @@ namespace Jazz2::Actors::Solid
 					auto command = _pieces[i].Command.get();
 
 					int curAnimFrame = chainAnim.FrameOffset + (i % chainAnim.FrameCount);
-					int col = curAnimFrame % chainAnim.Base->FrameConfiguration.X;
-					int row = curAnimFrame / chainAnim.Base->FrameConfiguration.X;
+					Vector2i framePos = chainAnim.Base->GetFrameTexturePosition(curAnimFrame);
 					float texScaleX = (float(chainAnim.Base->FrameDimensions.X) / float(texSize.X));
-					float texBiasX = (float(chainAnim.Base->FrameDimensions.X * col) / float(texSize.X));
+					float texBiasX = (float(framePos.X) / float(texSize.X));
 					float texScaleY = (float(chainAnim.Base->FrameDimensions.Y) / float(texSize.Y));
-					float texBiasY = (float(chainAnim.Base->FrameDimensions.Y * row) / float(texSize.Y));
+					float texBiasY = (float(framePos.Y) / float(texSize.Y));
+
+					ContentResolver::Get().ApplySpriteShader(command->material(), chainAnim.Base->IsIndexed());
 
 					auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
 					instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
@@ -65,7 +65,7 @@ namespace Jazz2::Actors::Solid
 					player->AddScore(500);
 				}
 				return true;
-			});
+			}, CollisionCategory::Player);
 		} else {
 			_cooldown -= timeMult;
 		}
@@ -69,7 +69,7 @@ namespace Jazz2::Actors::Solid
 					}
 				}
 				return true;
-			});
+			}, CollisionCategory::Player);
 		} else {
 			_cooldown -= timeMult;
 		}
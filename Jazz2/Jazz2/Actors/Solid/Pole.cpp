@@ -120,7 +120,7 @@ namespace Jazz2::Actors::Solid
 		}
 	}
 
-	bool Pole::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool Pole::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (auto shotBase = dynamic_cast<Weapons::ShotBase*>(other.get())) {
 			if (shotBase->GetStrength() > 0) {
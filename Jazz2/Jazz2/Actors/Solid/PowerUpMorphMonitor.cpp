@@ -48,7 +48,7 @@ namespace Jazz2::Actors::Solid
 		async_return true;
 	}
 
-	bool PowerUpMorphMonitor::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool PowerUpMorphMonitor::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (_health == 0) {
 			return SolidObjectBase::OnHandleCollision(other);
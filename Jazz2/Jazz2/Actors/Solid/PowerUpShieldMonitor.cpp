@@ -39,7 +39,7 @@ namespace Jazz2::Actors::Solid
 		async_return true;
 	}
 
-	bool PowerUpShieldMonitor::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool PowerUpShieldMonitor::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (_health == 0) {
 			return SolidObjectBase::OnHandleCollision(other);
@@ -54,7 +54,7 @@ namespace Jazz2::Actors::Solid
 		async_return true;
 	}
 
-	bool PowerUpWeaponMonitor::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool PowerUpWeaponMonitor::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (_health == 0) {
 			return SolidObjectBase::OnHandleCollision(other);
@@ -39,7 +39,7 @@ namespace Jazz2::Actors::Solid
 		async_return true;
 	}
 
-	bool PushableBox::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool PushableBox::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (auto shotBase = dynamic_cast<Weapons::ShotBase*>(other.get())) {
 			WeaponType weaponType = shotBase->GetWeaponType();
@@ -36,7 +36,7 @@ namespace Jazz2::Actors::Solid
 		async_return true;
 	}
 
-	bool TriggerCrate::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool TriggerCrate::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (_health == 0) {
 			return SolidObjectBase::OnHandleCollision(other);
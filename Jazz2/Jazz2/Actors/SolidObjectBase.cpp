@@ -10,6 +10,7 @@ namespace Jazz2::Actors
 		IsOneWay(false),
 		Movable(false)
 	{
+		_collisionCategory = CollisionCategory::SolidObject;
 		SetState(ActorState::CollideWithSolidObjects | ActorState::CollideWithSolidObjectsBelow |
 			ActorState::IsSolidObject | ActorState::SkipPerPixelCollisions, true);
 	}
@@ -109,14 +109,16 @@ namespace Jazz2::Actors::Weapons
 							debris.Time = 60.0f;
 
 							int curAnimFrame = ((_upgrades & 0x1) != 0 ? 2 : 0) + Random().Fast(0, 2);
-							int col = curAnimFrame % resBase->FrameConfiguration.X;
-							int row = curAnimFrame / resBase->FrameConfiguration.X;
+							Vector2i framePos = resBase->GetFrameTexturePosition(curAnimFrame);
 							debris.TexScaleX = (float(resBase->FrameDimensions.X) / float(texSize.X));
-							debris.TexBiasX = (float(resBase->FrameDimensions.X * col) / float(texSize.X));
+							debris.TexBiasX = (float(framePos.X) / float(texSize.X));
 							debris.TexScaleY = (float(resBase->FrameDimensions.Y) / float(texSize.Y));
-							debris.TexBiasY = (float(resBase->FrameDimensions.Y * row) / float(texSize.Y));
+							debris.TexBiasY = (float(framePos.Y) / float(texSize.Y));
 
 							debris.DiffuseTexture = resBase->TextureDiffuse.get();
+							if (resBase->IsIndexed()) {
+								debris.Flags |= Tiles::TileMap::DebrisFlags::Indexed;
+							}
 
 							tilemap->CreateDebris(debris);
 						}
@@ -145,7 +147,7 @@ namespace Jazz2::Actors::Weapons
 		}
 	}
 
-	bool ElectroShot::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool ElectroShot::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (auto enemyBase = dynamic_cast<Enemies::EnemyBase*>(other.get())) {
 			if (enemyBase->IsInvulnerable() || !enemyBase->CanCollideWithAmmo) {
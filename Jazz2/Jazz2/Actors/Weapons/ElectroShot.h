@@ -15,7 +15,7 @@ namespace Jazz2::Actors::Weapons
 			return WeaponType::Electro;
 		}
 
-		bool OnHandleCollision(std::shared_ptr<ActorBase> other) override;
+		bool OnHandleCollision(const std::shared_ptr<ActorBase>& other) override;
 
 	protected:
 		Task<bool> OnActivatedAsync(const ActorActivationDetails& details) override;
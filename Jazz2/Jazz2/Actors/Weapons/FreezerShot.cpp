@@ -99,6 +99,7 @@ namespace Jazz2::Actors::Weapons
 			auto resBase = _currentAnimation->Base;
 			if (tileMap != nullptr && _pos.Y < _levelHandler->WaterLevel() && resBase->TextureDiffuse != nullptr) {
 				Vector2i texSize = resBase->TextureDiffuse->size();
+				Vector2i framePos = resBase->GetFrameTexturePosition(_renderer.CurrentFrame);
 				float dx = Random().FastFloat(-8.0f, 8.0f);
 				float dy = Random().FastFloat(-3.0f, 3.0f);
 
@@ -116,12 +117,15 @@ namespace Jazz2::Actors::Weapons
 				debris.Time = 300.0f;
 
 				debris.TexScaleX = (currentSize / float(texSize.X));
-				debris.TexBiasX = (((float)(_renderer.CurrentFrame % resBase->FrameConfiguration.X) / resBase->FrameConfiguration.X) + (((resBase->FrameDimensions.X * 0.5f) + dx) / float(texSize.X)));
+				debris.TexBiasX = ((framePos.X + (resBase->FrameDimensions.X * 0.5f) + dx) / float(texSize.X));
 				debris.TexScaleY = (currentSize / float(texSize.Y));
-				debris.TexBiasY = (((float)(_renderer.CurrentFrame / resBase->FrameConfiguration.X) / resBase->FrameConfiguration.Y) + (((resBase->FrameDimensions.Y * 0.5f) + dy) / float(texSize.Y)));
+				debris.TexBiasY = ((framePos.Y + (resBase->FrameDimensions.Y * 0.5f) + dy) / float(texSize.Y));
 
 				debris.DiffuseTexture = resBase->TextureDiffuse.get();
 				debris.Flags = Tiles::TileMap::DebrisFlags::Disappear;
+				if (resBase->IsIndexed()) {
+					debris.Flags |= Tiles::TileMap::DebrisFlags::Indexed;
+				}
 
 				tileMap->CreateDebris(debris);
 			}
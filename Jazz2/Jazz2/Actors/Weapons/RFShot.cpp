@@ -111,7 +111,7 @@ namespace Jazz2::Actors::Weapons
 				player->AddExternalForce(pushLeft ? -4.0f : 4.0f, 0.0f);
 			}
 			return true;
-		});
+		}, CollisionCategory::Player);
 
 		Explosion::Create(_levelHandler, Vector3i((int)(_pos.X + _speed.X), (int)(_pos.Y + _speed.Y), _renderer.layer() + 2), Explosion::Type::RF);
 
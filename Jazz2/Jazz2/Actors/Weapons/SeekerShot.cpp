@@ -109,7 +109,7 @@ namespace Jazz2::Actors::Weapons
 				player->AddExternalForce(pushLeft ? -8.0f : 8.0f, 0.0f);
 			}
 			return true;
-		});
+		}, CollisionCategory::Player);
 
 		Explosion::Create(_levelHandler, Vector3i((int)(_pos.X + _speed.X), (int)(_pos.Y + _speed.Y), _renderer.layer() + 2), Explosion::Type::Large);
 
@@ -137,18 +137,18 @@ namespace Jazz2::Actors::Weapons
 
 		// Max. distance is ~8 tiles
 		_levelHandler->FindCollisionActorsByRadius(_pos.X, _pos.Y, 260.0f, [this, &targetPos, &targetDistance](ActorBase* actor) {
-			if (auto enemyBase = dynamic_cast<Enemies::EnemyBase*>(actor)) {
-				if (!enemyBase->IsInvulnerable() && enemyBase->CanCollideWithAmmo) {
-					Vector2f newPos = enemyBase->GetPos();
-					float distance = (_pos - newPos).Length();
-					if (distance < 260.0f && distance < targetDistance) {
-						targetPos = newPos;
-						targetDistance = distance;
-					}
+			// Only enemies are returned by the query
+			auto enemyBase = static_cast<Enemies::EnemyBase*>(actor);
+			if (!enemyBase->IsInvulnerable() && enemyBase->CanCollideWithAmmo) {
+				Vector2f newPos = enemyBase->GetPos();
+				float distance = (_pos - newPos).Length();
+				if (distance < 260.0f && distance < targetDistance) {
+					targetPos = newPos;
+					targetDistance = distance;
 				}
 			}
 			return true;
-		});
+		}, CollisionCategory::Enemy);
 
 		if (targetDistance < 260.0f) {
 			Vector2f speed = (Vector2f(_speed.X, _speed.Y) + (targetPos - _pos).Normalized() * 2.0f).Normalized();
@@ -18,6 +18,7 @@ namespace Jazz2::Actors::Weapons
 		_strength(0),
 		_lastRicochet(nullptr)
 	{
+		_collisionCategory = CollisionCategory::Shot;
 	}
 
 	Task<bool> ShotBase::OnActivatedAsync(const ActorActivationDetails& details)
@@ -66,7 +67,7 @@ namespace Jazz2::Actors::Weapons
 		}
 	}
 
-	bool ShotBase::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool ShotBase::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (auto enemyBase = dynamic_cast<Enemies::EnemyBase*>(other.get())) {
 			if (enemyBase->CanCollideWithAmmo) {
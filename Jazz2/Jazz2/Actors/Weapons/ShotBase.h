@@ -17,7 +17,7 @@ namespace Jazz2::Actors::Weapons
 	public:
 		ShotBase();
 
-		bool OnHandleCollision(std::shared_ptr<ActorBase> other) override;
+		bool OnHandleCollision(const std::shared_ptr<ActorBase>& other) override;
 
 		inline int GetStrength() {
 			return _strength;
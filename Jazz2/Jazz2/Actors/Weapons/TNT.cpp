@@ -133,7 +133,7 @@ namespace Jazz2::Actors::Weapons
 		}
 	}
 
-	bool TNT::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool TNT::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (auto tnt = dynamic_cast<TNT*>(other.get())) {
 			if (tnt->_isExploded && _timeLeft > 35.0f) {
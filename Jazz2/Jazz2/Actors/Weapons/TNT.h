@@ -9,7 +9,7 @@ namespace Jazz2::Actors::Weapons
 	public:
 		TNT();
 
-		bool OnHandleCollision(std::shared_ptr<ActorBase> other) override;
+		bool OnHandleCollision(const std::shared_ptr<ActorBase>& other) override;
 
 		Player* GetOwner();
 
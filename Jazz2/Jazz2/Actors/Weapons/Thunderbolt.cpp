@@ -144,7 +144,7 @@ namespace Jazz2::Actors::Weapons
 		DecreaseHealth(INT32_MAX);
 	}
 
-	bool Thunderbolt::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool Thunderbolt::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (auto enemyBase = dynamic_cast<Enemies::EnemyBase*>(other.get())) {
 			if (enemyBase->CanCollideWithAmmo) {
@@ -11,7 +11,7 @@ namespace Jazz2::Actors::Weapons
 
 		void OnFire(const std::shared_ptr<ActorBase>& owner, Vector2f gunspotPos, Vector2f speed, float angle, bool isFacingLeft);
 
-		bool OnHandleCollision(std::shared_ptr<ActorBase> other) override;
+		bool OnHandleCollision(const std::shared_ptr<ActorBase>& other) override;
 
 		WeaponType GetWeaponType() override {
 			return WeaponType::Thunderbolt;
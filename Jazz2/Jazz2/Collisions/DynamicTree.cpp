@@ -86,6 +86,8 @@ namespace Jazz2::Collisions
 		m_nodes[nodeId].child2 = NullNode;
 		m_nodes[nodeId].height = 0;
 		m_nodes[nodeId].userData = nullptr;
+		m_nodes[nodeId].categoryBits = 0;
+		m_nodes[nodeId].maskBits = 0;
 		m_nodes[nodeId].moved = false;
 		++m_nodeCount;
 		return nodeId;
@@ -105,7 +107,7 @@ namespace Jazz2::Collisions
 	// Create a proxy in the tree as a leaf node. We return the index
 	// of the node instead of a pointer so that we can grow
 	// the node pool.
-	int32_t DynamicTree::CreateProxy(const AABBf& aabb, void* userData)
+	int32_t DynamicTree::CreateProxy(const AABBf& aabb, void* userData, uint32_t categoryBits, uint32_t maskBits)
 	{
 		int32_t proxyId = AllocateNode();
 
@@ -116,6 +118,8 @@ namespace Jazz2::Collisions
 		m_nodes[proxyId].aabb.R = aabb.R + r.X;
 		m_nodes[proxyId].aabb.B = aabb.B + r.Y;
 		m_nodes[proxyId].userData = userData;
+		m_nodes[proxyId].categoryBits = categoryBits;
+		m_nodes[proxyId].maskBits = maskBits;
 		m_nodes[proxyId].height = 0;
 		m_nodes[proxyId].moved = true;
 
@@ -266,6 +270,7 @@ namespace Jazz2::Collisions
 		m_nodes[newParent].parent = oldParent;
 		m_nodes[newParent].userData = nullptr;
 		m_nodes[newParent].aabb = AABBf::Combine(leafAABB, m_nodes[sibling].aabb);
+		m_nodes[newParent].categoryBits = m_nodes[leaf].categoryBits | m_nodes[sibling].categoryBits;
 		m_nodes[newParent].height = m_nodes[sibling].height + 1;
 
 		if (oldParent != NullNode) {
@@ -302,6 +307,7 @@ namespace Jazz2::Collisions
 
 			m_nodes[index].height = 1 + std::max(m_nodes[child1].height, m_nodes[child2].height);
 			m_nodes[index].aabb = AABBf::Combine(m_nodes[child1].aabb, m_nodes[child2].aabb);
+			m_nodes[index].categoryBits = m_nodes[child1].categoryBits | m_nodes[child2].categoryBits;
 
 			index = m_nodes[index].parent;
 		}
@@ -344,6 +350,7 @@ namespace Jazz2::Collisions
 				int32_t child2 = m_nodes[index].child2;
 
 				m_nodes[index].aabb = AABBf::Combine(m_nodes[child1].aabb, m_nodes[child2].aabb);
+				m_nodes[index].categoryBits = m_nodes[child1].categoryBits | m_nodes[child2].categoryBits;
 				m_nodes[index].height = 1 + std::max(m_nodes[child1].height, m_nodes[child2].height);
 
 				index = m_nodes[index].parent;
@@ -411,6 +418,8 @@ namespace Jazz2::Collisions
 				G->parent = iA;
 				A->aabb = AABBf::Combine(B->aabb, G->aabb);
 				C->aabb = AABBf::Combine(A->aabb, F->aabb);
+				A->categoryBits = B->categoryBits | G->categoryBits;
+				C->categoryBits = A->categoryBits | F->categoryBits;
 
 				A->height = 1 + std::max(B->height, G->height);
 				C->height = 1 + std::max(A->height, F->height);
@@ -420,6 +429,8 @@ namespace Jazz2::Collisions
 				F->parent = iA;
 				A->aabb = AABBf::Combine(B->aabb, F->aabb);
 				C->aabb = AABBf::Combine(A->aabb, G->aabb);
+				A->categoryBits = B->categoryBits | F->categoryBits;
+				C->categoryBits = A->categoryBits | G->categoryBits;
 
 				A->height = 1 + std::max(B->height, F->height);
 				C->height = 1 + std::max(A->height, G->height);
@@ -461,6 +472,8 @@ namespace Jazz2::Collisions
 				E->parent = iA;
 				A->aabb = AABBf::Combine(C->aabb, E->aabb);
 				B->aabb = AABBf::Combine(A->aabb, D->aabb);
+				A->categoryBits = C->categoryBits | E->categoryBits;
+				B->categoryBits = A->categoryBits | D->categoryBits;
 
 				A->height = 1 + std::max(C->height, E->height);
 				B->height = 1 + std::max(A->height, D->height);
@@ -470,6 +483,8 @@ namespace Jazz2::Collisions
 				D->parent = iA;
 				A->aabb = AABBf::Combine(C->aabb, D->aabb);
 				B->aabb = AABBf::Combine(A->aabb, E->aabb);
+				A->categoryBits = C->categoryBits | D->categoryBits;
+				B->categoryBits = A->categoryBits | E->categoryBits;
 
 				A->height = 1 + std::max(C->height, D->height);
 				B->height = 1 + std::max(A->height, E->height);
@@ -690,6 +705,7 @@ namespace Jazz2::Collisions
 			parent->child2 = index2;
 			parent->height = 1 + std::max(child1->height, child2->height);
 			parent->aabb = AABBf::Combine(child1->aabb, child2->aabb);
+			parent->categoryBits = child1->categoryBits | child2->categoryBits;
 			parent->parent = NullNode;
 
 			child1->parent = parentIndex;
@@ -38,6 +38,7 @@ namespace Jazz2::Collisions
 	constexpr float LengthUnitsPerMeter = 1.0f;
 	constexpr float AabbExtension = 0.1f * LengthUnitsPerMeter;
 	constexpr float AabbMultiplier = 4.0f;
+	constexpr uint32_t AllCategories = 0xFFFFFFFFu;
 
 	/// A node in the dynamic tree. The client does not interact with this directly.
 	struct TreeNode
@@ -52,6 +53,11 @@ namespace Jazz2::Collisions
 
 		void* userData;
 
+		/// Categories of the proxy, or union of categories of all proxies in the subtree
+		uint32_t categoryBits;
+		/// Categories the proxy can form pairs with
+		uint32_t maskBits;
+
 		union
 		{
 			int32_t parent;
@@ -85,7 +91,8 @@ namespace Jazz2::Collisions
 		~DynamicTree();
 
 		/// Create a proxy. Provide a tight fitting AABB and a userData pointer.
-		int32_t CreateProxy(const AABBf& aabb, void* userData);
+		/// Category bits are used to filter queries, mask bits to filter pairs.
+		int32_t CreateProxy(const AABBf& aabb, void* userData, uint32_t categoryBits = AllCategories, uint32_t maskBits = AllCategories);
 
 		/// Destroy a proxy. This asserts if the id is invalid.
 		void DestroyProxy(int32_t proxyId);
@@ -100,6 +107,10 @@ namespace Jazz2::Collisions
 		/// @return the proxy user data or 0 if the id is invalid.
 		void* GetUserData(int32_t proxyId) const;
 
+		/// Get proxy category and mask bits.
+		uint32_t GetCategoryBits(int32_t proxyId) const;
+		uint32_t GetMaskBits(int32_t proxyId) const;
+
 		bool WasMoved(int32_t proxyId) const;
 		void ClearMoved(int32_t proxyId);
 
@@ -107,9 +118,10 @@ namespace Jazz2::Collisions
 		const AABBf& GetFatAABB(int32_t proxyId) const;
 
 		/// Query an AABB for overlapping proxies. The callback class
-		/// is called for each proxy that overlaps the supplied AABB.
+		/// is called for each proxy that overlaps the supplied AABB and matches the mask.
+		/// Subtrees that contain no proxy of requested categories are skipped.
 		template<typename T>
-		void Query(T* callback, const AABBf& aabb) const;
+		void Query(T* callback, const AABBf& aabb, uint32_t maskBits = AllCategories) const;
 
 		/// Ray-cast against the proxies in the tree. This relies on the callback
 		/// to perform a exact ray-cast in the case were the proxy contains a shape.
@@ -176,6 +188,16 @@ namespace Jazz2::Collisions
 		return m_nodes[proxyId].userData;
 	}
 
+	inline uint32_t DynamicTree::GetCategoryBits(int32_t proxyId) const
+	{
+		return m_nodes[proxyId].categoryBits;
+	}
+
+	inline uint32_t DynamicTree::GetMaskBits(int32_t proxyId) const
+	{
+		return m_nodes[proxyId].maskBits;
+	}
+
 	inline bool DynamicTree::WasMoved(int32_t proxyId) const
 	{
 		//b2Assert(0 <= proxyId && proxyId < m_nodeCapacity);
@@ -195,7 +217,7 @@ namespace Jazz2::Collisions
 	}
 
 	template<typename T>
-	inline void DynamicTree::Query(T* callback, const AABBf& aabb) const
+	inline void DynamicTree::Query(T* callback, const AABBf& aabb, uint32_t maskBits) const
 	{
 		SmallVector<int32_t, 256> stack;
 		stack.push_back(m_root);
@@ -208,7 +230,7 @@ namespace Jazz2::Collisions
 
 			const TreeNode* node = m_nodes + nodeId;
 
-			if (node->aabb.Overlaps(aabb)) {
+			if ((node->categoryBits & maskBits) != 0 && node->aabb.Overlaps(aabb)) {
 				if (node->IsLeaf()) {
 					bool proceed = callback->OnCollisionQuery(nodeId);
 					if (!proceed) {
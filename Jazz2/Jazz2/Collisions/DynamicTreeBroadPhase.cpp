@@ -43,9 +43,9 @@ namespace Jazz2::Collisions
 		free(m_pairBuffer);
 	}
 
-	int32_t DynamicTreeBroadPhase::CreateProxy(const AABBf& aabb, void* userData)
+	int32_t DynamicTreeBroadPhase::CreateProxy(const AABBf& aabb, void* userData, uint32_t categoryBits, uint32_t maskBits)
 	{
-		int32_t proxyId = m_tree.CreateProxy(aabb, userData);
+		int32_t proxyId = m_tree.CreateProxy(aabb, userData, categoryBits, maskBits);
 		++m_proxyCount;
 		BufferMove(proxyId);
 		return proxyId;
@@ -103,6 +103,11 @@ namespace Jazz2::Collisions
 			return true;
 		}
 
+		// Both proxies have to accept each other.
+		if ((m_tree.GetMaskBits(proxyId) & m_tree.GetCategoryBits(m_queryProxyId)) == 0) {
+			return true;
+		}
+
 		const bool moved = m_tree.WasMoved(proxyId);
 		if (moved && proxyId > m_queryProxyId) {
 			// Both proxies are moving. Avoid duplicate pairs.
@@ -44,7 +44,8 @@ namespace Jazz2::Collisions
 
 		/// Create a proxy with an initial AABB. Pairs are not reported until
 		/// UpdatePairs is called.
-		int32_t CreateProxy(const AABBf& aabb, void* userData);
+		/// Category bits are used to filter queries, mask bits to filter pairs.
+		int32_t CreateProxy(const AABBf& aabb, void* userData, uint32_t categoryBits = AllCategories, uint32_t maskBits = AllCategories);
 
 		/// Destroy a proxy. It is up to the client to remove any pairs.
 		void DestroyProxy(int32_t proxyId);
@@ -73,9 +74,9 @@ namespace Jazz2::Collisions
 		void UpdatePairs(T* callback);
 
 		/// Query an AABB for overlapping proxies. The callback class
-		/// is called for each proxy that overlaps the supplied AABB.
+		/// is called for each proxy that overlaps the supplied AABB and matches the mask.
 		template <typename T>
-		void Query(T* callback, const AABBf& aabb) const;
+		void Query(T* callback, const AABBf& aabb, uint32_t maskBits = AllCategories) const;
 
 		/// Ray-cast against the proxies in the tree. This relies on the callback
 		/// to perform a exact ray-cast in the case were the proxy contains a shape.
@@ -177,7 +178,7 @@ namespace Jazz2::Collisions
 			const AABBf& fatAABB = m_tree.GetFatAABB(m_queryProxyId);
 
 			// Query tree, create pairs and add them pair buffer.
-			m_tree.Query(this, fatAABB);
+			m_tree.Query(this, fatAABB, m_tree.GetMaskBits(m_queryProxyId));
 		}
 
 		// Send pairs to caller
@@ -204,9 +205,9 @@ namespace Jazz2::Collisions
 	}
 
 	template <typename T>
-	inline void DynamicTreeBroadPhase::Query(T* callback, const AABBf& aabb) const
+	inline void DynamicTreeBroadPhase::Query(T* callback, const AABBf& aabb, uint32_t maskBits) const
 	{
-		m_tree.Query(callback, aabb);
+		m_tree.Query(callback, aabb, maskBits);
 	}
 
 	/*template <typename T>
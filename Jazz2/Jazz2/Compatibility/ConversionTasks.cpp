@@ -0,0 +1,68 @@
+﻿#include "ConversionTasks.h"
+
+#if defined(WITH_THREADS)
+#	include "Threading/Thread.h"
+#endif
+
+namespace Jazz2::Compatibility
+{
+	ConversionTasks::ConversionTasks()
+	{
+#if defined(WITH_THREADS)
+		_pendingCount = 0;
+		_completedCount = 0;
+		_totalCount = 0;
+
+		// Spawn workers only if it's worth it, otherwise all tasks are executed on the calling thread
+		uint32_t processorCount = Thread::GetProcessorCount();
+		if (processorCount > 1) {
+			_threadPool = std::make_unique<ThreadPool>(processorCount);
+		}
+#endif
+	}
+
+	ConversionTasks::~ConversionTasks()
+	{
+		// Worker threads drop queued commands on exit, so all tasks must be completed first
+		WaitForCompletion();
+	}
+
+	void ConversionTasks::WaitForCompletion(const std::function<void(float)>& progressCallback)
+	{
+#if defined(WITH_THREADS)
+		_mutex.Lock();
+		int32_t lastCompletedCount = -1;
+		while (_pendingCount > 0) {
+			if (progressCallback != nullptr && lastCompletedCount != _completedCount) {
+				lastCompletedCount = _completedCount;
+				float progress = (float)_completedCount / _totalCount;
+				// Callback is called without the lock, so it can't block workers
+				_mutex.Unlock();
+				progressCallback(progress);
+				_mutex.Lock();
+				continue;
+			}
+			_completedCV.Wait(_mutex);
+		}
+		_completedCount = 0;
+		_totalCount = 0;
+		_mutex.Unlock();
+#endif
+		// Tasks are executed immediately if threading is not available, so only the completion is reported
+		if (progressCallback != nullptr) {
+			progressCallback(1.0f);
+		}
+	}
+
+#if defined(WITH_THREADS)
+	void ConversionTasks::OnTaskCompleted()
+	{
+		_mutex.Lock();
+		_pendingCount--;
+		_completedCount++;
+		// Waiting thread is woken up after each task to report progress
+		_completedCV.Broadcast();
+		_mutex.Unlock();
+	}
+#endif
+}
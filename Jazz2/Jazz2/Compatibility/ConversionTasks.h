@@ -0,0 +1,86 @@
+﻿#pragma once
+
+#include "../../Common.h"
+
+#include <functional>
+#include <memory>
+#include <utility>
+
+#if defined(WITH_THREADS)
+#	include "Threading/ThreadPool.h"
+#	include "Threading/ThreadSync.h"
+#endif
+
+using namespace nCine;
+
+namespace Jazz2::Compatibility
+{
+	/** @brief Runs independent conversion tasks on worker threads and waits for their completion */
+	class ConversionTasks
+	{
+	public:
+		ConversionTasks();
+		~ConversionTasks();
+
+		/** @brief Enqueues a task, it's executed immediately on the calling thread if threading is not available */
+		template<typename Func>
+		void Enqueue(Func&& func)
+		{
+#if defined(WITH_THREADS)
+			if (_threadPool != nullptr) {
+				_mutex.Lock();
+				_pendingCount++;
+				_totalCount++;
+				_mutex.Unlock();
+				_threadPool->EnqueueCommand(std::make_unique<TaskCommand<std::decay_t<Func>>>(this, std::forward<Func>(func)));
+				return;
+			}
+#endif
+			func();
+		}
+
+		/**
+			@brief Blocks the calling thread until all enqueued tasks are completed
+
+			Progress of tasks enqueued since the last call is reported on the calling thread in range 0.0-1.0.
+		*/
+		void WaitForCompletion(const std::function<void(float)>& progressCallback = nullptr);
+
+	private:
+		ConversionTasks(const ConversionTasks&) = delete;
+		ConversionTasks& operator=(const ConversionTasks&) = delete;
+
+#if defined(WITH_THREADS)
+		template<typename Func>
+		class TaskCommand : public IThreadCommand
+		{
+		public:
+			TaskCommand(ConversionTasks* owner, Func&& func)
+				: _owner(owner), _func(std::move(func)) { }
+			TaskCommand(ConversionTasks* owner, const Func& func)
+				: _owner(owner), _func(func) { }
+
+			void Execute() override
+			{
+				_func();
+				_owner->OnTaskCompleted();
+			}
+
+		private:
+			ConversionTasks* _owner;
+			Func _func;
+		};
+
+		Mutex _mutex;
+		CondVariable _completedCV;
+		int32_t _pendingCount;
+		// Counters of the current batch, they are reset when the batch is completed
+		int32_t _completedCount;
+		int32_t _totalCount;
+		// Declared last, so worker threads are joined before the synchronization primitives are destroyed
+		std::unique_ptr<ThreadPool> _threadPool;
+
+		void OnTaskCompleted();
+#endif
+	};
+}
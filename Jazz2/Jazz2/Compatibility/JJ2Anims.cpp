@@ -2,20 +2,27 @@
 #include "JJ2Anims.Palettes.h"
 #include "JJ2Block.h"
 #include "AnimSetMapping.h"
+#include "ConversionTasks.h"
+#include "../PakFile.h"
 
+#include <cstring>
+
+#include <Containers/Pair.h>
 #include <IO/FileSystem.h>
+#include <IO/MappedStream.h>
+#include <IO/MemoryStream.h>
 
 using namespace Death::IO;
 
 namespace Jazz2::Compatibility
 {
-	bool JJ2Anims::Convert(const StringView& path, const StringView& targetPath, bool isPlus)
+	bool JJ2Anims::Convert(const StringView& path, const StringView& targetPath, bool isPlus, const std::function<void(float)>& progressCallback)
 	{
 		JJ2Version version;
 		SmallVector<AnimSection, 0> anims;
 		SmallVector<SampleSection, 0> samples;
 
-		auto s = fs::Open(path, FileAccessMode::Read);
+		auto s = fs::Open(path, FileAccessMode::Read | FileAccessMode::MemoryMapped);
 		ASSERT_MSG(s->IsValid(), "Cannot open file for reading");
 
 		bool seemsLikeCC = false;
@@ -42,8 +49,10 @@ namespace Jazz2::Compatibility
 
 		ASSERT(headerLen == s->GetPosition());
 
-		// Read content
+		// Read content, only headers are read here, blocks of each set are decompressed and parsed on worker threads
 		bool isStreamComplete = true;
+		SmallVector<SetSection, 0> sets;
+		sets.reserve(setCount);
 
 		for (int32_t i = 0; i < setCount; i++) {
 			if (s->GetPosition() >= s->GetSize()) {
@@ -57,194 +66,61 @@ namespace Jazz2::Compatibility
 			uint8_t sndCount = s->ReadValue<uint8_t>();
 			/*uint16_t frameCount =*/ s->ReadValue<uint16_t>();
 			/*uint32_t cumulativeSndIndex =*/ s->ReadValue<uint32_t>();
-			int32_t infoBlockLenC = s->ReadValue<int32_t>();
-			int32_t infoBlockLenU = s->ReadValue<int32_t>();
-			int32_t frameDataBlockLenC = s->ReadValue<int32_t>();
-			int32_t frameDataBlockLenU = s->ReadValue<int32_t>();
-			int32_t imageDataBlockLenC = s->ReadValue<int32_t>();
-			int32_t imageDataBlockLenU = s->ReadValue<int32_t>();
-			int32_t sampleDataBlockLenC = s->ReadValue<int32_t>();
-			int32_t sampleDataBlockLenU = s->ReadValue<int32_t>();
-
-			JJ2Block infoBlock(s, infoBlockLenC, infoBlockLenU);
-			JJ2Block frameDataBlock(s, frameDataBlockLenC, frameDataBlockLenU);
-			JJ2Block imageDataBlock(s, imageDataBlockLenC, imageDataBlockLenU);
-			JJ2Block sampleDataBlock(s, sampleDataBlockLenC, sampleDataBlockLenU);
+			int32_t blockLengths[8];
+			s->Read(blockLengths, sizeof(blockLengths));
+
+			int32_t dataLength = blockLengths[0] + blockLengths[2] + blockLengths[4] + blockLengths[6];
 
 			if (magicANIM != 0x4D494E41) {
 				LOGD("Header for set %i is incorrect (bad magic value), skipping", i);
+				s->Seek(dataLength, SeekOrigin::Current);
 				continue;
 			}
 
-			for (uint16_t j = 0; j < animCount; j++) {
-				AnimSection& anim = anims.emplace_back();
-				anim.Set = i;
-				anim.Anim = j;
-				anim.FrameCount = infoBlock.ReadUInt16();
-				anim.FrameRate = infoBlock.ReadUInt16();
-				anim.Frames.resize(anim.FrameCount);
-
-				// Skip the rest, seems to be 0x00000000 for all headers
-				infoBlock.DiscardBytes(4);
-
-				if (anim.FrameCount > 0) {
-					for (uint16_t k = 0; k < anim.FrameCount; k++) {
-						AnimFrameSection& frame = anim.Frames[k];
-
-						frame.SizeX = frameDataBlock.ReadInt16();
-						frame.SizeY = frameDataBlock.ReadInt16();
-						frame.ColdspotX = frameDataBlock.ReadInt16();
-						frame.ColdspotY = frameDataBlock.ReadInt16();
-						frame.HotspotX = frameDataBlock.ReadInt16();
-						frame.HotspotY = frameDataBlock.ReadInt16();
-						frame.GunspotX = frameDataBlock.ReadInt16();
-						frame.GunspotY = frameDataBlock.ReadInt16();
-
-						frame.ImageAddr = frameDataBlock.ReadInt32();
-						frame.MaskAddr = frameDataBlock.ReadInt32();
-
-						// Adjust normalized position
-						// In the output images, we want to make the hotspot and image size constant.
-						anim.NormalizedHotspotX = std::max((int16_t)-frame.HotspotX, anim.NormalizedHotspotX);
-						anim.NormalizedHotspotY = std::max((int16_t)-frame.HotspotY, anim.NormalizedHotspotY);
-
-						anim.LargestOffsetX = std::max((int16_t)(frame.SizeX + frame.HotspotX), anim.LargestOffsetX);
-						anim.LargestOffsetY = std::max((int16_t)(frame.SizeY + frame.HotspotY), anim.LargestOffsetY);
-
-						anim.AdjustedSizeX = std::max(
-							(int16_t)(anim.NormalizedHotspotX + anim.LargestOffsetX),
-							anim.AdjustedSizeX
-						);
-						anim.AdjustedSizeY = std::max(
-							(int16_t)(anim.NormalizedHotspotY + anim.LargestOffsetY),
-							anim.AdjustedSizeY
-						);
-
-						int32_t dpos = (frame.ImageAddr + 4);
-
-						imageDataBlock.SeekTo(dpos - 4);
-						uint16_t width2 = imageDataBlock.ReadUInt16();
-						imageDataBlock.SeekTo(dpos - 2);
-						/*uint16_t height2 =*/ imageDataBlock.ReadUInt16();
-
-						frame.DrawTransparent = (width2 & 0x8000) > 0;
-
-						int32_t pxRead = 0;
-						int32_t pxTotal = (frame.SizeX * frame.SizeY);
-						bool lastOpEmpty = true;
-
-						frame.ImageData = std::make_unique<uint8_t[]>(pxTotal);
-
-						imageDataBlock.SeekTo(dpos);
-
-						while (pxRead < pxTotal) {
-							uint8_t op = imageDataBlock.ReadByte();
-							if (op < 0x80) {
-								// Skip the given number of pixels, writing them with the transparent color 0, array should be already zeroed
-								pxRead += op;
-							} else if (op == 0x80) {
-								// Skip until the end of the line, array should be already zeroed
-								uint16_t linePxLeft = (uint16_t)(frame.SizeX - pxRead % frame.SizeX);
-								if (pxRead % frame.SizeX == 0 && !lastOpEmpty) {
-									linePxLeft = 0;
-								}
-
-								pxRead += linePxLeft;
-							} else {
-								// Copy specified amount of pixels (ignoring the high bit)
-								uint16_t bytesToRead = (uint16_t)(op & 0x7F);
-								imageDataBlock.ReadRawBytes(frame.ImageData.get() + pxRead, bytesToRead);
-								pxRead += bytesToRead;
-							}
-
-							lastOpEmpty = (op == 0x80);
-						}
-
-						// TODO: Sprite mask
-						/*frame.MaskData = std::make_unique<uint8_t[]>(pxTotal);
-
-						if (frame.MaskAddr != 0xFFFFFFFF) {
-							imageDataBlock.SeekTo(frame.MaskAddr);
-							pxRead = 0;
-							while (pxRead < pxTotal) {
-								uint8_t b = imageDataBlock.ReadByte();
-								for (uint8_t bit = 0; bit < 8 && (pxRead + bit) < pxTotal; ++bit) {
-									frame.MaskData[pxRead + bit] = ((b & (1 << (7 - bit))) != 0);
-								}
-								pxRead += 8;
-							}
-						}*/
-					}
-				}
+			SetSection& set = sets.emplace_back();
+			set.Index = i;
+			set.AnimCount = animCount;
+			set.SampleCount = sndCount;
+			std::memcpy(set.BlockLengths, blockLengths, sizeof(blockLengths));
+			set.DataLength = dataLength;
+
+			if (s->GetType() == Stream::Type::Mapped && s->GetPosition() + dataLength <= s->GetSize()) {
+				// Mapped file stays open until all sets are parsed, so the data don't have to be copied
+				set.Data = static_cast<MappedStream*>(s.get())->GetBuffer() + s->GetPosition();
+				s->Seek(dataLength, SeekOrigin::Current);
+			} else {
+				set.OwnedData = std::make_unique<uint8_t[]>(dataLength);
+				s->Read(set.OwnedData.get(), dataLength);
+				set.Data = set.OwnedData.get();
 			}
 
 			if (i == 65 && animCount > 5) {
 				seemsLikeCC = true;
 			}
+		}
 
-			for (uint16_t j = 0; j < sndCount; j++) {
-				SampleSection& sample = samples.emplace_back();
-				sample.IdInSet = j;
-				sample.Set = i;
-
-				int32_t totalSize = sampleDataBlock.ReadInt32();
-				uint32_t magicRIFF = sampleDataBlock.ReadUInt32();
-				int32_t chunkSize = sampleDataBlock.ReadInt32();
-				// "ASFF" for 1.20, "AS  " for 1.24
-				uint32_t format = sampleDataBlock.ReadUInt32();
-				ASSERT(format == 0x46465341 || format == 0x20205341);
-				bool isASFF = (format == 0x46465341);
-
-				uint32_t magicSAMP = sampleDataBlock.ReadUInt32();
-				/*uint32_t sampSize =*/ sampleDataBlock.ReadUInt32();
-				ASSERT_MSG(magicRIFF == 0x46464952 && magicSAMP == 0x504D4153, "Sample has invalid header");
-
-				// Padding/unknown data #1
-				// For set 0 sample 0:
-				//       1.20                           1.24
-				//  +00  00 00 00 00 00 00 00 00   +00  40 00 00 00 00 00 00 00
-				//  +08  00 00 00 00 00 00 00 00   +08  00 00 00 00 00 00 00 00
-				//  +10  00 00 00 00 00 00 00 00   +10  00 00 00 00 00 00 00 00
-				//  +18  00 00 00 00               +18  00 00 00 00 00 00 00 00
-				//                                 +20  00 00 00 00 00 40 FF 7F
-				sampleDataBlock.DiscardBytes(40 - (isASFF ? 12 : 0));
-				if (isASFF) {
-					// All 1.20 samples seem to be 8-bit. Some of them are among those
-					// for which 1.24 reads as 24-bit but that might just be a mistake.
-					sampleDataBlock.DiscardBytes(2);
-					sample.Multiplier = 0;
-				} else {
-					// for 1.24. 1.20 has "20 40" instead in s0s0 which makes no sense
-					sample.Multiplier = sampleDataBlock.ReadUInt16();
-				}
-				// Unknown. s0s0 1.20: 00 80, 1.24: 80 00
-				sampleDataBlock.DiscardBytes(2);
-
-				/*uint32_t payloadSize =*/ sampleDataBlock.ReadUInt32();
-				// Padding #2, all zeroes in both
-				sampleDataBlock.DiscardBytes(8);
-
-				sample.SampleRate = sampleDataBlock.ReadUInt32();
-				sample.DataSize = chunkSize - 76 + (isASFF ? 12 : 0);
-
-				sample.Data = std::make_unique<uint8_t[]>(sample.DataSize);
-				sampleDataBlock.ReadRawBytes(sample.Data.get(), sample.DataSize);
-				// Padding #3
-				sampleDataBlock.DiscardBytes(4);
-
-				/*if (sample.Data.Length < actualDataSize) {
-					Log.Write(LogType.Warning, "Sample " + j + " in set " + i + " was shorter than expected! Expected "
-						+ actualDataSize + " bytes, but read " + sample.Data.Length + " instead.");
-				}*/
-
-				if (totalSize > chunkSize + 12) {
-					// Sample data is probably aligned to X bytes since the next sample doesn't always appear right after the first ends.
-					LOGW("Adjusting read offset of sample %i in set %i by %i bytes.", j, i, (totalSize - chunkSize - 12));
+		ConversionTasks tasks;
+		for (auto& set : sets) {
+			tasks.Enqueue([&set]() {
+				ReadSet(set);
+			});
+		}
+		tasks.WaitForCompletion([&progressCallback](float progress) {
+			if (progressCallback != nullptr) {
+				progressCallback(progress * ReadProgressWeight);
+			}
+		});
 
-					sampleDataBlock.DiscardBytes(totalSize - chunkSize - 12);
-				}
+		// Merge results in the original order, so the output is always the same
+		for (auto& set : sets) {
+			for (auto& anim : set.Anims) {
+				anims.push_back(std::move(anim));
+			}
+			for (auto& sample : set.Samples) {
+				samples.push_back(std::move(sample));
 			}
 		}
+		sets.clear();
 
 		// Detect version to import
 		if (headerLen == 464) {
@@ -282,12 +158,210 @@ namespace Jazz2::Compatibility
 			LOGE("Could not determine the version, header size: %u bytes", headerLen);
 		}
 
-		ImportAnimations(targetPath, version, anims);
-		ImportAudioSamples(targetPath, version, samples);
+		// Animations and samples are independent, so all of them are processed as one batch
+		// Mapping must stay alive until all tasks are completed
+		AnimSetMapping animMapping = AnimSetMapping::GetAnimMapping(version);
+		SmallVector<Pair<String, std::unique_ptr<Stream>>, 0> packedFiles;
+		ImportAnimations(tasks, animMapping, anims, packedFiles);
+		ImportAudioSamples(tasks, targetPath, version, samples);
+		tasks.WaitForCompletion([&progressCallback](float progress) {
+			if (progressCallback != nullptr) {
+				progressCallback(ReadProgressWeight + progress * (1.0f - ReadProgressWeight));
+			}
+		});
+
+		if (!packedFiles.empty()) {
+			// Store all sprites in one archive in deterministic order instead of thousands of loose files
+			PakWriter pakWriter(fs::CombinePath(targetPath, "Animations.pak"_s));
+			for (auto& file : packedFiles) {
+				auto* ms = static_cast<MemoryStream*>(file.second().get());
+				pakWriter.AddFile(file.first(), ms->GetBuffer(), ms->GetSize());
+			}
+			if (!pakWriter.Finalize()) {
+				LOGE("Cannot create animation archive in \"%s\"", String::nullTerminatedView(targetPath).data());
+			}
+		}
 		return true;
 	}
 
-	void JJ2Anims::ImportAnimations(const StringView& targetPath, JJ2Version version, SmallVectorImpl<AnimSection>& anims)
+	void JJ2Anims::ReadSet(SetSection& set)
+	{
+		// Each set has its own stream, so sets can be read in parallel
+		std::unique_ptr<Stream> s = std::make_unique<MemoryStream>(set.Data, set.DataLength);
+
+		JJ2Block infoBlock(s, set.BlockLengths[0], set.BlockLengths[1]);
+		JJ2Block frameDataBlock(s, set.BlockLengths[2], set.BlockLengths[3]);
+		JJ2Block imageDataBlock(s, set.BlockLengths[4], set.BlockLengths[5]);
+		JJ2Block sampleDataBlock(s, set.BlockLengths[6], set.BlockLengths[7]);
+
+		for (uint16_t j = 0; j < set.AnimCount; j++) {
+			AnimSection& anim = set.Anims.emplace_back();
+			anim.Set = set.Index;
+			anim.Anim = j;
+			anim.FrameCount = infoBlock.ReadUInt16();
+			anim.FrameRate = infoBlock.ReadUInt16();
+			anim.Frames.resize(anim.FrameCount);
+
+			// Skip the rest, seems to be 0x00000000 for all headers
+			infoBlock.DiscardBytes(4);
+
+			if (anim.FrameCount > 0) {
+				for (uint16_t k = 0; k < anim.FrameCount; k++) {
+					AnimFrameSection& frame = anim.Frames[k];
+
+					frame.SizeX = frameDataBlock.ReadInt16();
+					frame.SizeY = frameDataBlock.ReadInt16();
+					frame.ColdspotX = frameDataBlock.ReadInt16();
+					frame.ColdspotY = frameDataBlock.ReadInt16();
+					frame.HotspotX = frameDataBlock.ReadInt16();
+					frame.HotspotY = frameDataBlock.ReadInt16();
+					frame.GunspotX = frameDataBlock.ReadInt16();
+					frame.GunspotY = frameDataBlock.ReadInt16();
+
+					frame.ImageAddr = frameDataBlock.ReadInt32();
+					frame.MaskAddr = frameDataBlock.ReadInt32();
+
+					// Adjust normalized position
+					// In the output images, we want to make the hotspot and image size constant.
+					anim.NormalizedHotspotX = std::max((int16_t)-frame.HotspotX, anim.NormalizedHotspotX);
+					anim.NormalizedHotspotY = std::max((int16_t)-frame.HotspotY, anim.NormalizedHotspotY);
+
+					anim.LargestOffsetX = std::max((int16_t)(frame.SizeX + frame.HotspotX), anim.LargestOffsetX);
+					anim.LargestOffsetY = std::max((int16_t)(frame.SizeY + frame.HotspotY), anim.LargestOffsetY);
+
+					anim.AdjustedSizeX = std::max(
+						(int16_t)(anim.NormalizedHotspotX + anim.LargestOffsetX),
+						anim.AdjustedSizeX
+					);
+					anim.AdjustedSizeY = std::max(
+						(int16_t)(anim.NormalizedHotspotY + anim.LargestOffsetY),
+						anim.AdjustedSizeY
+					);
+
+					int32_t dpos = (frame.ImageAddr + 4);
+
+					imageDataBlock.SeekTo(dpos - 4);
+					uint16_t width2 = imageDataBlock.ReadUInt16();
+					imageDataBlock.SeekTo(dpos - 2);
+					/*uint16_t height2 =*/ imageDataBlock.ReadUInt16();
+
+					frame.DrawTransparent = (width2 & 0x8000) > 0;
+
+					int32_t pxRead = 0;
+					int32_t pxTotal = (frame.SizeX * frame.SizeY);
+					bool lastOpEmpty = true;
+
+					frame.ImageData = std::make_unique<uint8_t[]>(pxTotal);
+
+					imageDataBlock.SeekTo(dpos);
+
+					while (pxRead < pxTotal) {
+						uint8_t op = imageDataBlock.ReadByte();
+						if (op < 0x80) {
+							// Skip the given number of pixels, writing them with the transparent color 0, array should be already zeroed
+							pxRead += op;
+						} else if (op == 0x80) {
+							// Skip until the end of the line, array should be already zeroed
+							uint16_t linePxLeft = (uint16_t)(frame.SizeX - pxRead % frame.SizeX);
+							if (pxRead % frame.SizeX == 0 && !lastOpEmpty) {
+								linePxLeft = 0;
+							}
+
+							pxRead += linePxLeft;
+						} else {
+							// Copy specified amount of pixels (ignoring the high bit)
+							uint16_t bytesToRead = (uint16_t)(op & 0x7F);
+							imageDataBlock.ReadRawBytes(frame.ImageData.get() + pxRead, bytesToRead);
+							pxRead += bytesToRead;
+						}
+
+						lastOpEmpty = (op == 0x80);
+					}
+
+					// TODO: Sprite mask
+					/*frame.MaskData = std::make_unique<uint8_t[]>(pxTotal);
+
+					if (frame.MaskAddr != 0xFFFFFFFF) {
+						imageDataBlock.SeekTo(frame.MaskAddr);
+						pxRead = 0;
+						while (pxRead < pxTotal) {
+							uint8_t b = imageDataBlock.ReadByte();
+							for (uint8_t bit = 0; bit < 8 && (pxRead + bit) < pxTotal; ++bit) {
+								frame.MaskData[pxRead + bit] = ((b & (1 << (7 - bit))) != 0);
+							}
+							pxRead += 8;
+						}
+					}*/
+				}
+			}
+		}
+
+
+		for (uint16_t j = 0; j < set.SampleCount; j++) {
+			SampleSection& sample = set.Samples.emplace_back();
+			sample.IdInSet = j;
+			sample.Set = set.Index;
+
+			int32_t totalSize = sampleDataBlock.ReadInt32();
+			uint32_t magicRIFF = sampleDataBlock.ReadUInt32();
+			int32_t chunkSize = sampleDataBlock.ReadInt32();
+			// "ASFF" for 1.20, "AS  " for 1.24
+			uint32_t format = sampleDataBlock.ReadUInt32();
+			ASSERT(format == 0x46465341 || format == 0x20205341);
+			bool isASFF = (format == 0x46465341);
+
+			uint32_t magicSAMP = sampleDataBlock.ReadUInt32();
+			/*uint32_t sampSize =*/ sampleDataBlock.ReadUInt32();
+			ASSERT_MSG(magicRIFF == 0x46464952 && magicSAMP == 0x504D4153, "Sample has invalid header");
+
+			// Padding/unknown data #1
+			// For set 0 sample 0:
+			//       1.20                           1.24
+			//  +00  00 00 00 00 00 00 00 00   +00  40 00 00 00 00 00 00 00
+			//  +08  00 00 00 00 00 00 00 00   +08  00 00 00 00 00 00 00 00
+			//  +10  00 00 00 00 00 00 00 00   +10  00 00 00 00 00 00 00 00
+			//  +18  00 00 00 00               +18  00 00 00 00 00 00 00 00
+			//                                 +20  00 00 00 00 00 40 FF 7F
+			sampleDataBlock.DiscardBytes(40 - (isASFF ? 12 : 0));
+			if (isASFF) {
+				// All 1.20 samples seem to be 8-bit. Some of them are among those
+				// for which 1.24 reads as 24-bit but that might just be a mistake.
+				sampleDataBlock.DiscardBytes(2);
+				sample.Multiplier = 0;
+			} else {
+				// for 1.24. 1.20 has "20 40" instead in s0s0 which makes no sense
+				sample.Multiplier = sampleDataBlock.ReadUInt16();
+			}
+			// Unknown. s0s0 1.20: 00 80, 1.24: 80 00
+			sampleDataBlock.DiscardBytes(2);
+
+			/*uint32_t payloadSize =*/ sampleDataBlock.ReadUInt32();
+			// Padding #2, all zeroes in both
+			sampleDataBlock.DiscardBytes(8);
+
+			sample.SampleRate = sampleDataBlock.ReadUInt32();
+			sample.DataSize = chunkSize - 76 + (isASFF ? 12 : 0);
+
+			sample.Data = std::make_unique<uint8_t[]>(sample.DataSize);
+			sampleDataBlock.ReadRawBytes(sample.Data.get(), sample.DataSize);
+			// Padding #3
+			sampleDataBlock.DiscardBytes(4);
+
+			/*if (sample.Data.Length < actualDataSize) {
+				Log.Write(LogType.Warning, "Sample " + j + " in set " + i + " was shorter than expected! Expected "
+					+ actualDataSize + " bytes, but read " + sample.Data.Length + " instead.");
+			}*/
+
+			if (totalSize > chunkSize + 12) {
+				// Sample data is probably aligned to X bytes since the next sample doesn't always appear right after the first ends.
+				LOGW("Adjusting read offset of sample %i in set %i by %i bytes.", j, set.Index, (totalSize - chunkSize - 12));
+
+				sampleDataBlock.DiscardBytes(totalSize - chunkSize - 12);
+			}
+		}
+	}
+
+	void JJ2Anims::ImportAnimations(ConversionTasks& tasks, AnimSetMapping& animMapping, SmallVectorImpl<AnimSection>& anims, SmallVectorImpl<Pair<String, std::unique_ptr<Stream>>>& packedFiles)
 	{
 		if (anims.empty()) {
 			return;
@@ -295,7 +369,9 @@ namespace Jazz2::Compatibility
 
 		LOGI("Importing animations...");
 
-		AnimSetMapping animMapping = AnimSetMapping::GetAnimMapping(version);
+		// Sprite sheets are composed and encoded on worker threads, everything else stays on the calling thread
+		// Streams must not be relocated while the tasks are running
+		packedFiles.reserve(anims.size());
 
 		for (auto& anim : anims) {
 			if (anim.FrameCount == 0) {
@@ -349,73 +425,75 @@ namespace Jazz2::Compatibility
 				ASSERT(!entry->Name.empty());
 				continue;
 			} else {
-				fs::CreateDirectories(fs::CombinePath(targetPath, entry->Category));
-				filename = fs::CombinePath(entry->Category, entry->Name + ".aura"_s);
+				// Sprites are stored in the archive, so the path must be always separated by forward slash
+				filename = entry->Category + "/"_s + entry->Name + ".aura"_s;
 			}
 
-			int32_t stride = sizeX * anim.FrameConfigurationX;
-			std::unique_ptr<uint8_t[]> pixels = std::make_unique<uint8_t[]>(stride * sizeY * anim.FrameConfigurationY * 4);
+			auto& so = packedFiles.emplace_back(std::move(filename), std::make_unique<MemoryStream>(64 * 1024)).second();
+			tasks.Enqueue([&anim, entry, &so, sizeX, sizeY, applyToasterPowerUpFix, applyVineFix]() {
+				int32_t stride = sizeX * anim.FrameConfigurationX;
+				std::unique_ptr<uint8_t[]> pixels = std::make_unique<uint8_t[]>(stride * sizeY * anim.FrameConfigurationY * 4);
 
-			for (int32_t j = 0; j < anim.Frames.size(); j++) {
-				auto& frame = anim.Frames[j];
+				for (int32_t j = 0; j < anim.Frames.size(); j++) {
+					auto& frame = anim.Frames[j];
 
-				int32_t offsetX = anim.NormalizedHotspotX + frame.HotspotX;
-				int32_t offsetY = anim.NormalizedHotspotY + frame.HotspotY;
+					int32_t offsetX = anim.NormalizedHotspotX + frame.HotspotX;
+					int32_t offsetY = anim.NormalizedHotspotY + frame.HotspotY;
 
-				for (int32_t y = 0; y < frame.SizeY; y++) {
-					for (int32_t x = 0; x < frame.SizeX; x++) {
-						int32_t targetX = (j % anim.FrameConfigurationX) * sizeX + offsetX + x + AddBorder;
-						int32_t targetY = (j / anim.FrameConfigurationX) * sizeY + offsetY + y + AddBorder;
-						uint8_t colorIdx = frame.ImageData[frame.SizeX * y + x];
+					for (int32_t y = 0; y < frame.SizeY; y++) {
+						for (int32_t x = 0; x < frame.SizeX; x++) {
+							int32_t targetX = (j % anim.FrameConfigurationX) * sizeX + offsetX + x + AddBorder;
+							int32_t targetY = (j / anim.FrameConfigurationX) * sizeY + offsetY + y + AddBorder;
+							uint8_t colorIdx = frame.ImageData[frame.SizeX * y + x];
 
-						// Apply palette fixes
-						if (applyToasterPowerUpFix) {
-							if ((x >= 3 && y >= 4 && x <= 15 && y <= 20) || (x >= 2 && y >= 7 && x <= 15 && y <= 19)) {
-								colorIdx = ToasterPowerUpFix[colorIdx];
-							}
-						} else if (applyVineFix) {
-							if (colorIdx == 128) {
-								colorIdx = 0;
+							// Apply palette fixes
+							if (applyToasterPowerUpFix) {
+								if ((x >= 3 && y >= 4 && x <= 15 && y <= 20) || (x >= 2 && y >= 7 && x <= 15 && y <= 19)) {
+									colorIdx = ToasterPowerUpFix[colorIdx];
+								}
+							} else if (applyVineFix) {
+								if (colorIdx == 128) {
+									colorIdx = 0;
+								}
 							}
-						}
 
-						if (entry->Palette == JJ2DefaultPalette::Menu) {
-							const Color& src = MenuPalette[colorIdx];
-							uint8_t a;
-							if (colorIdx == 0) {
-								a = 0;
-							} else if (frame.DrawTransparent) {
-								a = 140 * src.A() / 255;
-							} else {
-								a = src.A();
-							}
+							if (entry->Palette == JJ2DefaultPalette::Menu) {
+								const Color& src = MenuPalette[colorIdx];
+								uint8_t a;
+								if (colorIdx == 0) {
+									a = 0;
+								} else if (frame.DrawTransparent) {
+									a = 140 * src.A() / 255;
+								} else {
+									a = src.A();
+								}
 
-							pixels[(stride * targetY + targetX) * 4] = src.R();
-							pixels[(stride * targetY + targetX) * 4 + 1] = src.G();
-							pixels[(stride * targetY + targetX) * 4 + 2] = src.B();
-							pixels[(stride * targetY + targetX) * 4 + 3] = a;
-						} else {
-							uint8_t a;
-							if (colorIdx == 0) {
-								a = 0;
-							} else if (frame.DrawTransparent) {
-								a = 140;
+								pixels[(stride * targetY + targetX) * 4] = src.R();
+								pixels[(stride * targetY + targetX) * 4 + 1] = src.G();
+								pixels[(stride * targetY + targetX) * 4 + 2] = src.B();
+								pixels[(stride * targetY + targetX) * 4 + 3] = a;
 							} else {
-								a = 255;
-							}
+								uint8_t a;
+								if (colorIdx == 0) {
+									a = 0;
+								} else if (frame.DrawTransparent) {
+									a = 140;
+								} else {
+									a = 255;
+								}
 
-							pixels[(stride * targetY + targetX) * 4] = colorIdx;
-							pixels[(stride * targetY + targetX) * 4 + 1] = colorIdx;
-							pixels[(stride * targetY + targetX) * 4 + 2] = colorIdx;
-							pixels[(stride * targetY + targetX) * 4 + 3] = a;
+								pixels[(stride * targetY + targetX) * 4] = colorIdx;
+								pixels[(stride * targetY + targetX) * 4 + 1] = colorIdx;
+								pixels[(stride * targetY + targetX) * 4 + 2] = colorIdx;
+								pixels[(stride * targetY + targetX) * 4 + 3] = a;
+							}
 						}
 					}
 				}
-			}
 
-			// TODO: Use single channel instead
-			String fullPath = fs::CombinePath(targetPath, filename);
-			WriteImageToFile(fullPath, pixels.get(), sizeX, sizeY, 4, &anim, entry);
+				// Index is kept in all channels for compatibility with existing cache files (QOI compresses it well), it's reduced to 2 channels on load
+				WriteImageToFile(so, pixels.get(), sizeX, sizeY, 4, &anim, entry);
+			});
 
 			/*if (!string.IsNullOrEmpty(data.Name) && !data.SkipNormalMap) {
 				PngWriter normalMap = NormalMapGenerator.FromSprite(img,
@@ -427,7 +505,7 @@ namespace Jazz2::Compatibility
 		}
 	}
 
-	void JJ2Anims::ImportAudioSamples(const StringView& targetPath, JJ2Version version, SmallVectorImpl<SampleSection>& samples)
+	void JJ2Anims::ImportAudioSamples(ConversionTasks& tasks, const StringView& targetPath, JJ2Version version, SmallVectorImpl<SampleSection>& samples)
 	{
 		if (samples.empty()) {
 			return;
@@ -452,57 +530,67 @@ namespace Jazz2::Compatibility
 				ASSERT(!entry->Name.empty());
 				continue;
 			} else {
+				// Directories are created on the calling thread, so multiple tasks don't try to create the same directory
 				fs::CreateDirectories(fs::CombinePath(targetPath, entry->Category));
 
-				filename = fs::CombinePath(entry->Category, entry->Name + ".wav"_s);
-			}
-
-			auto so = fs::Open(fs::CombinePath(targetPath, filename), FileAccessMode::Write);
-			ASSERT_MSG(so->IsValid(), "Cannot open file for writing");
-
-			// TODO: The modulo here essentially clips the sample to 8- or 16-bit.
-			// There are some samples (at least the Rapier random noise) that at least get reported as 24-bit
-			// by the read header data. It is not clear if they actually are or if the header data is just
-			// read incorrectly, though - one would think the data would need to be reshaped between 24 and 8
-			// but it works just fine as is.
-			int bytesPerSample = (sample.Multiplier / 4) % 2 + 1;
-			int dataOffset = 0;
-			if (sample.Data[0] == 0x00 && sample.Data[1] == 0x00 && sample.Data[2] == 0x00 && sample.Data[3] == 0x00 &&
-				(sample.Data[4] != 0x00 || sample.Data[5] != 0x00 || sample.Data[6] != 0x00 || sample.Data[7] != 0x00) &&
-				(sample.Data[7] == 0x00 || sample.Data[8] == 0x00)) {
-				// Trim first 8 samples (bytes) to prevent popping
-				dataOffset = 8;
-			}
-
-			// Create PCM wave file
-			// Main header
-			so->Write("RIFF", 4);
-			so->WriteValue<uint32_t>(36 + sample.DataSize - dataOffset); // File size
-			so->Write("WAVE", 4);
-
-			// Format header
-			so->Write("fmt ", 4);
-			so->WriteValue<uint32_t>(16); // Header remainder length
-			so->WriteValue<uint16_t>(1); // Format = PCM
-			so->WriteValue<uint16_t>(1); // Channels
-			so->WriteValue<uint32_t>(sample.SampleRate); // Sample rate
-			so->WriteValue<uint32_t>(sample.SampleRate * bytesPerSample); // Bytes per second
-			so->WriteValue<uint32_t>(bytesPerSample * 0x00080001);
-
-			// Payload
-			so->Write("data", 4);
-			so->WriteValue<uint32_t>(sample.DataSize - dataOffset); // Payload size
-			for (uint32_t k = dataOffset; k < sample.DataSize; k++) {
-				so->WriteValue<uint8_t>((bytesPerSample << 7) ^ sample.Data[k]);
+				filename = fs::CombinePath({ targetPath, entry->Category, entry->Name + ".wav"_s });
 			}
+
+			tasks.Enqueue([&sample, filename = std::move(filename)]() {
+				WriteAudioSample(filename, sample);
+			});
 		}
 	}
 
-	void JJ2Anims::WriteImageToFile(const StringView& targetPath, const uint8_t* data, int32_t width, int32_t height, int32_t channelCount, AnimSection* anim, AnimSetMapping::Entry* entry)
+	void JJ2Anims::WriteAudioSample(const String& filename, const SampleSection& sample)
 	{
-		auto so = fs::Open(targetPath, FileAccessMode::Write);
+		auto so = fs::Open(filename, FileAccessMode::Write);
 		ASSERT_MSG(so->IsValid(), "Cannot open file for writing");
 
+		// TODO: The modulo here essentially clips the sample to 8- or 16-bit.
+		// There are some samples (at least the Rapier random noise) that at least get reported as 24-bit
+		// by the read header data. It is not clear if they actually are or if the header data is just
+		// read incorrectly, though - one would think the data would need to be reshaped between 24 and 8
+		// but it works just fine as is.
+		int bytesPerSample = (sample.Multiplier / 4) % 2 + 1;
+		int dataOffset = 0;
+		if (sample.Data[0] == 0x00 && sample.Data[1] == 0x00 && sample.Data[2] == 0x00 && sample.Data[3] == 0x00 &&
+			(sample.Data[4] != 0x00 || sample.Data[5] != 0x00 || sample.Data[6] != 0x00 || sample.Data[7] != 0x00) &&
+			(sample.Data[7] == 0x00 || sample.Data[8] == 0x00)) {
+			// Trim first 8 samples (bytes) to prevent popping
+			dataOffset = 8;
+		}
+
+		// Create PCM wave file
+		// Main header
+		so->Write("RIFF", 4);
+		so->WriteValue<uint32_t>(36 + sample.DataSize - dataOffset); // File size
+		so->Write("WAVE", 4);
+
+		// Format header
+		so->Write("fmt ", 4);
+		so->WriteValue<uint32_t>(16); // Header remainder length
+		so->WriteValue<uint16_t>(1); // Format = PCM
+		so->WriteValue<uint16_t>(1); // Channels
+		so->WriteValue<uint32_t>(sample.SampleRate); // Sample rate
+		so->WriteValue<uint32_t>(sample.SampleRate * bytesPerSample); // Bytes per second
+		so->WriteValue<uint32_t>(bytesPerSample * 0x00080001);
+
+		// Payload
+		so->Write("data", 4);
+		so->WriteValue<uint32_t>(sample.DataSize - dataOffset); // Payload size
+
+		// Convert the payload first, so it can be written at once
+		uint32_t payloadSize = sample.DataSize - dataOffset;
+		std::unique_ptr<uint8_t[]> payload = std::make_unique<uint8_t[]>(payloadSize);
+		for (uint32_t k = 0; k < payloadSize; k++) {
+			payload[k] = (uint8_t)((bytesPerSample << 7) ^ sample.Data[dataOffset + k]);
+		}
+		so->Write(payload.get(), (int32_t)payloadSize);
+	}
+
+	void JJ2Anims::WriteImageToFile(std::unique_ptr<Stream>& so, const uint8_t* data, int32_t width, int32_t height, int32_t channelCount, AnimSection* anim, AnimSetMapping::Entry* entry)
+	{
 		uint8_t flags = 0x00;
 		if (entry != nullptr) {
 			flags |= 0x80;
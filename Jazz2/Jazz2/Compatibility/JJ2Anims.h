@@ -4,8 +4,10 @@
 #include "JJ2Version.h"
 #include "AnimSetMapping.h"
 
+#include <functional>
 #include <memory>
 
+#include <Containers/Pair.h>
 #include <Containers/SmallVector.h>
 #include <Containers/StringView.h>
 #include <IO/Stream.h>
@@ -16,17 +18,22 @@ using namespace nCine;
 
 namespace Jazz2::Compatibility
 {
+	class ConversionTasks;
+
 	class JJ2Anims // .j2a
 	{
 	public:
-		static constexpr uint16_t CacheVersion = 8;
+		static constexpr uint16_t CacheVersion = 9;
 
-		static bool Convert(const StringView& path, const StringView& targetPath, bool isPlus);
+		/** @brief Converts animations and samples, progress in range 0.0-1.0 is reported on the calling thread */
+		static bool Convert(const StringView& path, const StringView& targetPath, bool isPlus, const std::function<void(float)>& progressCallback = nullptr);
 
 		static void WriteImageToFileInternal(std::unique_ptr<Stream>& so, const uint8_t* data, int32_t width, int32_t height, int32_t channelCount);
 
 	private:
 		static constexpr int32_t AddBorder = 1;
+		// Reading of sets takes only small part of the conversion, the rest is importing of animations and samples
+		static constexpr float ReadProgressWeight = 0.2f;
 
 		struct AnimFrameSection {
 			int16_t SizeX, SizeY;
@@ -64,11 +71,28 @@ namespace Jazz2::Compatibility
 			uint16_t Multiplier;
 		};
 
+		struct SetSection {
+			int32_t Index;
+			uint8_t AnimCount;
+			uint8_t SampleCount;
+			// Compressed and uncompressed lengths of info, frame data, image data and sample data blocks
+			int32_t BlockLengths[8];
+			int32_t DataLength;
+			// Points to the mapped file or to owned data
+			const uint8_t* Data;
+			std::unique_ptr<uint8_t[]> OwnedData;
+
+			SmallVector<AnimSection, 0> Anims;
+			SmallVector<SampleSection, 0> Samples;
+		};
+
 		JJ2Anims();
 
-		static void ImportAnimations(const StringView& targetPath, JJ2Version version, SmallVectorImpl<AnimSection>& anims);
-		static void ImportAudioSamples(const StringView& targetPath, JJ2Version version, SmallVectorImpl<SampleSection>& samples);
+		static void ReadSet(SetSection& set);
+		static void ImportAnimations(ConversionTasks& tasks, AnimSetMapping& animMapping, SmallVectorImpl<AnimSection>& anims, SmallVectorImpl<Pair<String, std::unique_ptr<Stream>>>& packedFiles);
+		static void ImportAudioSamples(ConversionTasks& tasks, const StringView& targetPath, JJ2Version version, SmallVectorImpl<SampleSection>& samples);
+		static void WriteAudioSample(const String& filename, const SampleSection& sample);
 
-		static void WriteImageToFile(const StringView& targetPath, const uint8_t* data, int32_t width, int32_t height, int32_t channelCount, AnimSection* anim, AnimSetMapping::Entry* entry);
+		static void WriteImageToFile(std::unique_ptr<Stream>& so, const uint8_t* data, int32_t width, int32_t height, int32_t channelCount, AnimSection* anim, AnimSetMapping::Entry* entry);
 	};
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 ﻿#include "JJ2Block.h"
 
 #include "IO/CompressionUtils.h"
+#include "IO/MappedStream.h"
+#include "IO/MemoryStream.h"
 
 #include <cstring>
 
@@ -11,15 +13,36 @@ namespace Jazz2::Compatibility
 	JJ2Block::JJ2Block(const std::unique_ptr<Stream>& s, int32_t length, int32_t uncompressedLength)
 		: _length(0), _offset(0)
 	{
-		std::unique_ptr<uint8_t[]> tmpBuffer = std::make_unique<uint8_t[]>(length);
-		s->Read(tmpBuffer.get(), length);
+		// Streams which are already in memory can be decompressed directly without copying the compressed data first
+		const uint8_t* buffer = nullptr;
+		if (s->GetType() == Stream::Type::Mapped) {
+			buffer = static_cast<MappedStream*>(s.get())->GetBuffer();
+		} else if (s->GetType() == Stream::Type::Memory) {
+			buffer = static_cast<MemoryStream*>(s.get())->GetBuffer();
+		}
+
+		const uint8_t* data;
+		std::unique_ptr<uint8_t[]> tmpBuffer;
+		if (buffer != nullptr && s->GetPosition() + length <= s->GetSize()) {
+			data = buffer + s->GetPosition();
+			s->Seek(length, SeekOrigin::Current);
+		} else {
+			tmpBuffer = std::make_unique<uint8_t[]>(length);
+			s->Read(tmpBuffer.get(), length);
+			data = tmpBuffer.get();
+		}
 
 		if (uncompressedLength > 0) {
-			_length -= 2;
+			// Skip zlib header
+			int32_t compressedLength = length - 2;
 			_buffer = std::make_unique<uint8_t[]>(uncompressedLength);
-			auto result = CompressionUtils::Inflate(tmpBuffer.get() + 2, length, _buffer.get(), uncompressedLength);
+			auto result = CompressionUtils::Inflate(data + 2, compressedLength, _buffer.get(), uncompressedLength);
 			_length = (result == DecompressionResult::Success ? uncompressedLength : 0);
 		} else {
+			if (tmpBuffer == nullptr) {
+				tmpBuffer = std::make_unique<uint8_t[]>(length);
+				std::memcpy(tmpBuffer.get(), data, length);
+			}
 			_buffer = std::move(tmpBuffer);
 			_length = length;
 		}
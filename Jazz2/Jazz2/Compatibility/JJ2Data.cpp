@@ -13,7 +13,7 @@ namespace Jazz2::Compatibility
 {
 	bool JJ2Data::Open(const StringView& path, bool strictParser)
 	{
-		auto s = fs::Open(path, FileAccessMode::Read);
+		auto s = fs::Open(path, FileAccessMode::Read | FileAccessMode::MemoryMapped);
 		RETURNF_ASSERT_MSG(s->IsValid(), "Cannot open file for reading");
 
 		uint32_t magic = s->ReadValue<uint32_t>();
@@ -41,7 +41,7 @@ namespace Jazz2::Compatibility
 {
 	bool JJ2Strings::Open(const StringView& path)
 	{
-		auto s = fs::Open(path, FileAccessMode::Read);
+		auto s = fs::Open(path, FileAccessMode::Read | FileAccessMode::MemoryMapped);
 		RETURNF_ASSERT_MSG(s->IsValid(), "Cannot open file for reading");
 
 		Name = fs::GetFileNameWithoutExtension(path);
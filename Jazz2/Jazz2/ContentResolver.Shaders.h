@@ -657,6 +657,22 @@ void main() {
 	fragColor = mix(texColor, horizonColorWithStars, horizonOpacity);
 	fragColor.a = 1.0;
 }
+)";
+
+	constexpr char TileLayerFs[] = "#line " DEATH_LINE_STRING "\n" R"(
+#ifdef GL_ES
+precision mediump float;
+#endif
+
+uniform sampler2D uTexture;
+
+in vec2 vTexCoords;
+in vec4 vColor;
+out vec4 fragColor;
+
+void main() {
+	fragColor = texture(uTexture, vTexCoords) * vColor;
+}
 )";
 
 	constexpr char ColorizedFs[] = "#line " DEATH_LINE_STRING "\n" R"(
@@ -806,6 +822,173 @@ void main() {
 	float grey = min((0.299 * color.r + 0.587 * color.g + 0.114 * color.b) * 2.6f, 1.0f);
 	fragColor = mix(tex, vec4(0.2 * grey, 0.2 + grey * 0.62, 0.6 + 0.2 * grey, outline * 0.95), vColor.a);
 }
+)";
+
+	constexpr char IndexedFs[] = "#line " DEATH_LINE_STRING "\n" R"(
+#ifdef GL_ES
+precision mediump float;
+#endif
+
+uniform sampler2D uTexture;
+uniform sampler2D uPalette;
+
+in vec2 vTexCoords;
+in vec4 vColor;
+out vec4 fragColor;
+
+// Texture contains low byte of palette index in red channel, palette row in upper 2 bits and alpha in lower 6 bits of green channel
+vec4 texturePalette(vec2 uv) {
+	ivec2 index = ivec2(texture(uTexture, uv).rg * 255.0 + vec2(0.5));
+	vec4 color = texelFetch(uPalette, ivec2(index.x, index.y >> 6), 0);
+	return vec4(color.rgb, color.a * float(index.y & 63) / 63.0);
+}
+
+void main() {
+	fragColor = texturePalette(vTexCoords) * vColor;
+}
+)";
+
+	constexpr char IndexedOutlineFs[] = "#line " DEATH_LINE_STRING "\n" R"(
+#ifdef GL_ES
+precision mediump float;
+#endif
+
+uniform sampler2D uTexture;
+uniform sampler2D uPalette;
+
+in vec2 vTexCoords;
+in vec4 vColor;
+out vec4 fragColor;
+
+// Texture contains low byte of palette index in red channel, palette row in upper 2 bits and alpha in lower 6 bits of green channel
+vec4 texturePalette(vec2 uv) {
+	ivec2 index = ivec2(texture(uTexture, uv).rg * 255.0 + vec2(0.5));
+	vec4 color = texelFetch(uPalette, ivec2(index.x, index.y >> 6), 0);
+	return vec4(color.rgb, color.a * float(index.y & 63) / 63.0);
+}
+
+float aastep(float threshold, float value) {
+	float afwidth = length(vec2(dFdx(value), dFdy(value))) * 0.70710678118654757;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value); 
+}
+
+void main() {
+	vec2 size = vColor.xy;
+
+	float outline = texturePalette(vTexCoords + vec2(-size.x, 0)).a;
+	outline += texturePalette(vTexCoords + vec2(0, size.y)).a;
+	outline += texturePalette(vTexCoords + vec2(size.x, 0)).a;
+	outline += texturePalette(vTexCoords + vec2(0, -size.y)).a;
+	outline += texturePalette(vTexCoords + vec2(-size.x, size.y)).a;
+	outline += texturePalette(vTexCoords + vec2(size.x, size.y)).a;
+	outline += texturePalette(vTexCoords + vec2(-size.x, -size.y)).a;
+	outline += texturePalette(vTexCoords + vec2(size.x, -size.y)).a;
+	outline = aastep(1.0, outline);
+
+	vec4 color = texturePalette(vTexCoords);
+	fragColor = mix(color, vec4(vColor.z, vColor.z, vColor.z, vColor.w), outline - color.a);
+}
+)";
+
+	constexpr char IndexedWhiteMaskFs[] = "#line " DEATH_LINE_STRING "\n" R"(
+#ifdef GL_ES
+precision mediump float;
+#endif
+
+uniform sampler2D uTexture;
+uniform sampler2D uPalette;
+
+in vec2 vTexCoords;
+in vec4 vColor;
+out vec4 fragColor;
+
+// Texture contains low byte of palette index in red channel, palette row in upper 2 bits and alpha in lower 6 bits of green channel
+vec4 texturePalette(vec2 uv) {
+	ivec2 index = ivec2(texture(uTexture, uv).rg * 255.0 + vec2(0.5));
+	vec4 color = texelFetch(uPalette, ivec2(index.x, index.y >> 6), 0);
+	return vec4(color.rgb, color.a * float(index.y & 63) / 63.0);
+}
+
+void main() {
+	vec4 tex = texturePalette(vTexCoords);
+	float color = min((0.299 * tex.r + 0.587 * tex.g + 0.114 * tex.b) * 6.0f, 1.0f);
+	fragColor = vec4(color, color, color, tex.a) * vColor;
+}
+)";
+
+	constexpr char IndexedPartialWhiteMaskFs[] = "#line " DEATH_LINE_STRING "\n" R"(
+#ifdef GL_ES
+precision mediump float;
+#endif
+
+uniform sampler2D uTexture;
+uniform sampler2D uPalette;
+
+in vec2 vTexCoords;
+in vec4 vColor;
+out vec4 fragColor;
+
+// Texture contains low byte of palette index in red channel, palette row in upper 2 bits and alpha in lower 6 bits of green channel
+vec4 texturePalette(vec2 uv) {
+	ivec2 index = ivec2(texture(uTexture, uv).rg * 255.0 + vec2(0.5));
+	vec4 color = texelFetch(uPalette, ivec2(index.x, index.y >> 6), 0);
+	return vec4(color.rgb, color.a * float(index.y & 63) / 63.0);
+}
+
+void main() {
+	vec4 tex = texturePalette(vTexCoords);
+	float color = min((0.299 * tex.r + 0.587 * tex.g + 0.114 * tex.b) * 2.5f, 1.0f);
+	fragColor = vec4(color, color, color, tex.a) * vColor;
+}
+)";
+
+	constexpr char IndexedFrozenMaskFs[] = "#line " DEATH_LINE_STRING "\n" R"(
+#ifdef GL_ES
+precision mediump float;
+#endif
+
+uniform sampler2D uTexture;
+uniform sampler2D uPalette;
+
+in vec2 vTexCoords;
+in vec4 vColor;
+out vec4 fragColor;
+
+// Texture contains low byte of palette index in red channel, palette row in upper 2 bits and alpha in lower 6 bits of green channel
+vec4 texturePalette(vec2 uv) {
+	ivec2 index = ivec2(texture(uTexture, uv).rg * 255.0 + vec2(0.5));
+	vec4 color = texelFetch(uPalette, ivec2(index.x, index.y >> 6), 0);
+	return vec4(color.rgb, color.a * float(index.y & 63) / 63.0);
+}
+
+float aastep(float threshold, float value) {
+	float afwidth = length(vec2(dFdx(value), dFdy(value))) * 0.70710678118654757;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value); 
+}
+
+void main() {
+	vec2 size = vColor.xy * vColor.a * 2.0;
+
+	vec4 tex = texturePalette(vTexCoords);
+	vec4 tex1 = texturePalette(vTexCoords + vec2(-size.x, 0));
+	vec4 tex2 = texturePalette(vTexCoords + vec2(0, size.y));
+	vec4 tex3 = texturePalette(vTexCoords + vec2(size.x, 0));
+	vec4 tex4 = texturePalette(vTexCoords + vec2(0, -size.y));
+
+	float outline = tex1.a;
+	outline += tex2.a;
+	outline += tex3.a;
+	outline += tex4.a;
+	outline += texturePalette(vTexCoords + vec2(-size.x, size.y)).a;
+	outline += texturePalette(vTexCoords + vec2(size.x, size.y)).a;
+	outline += texturePalette(vTexCoords + vec2(-size.x, -size.y)).a;
+	outline += texturePalette(vTexCoords + vec2(size.x, -size.y)).a;
+	outline = aastep(1.0, outline);
+
+	vec4 color = (tex + tex + tex1 + tex2 + tex3 + tex4) / 6.0;
+	float grey = min((0.299 * color.r + 0.587 * color.g + 0.114 * color.b) * 2.6f, 1.0f);
+	fragColor = mix(tex, vec4(0.2 * grey, 0.2 + grey * 0.62, 0.6 + 0.2 * grey, outline * 0.95), vColor.a);
+}
 )";
 
 	constexpr char ShieldVs[] = "#line " DEATH_LINE_STRING "\n" R"(
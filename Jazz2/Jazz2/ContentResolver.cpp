@@ -10,10 +10,15 @@
 #include "Application.h"
 #include "AppConfiguration.h"
 #include "ServiceLocator.h"
-#include "IO/CompressionUtils.h"
+#include "IO/DeflateStream.h"
 #include "Graphics/ITextureLoader.h"
 #include "Graphics/RenderResources.h"
+#include "Audio/IAudioLoader.h"
 #include "Base/Random.h"
+#include "Base/TimeStamp.h"
+#if defined(WITH_THREADS)
+#	include "Threading/IThreadCommand.h"
+#endif
 
 #if defined(DEATH_TARGET_ANDROID)
 #	include "../nCine/Backends/Android/AndroidApplication.h"
@@ -23,6 +28,7 @@
 #endif
 
 #include <Containers/StringStlView.h>
+#include <IO/MappedStream.h>
 #include <IO/MemoryStream.h>
 
 #define SIMDJSON_EXCEPTIONS 0
@@ -49,15 +55,87 @@ static Vector2i GetVector2iFromJson(simdjson_result<T> value, Vector2i defaultVa
 
 namespace Jazz2
 {
+	void Metadata::BuildStateIndex()
+	{
+		StateIndex.clear();
+		for (auto& [identifier, resource] : Graphics) {
+			for (AnimState state : resource.State) {
+				auto& entry = StateIndex.emplace_back();
+				entry.State = state;
+				entry.Identifier = &identifier;
+				entry.Resource = &resource;
+			}
+		}
+
+		// Insertion sort is stable and there are usually only tens of entries
+		for (int32_t i = 1; i < (int32_t)StateIndex.size(); i++) {
+			StateIndexEntry entry = StateIndex[i];
+			int32_t j = i - 1;
+			while (j >= 0 && (uint32_t)StateIndex[j].State > (uint32_t)entry.State) {
+				StateIndex[j + 1] = StateIndex[j];
+				j--;
+			}
+			StateIndex[j + 1] = entry;
+		}
+	}
+
+	ArrayView<const Metadata::StateIndexEntry> Metadata::FindByState(AnimState state) const
+	{
+		int32_t first = 0, count = (int32_t)StateIndex.size();
+		while (count > 0) {
+			int32_t step = count / 2;
+			if ((uint32_t)StateIndex[first + step].State < (uint32_t)state) {
+				first += step + 1;
+				count -= step + 1;
+			} else {
+				count = step;
+			}
+		}
+
+		int32_t last = first;
+		while (last < (int32_t)StateIndex.size() && StateIndex[last].State == state) {
+			last++;
+		}
+
+		return arrayView(StateIndex.data() + first, last - first);
+	}
+
 	ContentResolver& ContentResolver::Get()
 	{
 		static ContentResolver current;
 		return current;
 	}
 
+#if defined(WITH_THREADS)
+	class ContentResolver::PreloadCommand : public IThreadCommand
+	{
+	public:
+		PreloadCommand(ContentResolver* owner, PendingMetadata* pending)
+			: _owner(owner), _pending(pending) { }
+
+		void Execute() override
+		{
+			_owner->PreloadMetadata(*_pending);
+
+			_owner->_preloadMutex.Lock();
+			_pending->IsCompleted = true;
+			_owner->_preloadPendingCount--;
+			_owner->_preloadCV.Broadcast();
+			_owner->_preloadMutex.Unlock();
+		}
+
+	private:
+		ContentResolver* _owner;
+		PendingMetadata* _pending;
+	};
+#endif
+
 	ContentResolver::ContentResolver()
-		: _isLoading(false), _cachedMetadata(64), _cachedGraphics(128), _palettes{}
+		: _isLoading(false), _cachedMetadata(64), _cachedGraphics(128), _cachedSounds(128), _soundBytesSaved(0), _soundBuffersSaved(0), _palettes{}
 	{
+#if defined(WITH_THREADS)
+		_preloadPendingCount = 0;
+#endif
 		InitializePaths();
 	}
 
@@ -67,8 +145,12 @@ namespace Jazz2
 
 	void ContentResolver::Release()
 	{
+		CancelPreloading();
+
 		_cachedMetadata.clear();
 		_cachedGraphics.clear();
+		_cachedSounds.clear();
+		_spriteAtlas.Clear();
 
 		for (int32_t i = 0; i < (int32_t)FontType::Count; i++) {
 			_fonts[i] = nullptr;
@@ -77,6 +159,15 @@ namespace Jazz2
 		for (int32_t i = 0; i < (int32_t)PrecompiledShader::Count; i++) {
 			_precompiledShaders[i] = nullptr;
 		}
+
+		_paletteTexture = nullptr;
+
+		_animationsPak = nullptr;
+	}
+
+	void ContentResolver::MountPakFiles()
+	{
+		_animationsPak = std::make_unique<PakFile>(fs::CombinePath({ GetCachePath(), "Animations"_s, "Animations.pak"_s }));
 	}
 
 	void ContentResolver::InitializePaths()
@@ -217,6 +308,13 @@ namespace Jazz2
 	{
 		_isLoading = true;
 
+		// Archive could be created by the cache refresh in the meantime, so try it again
+		if (_animationsPak == nullptr || !_animationsPak->IsValid()) {
+			// Workers could still be reading from the previous one
+			WaitForPreloading();
+			MountPakFiles();
+		}
+
 		// Reset Referenced flag
 		for (auto& resource : _cachedMetadata) {
 			resource.second->Flags &= ~MetadataFlags::Referenced;
@@ -224,6 +322,13 @@ namespace Jazz2
 		for (auto& resource : _cachedGraphics) {
 			resource.second->Flags &= ~GenericGraphicResourceFlags::Referenced;
 		}
+		for (auto& resource : _cachedSounds) {
+			resource.second->Flags &= ~GenericSoundResourceFlags::Referenced;
+		}
+
+		// Resources requested from now on are usually visible together, so keep them in separate pages
+		_spriteAtlas.FinishPages();
+		RepackSpriteAtlas();
 	}
 
 	void ContentResolver::EndLoading()
@@ -250,6 +355,38 @@ namespace Jazz2
 					++it;
 				}
 			}
+
+			_spriteAtlas.ReleaseUnusedPages();
+		}
+
+		// Released unreferenced sounds
+		{
+#if defined(WITH_THREADS)
+			// Workers check the sound cache before decoding
+			_preloadMutex.Lock();
+#endif
+			auto it = _cachedSounds.begin();
+			while (it != _cachedSounds.end()) {
+				if ((it->second->Flags & GenericSoundResourceFlags::Referenced) != GenericSoundResourceFlags::Referenced) {
+					it = _cachedSounds.erase(it);
+				} else {
+					++it;
+				}
+			}
+#if defined(WITH_THREADS)
+			_preloadMutex.Unlock();
+#endif
+		}
+
+		LOGI("Sound cache contains %u buffers, %u buffers (%llu KB) were shared instead of loaded again", (uint32_t)_cachedSounds.size(),
+			_soundBuffersSaved, (unsigned long long)(_soundBytesSaved / 1024));
+
+#if defined(WITH_THREADS)
+		// Otherwise, the atlas is complete after all preloaded resources are finalized
+		if (_preloadingMetadata.empty())
+#endif
+		{
+			LogSpriteAtlasStatistics();
 		}
 
 		_isLoading = false;
@@ -257,8 +394,95 @@ namespace Jazz2
 
 	void ContentResolver::PreloadMetadataAsync(const StringView& path)
 	{
-		// TODO: reimplement async preloading
+#if defined(WITH_THREADS)
+		auto pathNormalized = fs::ToNativeSeparators(path);
+		if (_preloadingMetadata.contains(String::nullTerminatedView(pathNormalized))) {
+			return;
+		}
+
+		// Already loaded metadata only need to be marked as referenced, and without worker threads it's loaded synchronously
+		if (!theServiceLocator().hasThreadPool() || _cachedMetadata.contains(String::nullTerminatedView(pathNormalized))) {
+			RequestMetadata(pathNormalized);
+			return;
+		}
+
+		// First resources are requested, reset _isLoading flag, because palette should be already applied
+		_isLoading = false;
+
+		// The archive can't be mounted from worker threads
+		if (_animationsPak == nullptr) {
+			MountPakFiles();
+		}
+
+		std::unique_ptr<PendingMetadata> pending = std::make_unique<PendingMetadata>();
+		pending->Path = pathNormalized;
+
+		_preloadMutex.Lock();
+		_preloadPendingCount++;
+		_preloadMutex.Unlock();
+
+		theServiceLocator().threadPool().EnqueueCommand(std::make_unique<PreloadCommand>(this, pending.get()));
+		_preloadingMetadata.emplace(std::move(pathNormalized), std::move(pending));
+#else
 		RequestMetadata(path);
+#endif
+	}
+
+	bool ContentResolver::FinalizePreloadedResources(float timeBudget)
+	{
+#if defined(WITH_THREADS)
+		if (_preloadingMetadata.empty()) {
+			return true;
+		}
+
+		TimeStamp startTime = TimeStamp::now();
+		auto it = _preloadingMetadata.begin();
+		while (it != _preloadingMetadata.end()) {
+			_preloadMutex.Lock();
+			bool isCompleted = it->second->IsCompleted;
+			_preloadMutex.Unlock();
+
+			if (!isCompleted) {
+				++it;
+				continue;
+			}
+
+			FinalizeMetadata(*it->second);
+			it = _preloadingMetadata.erase(it);
+
+			// Textures and audio buffers can be created only on the main thread, so spread it over multiple frames
+			if (startTime.millisecondsSince() >= timeBudget) {
+				break;
+			}
+		}
+
+		if (!_preloadingMetadata.empty()) {
+			return false;
+		}
+
+		LogSpriteAtlasStatistics();
+		return true;
+#else
+		return true;
+#endif
+	}
+
+	void ContentResolver::FinalizePreloadedResources()
+	{
+#if defined(WITH_THREADS)
+		WaitForPreloading();
+
+		if (_preloadingMetadata.empty()) {
+			return;
+		}
+
+		for (auto& pending : _preloadingMetadata) {
+			FinalizeMetadata(*pending.second);
+		}
+		_preloadingMetadata.clear();
+
+		LogSpriteAtlasStatistics();
+#endif
 	}
 
 	Metadata* ContentResolver::RequestMetadata(const StringView& path)
@@ -272,35 +496,64 @@ namespace Jazz2
 			for (auto& resource : it->second->Graphics) {
 				resource.second.Base->Flags |= GenericGraphicResourceFlags::Referenced;
 			}
+			for (auto& resource : it->second->Sounds) {
+				for (auto* buffer : resource.second.Buffers) {
+					buffer->Flags |= GenericSoundResourceFlags::Referenced;
+				}
+			}
 
 			return it->second.get();
 		}
 
+#if defined(WITH_THREADS)
+		auto pendingIt = _preloadingMetadata.find(String::nullTerminatedView(pathNormalized));
+		if (pendingIt != _preloadingMetadata.end()) {
+			// Metadata is still being preloaded, wait for the worker and finalize it right away
+			std::unique_ptr<PendingMetadata> pending = std::move(pendingIt->second);
+			_preloadingMetadata.erase(pendingIt);
+
+			_preloadMutex.Lock();
+			while (!pending->IsCompleted) {
+				_preloadCV.Wait(_preloadMutex);
+			}
+			_preloadMutex.Unlock();
+
+			return FinalizeMetadata(*pending);
+		}
+#endif
+
 		// Try to load it
-		auto s = fs::Open(fs::CombinePath({ GetContentPath(), "Metadata"_s, pathNormalized + ".res"_s }), FileAccessMode::Read);
+		PendingMetadata pending;
+		pending.Path = pathNormalized;
+		ParseMetadata(pending);
+		return FinalizeMetadata(pending);
+	}
+
+	bool ContentResolver::ParseMetadata(PendingMetadata& pending)
+	{
+		auto s = fs::Open(fs::CombinePath({ GetContentPath(), "Metadata"_s, pending.Path + ".res"_s }), FileAccessMode::Read | FileAccessMode::MemoryMapped);
 		auto fileSize = s->GetSize();
 		if (fileSize < 4 || fileSize > 64 * 1024 * 1024) {
 			// 64 MB file size limit
-			return nullptr;
+			return false;
 		}
 
 		auto buffer = std::make_unique<char[]>(fileSize + simdjson::SIMDJSON_PADDING);
 		s->Read(buffer.get(), fileSize);
 		buffer[fileSize] = '\0';
 
-		std::unique_ptr<Metadata> metadata = std::make_unique<Metadata>();
-		metadata->Flags |= MetadataFlags::Referenced;
+		pending.IsValid = true;
 
 		ondemand::parser parser;
 		ondemand::document doc;
 		if (parser.iterate(buffer.get(), fileSize, fileSize + simdjson::SIMDJSON_PADDING).get(doc) == SUCCESS) {
-			metadata->BoundingBox = GetVector2iFromJson(doc["BoundingBox"], Vector2i(InvalidValue, InvalidValue));
+			pending.BoundingBox = GetVector2iFromJson(doc["BoundingBox"], Vector2i(InvalidValue, InvalidValue));
 
 			ondemand::object animations;
 			if (doc["Animations"].get(animations) == SUCCESS) {
 				size_t count;
 				if (animations.count_fields().get(count) == SUCCESS) {
-					metadata->Graphics.reserve(count);
+					pending.Graphics.reserve(count);
 				}
 
 				for (auto it : animations) {
@@ -311,10 +564,15 @@ namespace Jazz2
 						continue;
 					}
 
-					GraphicResource graphics;
+					PendingGraphicResource& item = pending.Graphics.emplace_back();
+					item.Name = key;
+					item.Path = fs::ToNativeSeparators(assetPath);
+
+					GraphicResource& graphics = item.Resource;
 					graphics.LoopMode = AnimationLoopMode::Loop;
 
 					//bool keepIndexed = false;
+					item.Standalone = false;
 
 					uint64_t flags;
 					if (value["Flags"].get(flags) == SUCCESS) {
@@ -324,6 +582,9 @@ namespace Jazz2
 						//if ((flags & 0x02) == 0x02) {
 						//	keepIndexed = true;
 						//}
+						if ((flags & 0x04) == 0x04) {
+							item.Standalone = true;
+						}
 					}
 
 					// TODO: Implement true indexed sprites
@@ -331,11 +592,7 @@ namespace Jazz2
 					if (value["PaletteOffset"].get(paletteOffset) != SUCCESS) {
 						paletteOffset = 0;
 					}
-
-					graphics.Base = RequestGraphics(assetPath, (uint16_t)paletteOffset);
-					if (graphics.Base == nullptr) {
-						continue;
-					}
+					item.PaletteOffset = (uint16_t)paletteOffset;
 
 					int64_t frameOffset;
 					if (value["FrameOffset"].get(frameOffset) != SUCCESS) {
@@ -343,19 +600,17 @@ namespace Jazz2
 					}
 					graphics.FrameOffset = (int32_t)frameOffset;
 
-					graphics.AnimDuration = graphics.Base->AnimDuration;
-					graphics.FrameCount = graphics.Base->FrameCount;
-
+					// Frame count and duration default to values from the graphics, so they are resolved in FinalizeMetadata()
 					int64_t frameCount;
-					if (value["FrameCount"].get(frameCount) == SUCCESS) {
+					item.HasFrameCount = (value["FrameCount"].get(frameCount) == SUCCESS);
+					if (item.HasFrameCount) {
 						graphics.FrameCount = (int32_t)frameCount;
-					} else {
-						graphics.FrameCount -= graphics.FrameOffset;
 					}
 
 					// TODO: Use AnimDuration instead
 					double frameRate;
-					if (value["FrameRate"].get(frameRate) == SUCCESS) {
+					item.HasFrameRate = (value["FrameRate"].get(frameRate) == SUCCESS);
+					if (item.HasFrameRate) {
 						graphics.AnimDuration = (frameRate <= 0 ? -1.0f : (1.0f / (float)frameRate) * 5.0f);
 					}
 
@@ -368,14 +623,6 @@ namespace Jazz2
 							}
 						}
 					}
-
-					// If no bounding box is provided, use the first sprite
-					if (metadata->BoundingBox == Vector2i(InvalidValue, InvalidValue)) {
-						// TODO: Remove this bounding box reduction
-						metadata->BoundingBox = graphics.Base->FrameDimensions - Vector2i(2, 2);
-					}
-
-					metadata->Graphics.emplace(key, std::move(graphics));
 				}
 			}
 
@@ -383,7 +630,7 @@ namespace Jazz2
 			if (doc["Sounds"].get(sounds) == SUCCESS) {
 				size_t count;
 				if (sounds.count_fields().get(count) == SUCCESS) {
-					metadata->Sounds.reserve(count);
+					pending.Sounds.reserve(count);
 				}
 
 				for (auto it : sounds) {
@@ -396,7 +643,8 @@ namespace Jazz2
 						continue;
 					}
 
-					SoundResource sound;
+					PendingSoundResource item;
+					item.Name = key;
 
 					for (auto assetPathItem : assetPaths) {
 						std::string_view assetPath;
@@ -409,21 +657,236 @@ namespace Jazz2
 									continue;
 								}
 							}
-							sound.Buffers.emplace_back(std::make_unique<AudioBuffer>(fullPath));
+							item.Paths.push_back(std::move(fullPath));
 						}
 					}
 
-					if (!sound.Buffers.empty()) {
-						metadata->Sounds.emplace(key, std::move(sound));
+					// Other fields must be read after the array is consumed
+					int64_t priority;
+					if (value["Priority"].get(priority) != SUCCESS) {
+						priority = 0;
+					}
+					item.Priority = (int32_t)priority;
+
+					int64_t maxInstances;
+					if (value["MaxInstances"].get(maxInstances) != SUCCESS) {
+						maxInstances = 0;
+					}
+					item.MaxInstances = (int32_t)maxInstances;
+
+					if (!item.Paths.empty()) {
+						pending.Sounds.push_back(std::move(item));
+					}
+				}
+			}
+		}
+
+		return true;
+	}
+
+	void ContentResolver::PreloadMetadata(PendingMetadata& pending)
+	{
+		if (!ParseMetadata(pending)) {
+			return;
+		}
+
+		for (auto& item : pending.Graphics) {
+			// Only graphics in the native format can be decoded in advance, the rest is loaded in FinalizeMetadata()
+			if (fs::GetExtension(item.Path) != "aura"_s) {
+				continue;
+			}
+			if (PreloadedGraphics* existing = FindPreloadedGraphics(pending, item.Path, item.PaletteOffset)) {
+				existing->Standalone |= item.Standalone;
+				continue;
+			}
+
+			PreloadedGraphics& graphics = pending.LoadedGraphics.emplace_back();
+			if (LoadGraphicsAura(item.Path, item.PaletteOffset, graphics)) {
+				graphics.Standalone = item.Standalone;
+			} else {
+				pending.LoadedGraphics.pop_back();
+			}
+		}
+
+		for (auto& item : pending.Sounds) {
+			for (auto& path : item.Paths) {
+				// Sounds are shared by all metadata, so decode only those which are not loaded yet
+#if defined(WITH_THREADS)
+				_preloadMutex.Lock();
+				bool isCached = _cachedSounds.contains(path);
+				_preloadMutex.Unlock();
+				if (isCached) {
+					continue;
+				}
+#endif
+				PreloadedSound& sound = pending.LoadedSounds.emplace_back();
+				if (!LoadSound(path, sound)) {
+					pending.LoadedSounds.pop_back();
+				}
+			}
+		}
+	}
+
+	Metadata* ContentResolver::FinalizeMetadata(PendingMetadata& pending)
+	{
+		if (!pending.IsValid) {
+			return nullptr;
+		}
+
+		std::unique_ptr<Metadata> metadata = std::make_unique<Metadata>();
+		metadata->Flags |= MetadataFlags::Referenced;
+		metadata->BoundingBox = pending.BoundingBox;
+		metadata->Graphics.reserve(pending.Graphics.size());
+		metadata->Sounds.reserve(pending.Sounds.size());
+
+		for (auto& item : pending.Graphics) {
+			// Use pixels decoded on a worker thread if available, otherwise load the graphics synchronously
+			GenericGraphicResource* base = nullptr;
+			PreloadedGraphics* preloaded = FindPreloadedGraphics(pending, item.Path, item.PaletteOffset);
+			if (preloaded != nullptr && preloaded->Resource != nullptr) {
+				base = FinalizeGraphics(*preloaded);
+			} else {
+				base = RequestGraphics(item.Path, item.PaletteOffset, item.Standalone);
+			}
+			if (base == nullptr) {
+				continue;
+			}
+
+			GraphicResource& graphics = item.Resource;
+			graphics.Base = base;
+			if (!item.HasFrameRate) {
+				graphics.AnimDuration = base->AnimDuration;
+			}
+			if (!item.HasFrameCount) {
+				graphics.FrameCount = base->FrameCount - graphics.FrameOffset;
+			}
+
+			// If no bounding box is provided, use the first sprite
+			if (metadata->BoundingBox == Vector2i(InvalidValue, InvalidValue)) {
+				// TODO: Remove this bounding box reduction
+				metadata->BoundingBox = base->FrameDimensions - Vector2i(2, 2);
+			}
+
+			metadata->Graphics.emplace(item.Name, std::move(graphics));
+		}
+
+		for (auto& item : pending.Sounds) {
+			SoundResource sound;
+			sound.Priority = item.Priority;
+			sound.MaxInstances = item.MaxInstances;
+
+			for (auto& path : item.Paths) {
+				PreloadedSound* preloaded = nullptr;
+				for (auto& loaded : pending.LoadedSounds) {
+					if (loaded.Samples != nullptr && loaded.Path == path) {
+						preloaded = &loaded;
+						break;
 					}
 				}
+
+				sound.Buffers.push_back(RequestSound(path, preloaded));
+			}
+
+			metadata->Sounds.emplace(item.Name, std::move(sound));
+		}
+
+		metadata->BuildStateIndex();
+
+		return _cachedMetadata.emplace(pending.Path, std::move(metadata)).first->second.get();
+	}
+
+	ContentResolver::PreloadedGraphics* ContentResolver::FindPreloadedGraphics(PendingMetadata& pending, const StringView& path, uint16_t paletteOffset)
+	{
+		for (auto& graphics : pending.LoadedGraphics) {
+			if (graphics.PaletteOffset == paletteOffset && graphics.Path == path) {
+				return &graphics;
 			}
 		}
+		return nullptr;
+	}
+
+	GenericSoundResource* ContentResolver::RequestSound(const StringView& path, PreloadedSound* preloaded)
+	{
+		auto it = _cachedSounds.find(String::nullTerminatedView(path));
+		if (it != _cachedSounds.end()) {
+			// Already loaded - Mark as referenced
+			it->second->Flags |= GenericSoundResourceFlags::Referenced;
+			_soundBuffersSaved++;
+			_soundBytesSaved += it->second->Buffer.bufferSize();
+			return it->second.get();
+		}
+
+		std::unique_ptr<GenericSoundResource> sound = std::make_unique<GenericSoundResource>();
+		sound->Flags = GenericSoundResourceFlags::Referenced;
 
-		return _cachedMetadata.emplace(pathNormalized, std::move(metadata)).first->second.get();
+		bool hasLoaded;
+		if (preloaded != nullptr) {
+			sound->Buffer.init(preloaded->Format, preloaded->Frequency);
+			hasLoaded = sound->Buffer.loadFromSamples(preloaded->Samples.get(), preloaded->Size);
+			preloaded->Samples = nullptr;
+		} else {
+			hasLoaded = sound->Buffer.loadFromFile(path);
+		}
+		if (!hasLoaded) {
+			LOGE("Audio file \"%s\" cannot be loaded", String::nullTerminatedView(path).data());
+		}
+
+#if defined(WITH_THREADS)
+		_preloadMutex.Lock();
+#endif
+		GenericSoundResource* result = _cachedSounds.emplace(String(path), std::move(sound)).first->second.get();
+#if defined(WITH_THREADS)
+		_preloadMutex.Unlock();
+#endif
+		return result;
 	}
 
-	GenericGraphicResource* ContentResolver::RequestGraphics(const StringView& path, uint16_t paletteOffset)
+	bool ContentResolver::LoadSound(const StringView& path, PreloadedSound& result)
+	{
+		std::unique_ptr<IAudioLoader> audioLoader = IAudioLoader::createFromFile(path);
+		if (!audioLoader->hasLoaded()) {
+			return false;
+		}
+
+		bool isStereo = (audioLoader->numChannels() == 2);
+		if (audioLoader->bytesPerSample() == 2) {
+			result.Format = (isStereo ? AudioBuffer::Format::STEREO16 : AudioBuffer::Format::MONO16);
+		} else {
+			result.Format = (isStereo ? AudioBuffer::Format::STEREO8 : AudioBuffer::Format::MONO8);
+		}
+
+		// Decode all samples here, so only OpenAL buffer has to be filled on the main thread
+		result.Path = path;
+		result.Frequency = audioLoader->frequency();
+		result.Size = (uint32_t)audioLoader->bufferSize();
+		result.Samples = std::make_unique<uint8_t[]>(result.Size);
+
+		std::unique_ptr<IAudioReader> audioReader = audioLoader->createReader();
+		audioReader->read(result.Samples.get(), result.Size);
+		return true;
+	}
+
+	void ContentResolver::WaitForPreloading()
+	{
+#if defined(WITH_THREADS)
+		_preloadMutex.Lock();
+		while (_preloadPendingCount > 0) {
+			_preloadCV.Wait(_preloadMutex);
+		}
+		_preloadMutex.Unlock();
+#endif
+	}
+
+	void ContentResolver::CancelPreloading()
+	{
+#if defined(WITH_THREADS)
+		// Workers still write to pending metadata, so they have to finish first
+		WaitForPreloading();
+		_preloadingMetadata.clear();
+#endif
+	}
+
+	GenericGraphicResource* ContentResolver::RequestGraphics(const StringView& path, uint16_t paletteOffset, bool standalone)
 	{
 		// First resources are requested, reset _isLoading flag, because palette should be already applied
 		_isLoading = false;
@@ -437,10 +900,10 @@ namespace Jazz2
 		}
 
 		if (fs::GetExtension(pathNormalized) == "aura"_s) {
-			return RequestGraphicsAura(pathNormalized, paletteOffset);
+			return RequestGraphicsAura(pathNormalized, paletteOffset, standalone);
 		}
 
-		auto s = fs::Open(fs::CombinePath({ GetContentPath(), "Animations"_s, pathNormalized + ".res"_s }), FileAccessMode::Read);
+		auto s = fs::Open(fs::CombinePath({ GetContentPath(), "Animations"_s, pathNormalized + ".res"_s }), FileAccessMode::Read | FileAccessMode::MemoryMapped);
 		auto fileSize = s->GetSize();
 		if (fileSize < 4 || fileSize > 64 * 1024 * 1024) {
 			// 64 MB file size limit, also if not found try to use cache
@@ -470,7 +933,7 @@ namespace Jazz2
 				int32_t w = texLoader->width();
 				int32_t h = texLoader->height();
 				auto pixels = (uint32_t*)texLoader->pixels();
-				const uint32_t* palette = _palettes + paletteOffset;
+				bool indexed = true;
 				bool linearSampling = false;
 				bool needsMask = true;
 
@@ -478,7 +941,7 @@ namespace Jazz2
 				if (doc["Flags"].get(flags) == SUCCESS) {
 					// Palette already applied, keep as is
 					if ((flags & 0x01) != 0x01) {
-						palette = nullptr;
+						indexed = false;
 						// TODO: Apply linear sampling only to these images
 						if ((flags & 0x02) == 0x02) {
 							linearSampling = true;
@@ -495,22 +958,18 @@ namespace Jazz2
 					for (int32_t i = 0; i < w * h; i++) {
 						// Save original alpha value for collision checking
 						graphics->Mask[i] = ((pixels[i] >> 24) & 0xff);
-						if (palette != nullptr) {
-							uint32_t color = palette[pixels[i] & 0xff];
-							pixels[i] = (color & 0xffffff) | ((((color >> 24) & 0xff) * ((pixels[i] >> 24) & 0xff) / 255) << 24);
-						}
-					}
-				} else if (palette != nullptr) {
-					for (int32_t i = 0; i < w * h; i++) {
-						uint32_t color = palette[pixels[i] & 0xff];
-						pixels[i] = (color & 0xffffff) | ((((color >> 24) & 0xff) * ((pixels[i] >> 24) & 0xff) / 255) << 24);
 					}
 				}
+				if (indexed) {
+					graphics->Flags |= GenericGraphicResourceFlags::Indexed;
+					ConvertToIndexedPixels(pixels, w * h, paletteOffset);
+				}
 
-				graphics->TextureDiffuse = std::make_unique<Texture>(fullPath.data(), Texture::Format::RGBA8, w, h);
+				graphics->TextureDiffuse = std::make_unique<Texture>(fullPath.data(), indexed ? Texture::Format::RG8 : Texture::Format::RGBA8, w, h);
 				graphics->TextureDiffuse->loadFromTexels((unsigned char*)pixels, 0, 0, w, h);
 				graphics->TextureDiffuse->setMinFiltering(linearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
 				graphics->TextureDiffuse->setMagFiltering(linearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
+				graphics->TextureRect = Recti(0, 0, w, h);
 
 				// TODO: Use FrameDuration instead
 				double animDuration;
@@ -532,6 +991,10 @@ namespace Jazz2
 				graphics->Coldspot = GetVector2iFromJson(doc["Coldspot"], Vector2i(InvalidValue, InvalidValue));
 				graphics->Gunspot = GetVector2iFromJson(doc["Gunspot"], Vector2i(InvalidValue, InvalidValue));
 
+				if (graphics->Mask != nullptr) {
+					BuildCollisionMask(*graphics);
+				}
+
 #if defined(DEATH_DEBUG)
 				MigrateGraphics(pathNormalized);
 #endif
@@ -542,19 +1005,38 @@ namespace Jazz2
 		return nullptr;
 	}
 
-	GenericGraphicResource* ContentResolver::RequestGraphicsAura(const StringView& path, uint16_t paletteOffset)
+	GenericGraphicResource* ContentResolver::RequestGraphicsAura(const StringView& path, uint16_t paletteOffset, bool standalone)
 	{
-		// Try "Content" directory first, then "Cache" directory
+		PreloadedGraphics graphics;
+		if (!LoadGraphicsAura(path, paletteOffset, graphics)) {
+			return nullptr;
+		}
+		graphics.Standalone = standalone;
+		return FinalizeGraphics(graphics);
+	}
+
+	bool ContentResolver::LoadGraphicsAura(const StringView& path, uint16_t paletteOffset, PreloadedGraphics& result)
+	{
+		// Try "Content" directory first, then archive and "Cache" directory, loose files always take precedence over the archive
 		String fullPath = fs::CombinePath({ GetContentPath(), "Animations"_s, path });
-		if (!fs::IsReadableFile(fullPath)) {
-			fullPath = fs::CombinePath({ GetCachePath(), "Animations"_s, path });
+		std::unique_ptr<Stream> s;
+		if (fs::IsReadableFile(fullPath)) {
+			s = fs::Open(fullPath, FileAccessMode::Read | FileAccessMode::MemoryMapped);
+		} else {
+			if (_animationsPak == nullptr) {
+				MountPakFiles();
+			}
+			s = _animationsPak->OpenFile(path);
+			if (s == nullptr) {
+				fullPath = fs::CombinePath({ GetCachePath(), "Animations"_s, path });
+				s = fs::Open(fullPath, FileAccessMode::Read | FileAccessMode::MemoryMapped);
+			}
 		}
 
-		auto s = fs::Open(fullPath, FileAccessMode::Read);
 		auto fileSize = s->GetSize();
 		if (fileSize < 16 || fileSize > 64 * 1024 * 1024) {
 			// 64 MB file size limit, also if not found try to use cache
-			return nullptr;
+			return false;
 		}
 
 		uint64_t signature1 = s->ReadValue<uint64_t>();
@@ -563,7 +1045,7 @@ namespace Jazz2
 		uint8_t flags = s->ReadValue<uint8_t>();
 
 		if (signature1 != 0xB8EF8498E2BFBBEF || signature2 != 0x208F || version != 2 || (flags & 0x80) != 0x80) {
-			return nullptr;
+			return false;
 		}
 
 		uint8_t channelCount = s->ReadValue<uint8_t>();
@@ -589,16 +1071,19 @@ namespace Jazz2
 
 		std::unique_ptr<uint32_t[]> pixels = std::make_unique<uint32_t[]>(width * height);
 
-		ReadImageFromFile(s, (uint8_t*)pixels.get(), width, height, channelCount);
+		if (!ReadImageFromFile(s, (uint8_t*)pixels.get(), width, height, channelCount)) {
+			return false;
+		}
 
-		std::unique_ptr<GenericGraphicResource> graphics = std::make_unique<GenericGraphicResource>();
+		std::unique_ptr<GenericGraphicResource>& graphics = result.Resource;
+		graphics = std::make_unique<GenericGraphicResource>();
 		graphics->Flags |= GenericGraphicResourceFlags::Referenced;
 
-		const uint32_t* palette = _palettes + paletteOffset;
+		bool indexed = true;
 		bool linearSampling = false;
 		bool needsMask = true;
 		if ((flags & 0x01) == 0x01) {
-			palette = nullptr;
+			indexed = false;
 			linearSampling = true;
 		}
 		if ((flags & 0x02) == 0x02) {
@@ -611,22 +1096,21 @@ namespace Jazz2
 			for (uint32_t i = 0; i < width * height; i++) {
 				// Save original alpha value for collision checking
 				graphics->Mask[i] = ((pixels[i] >> 24) & 0xff);
-				if (palette != nullptr) {
-					uint32_t color = palette[pixels[i] & 0xff];
-					pixels[i] = (color & 0xffffff) | ((((color >> 24) & 0xff) * ((pixels[i] >> 24) & 0xff) / 255) << 24);
-				}
-			}
-		} else if (palette != nullptr) {
-			for (uint32_t i = 0; i < width * height; i++) {
-				uint32_t color = palette[pixels[i] & 0xff];
-				pixels[i] = (color & 0xffffff) | ((((color >> 24) & 0xff) * ((pixels[i] >> 24) & 0xff) / 255) << 24);
 			}
 		}
+		if (indexed) {
+			// Colors are looked up by shaders, so the pixels don't depend on the current palette and can be decoded on any thread
+			graphics->Flags |= GenericGraphicResourceFlags::Indexed;
+			ConvertToIndexedPixels(pixels.get(), (int32_t)(width * height), paletteOffset);
+		}
 
-		graphics->TextureDiffuse = std::make_unique<Texture>(fullPath.data(), Texture::Format::RGBA8, width, height);
-		graphics->TextureDiffuse->loadFromTexels((unsigned char*)pixels.get(), 0, 0, width, height);
-		graphics->TextureDiffuse->setMinFiltering(linearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
-		graphics->TextureDiffuse->setMagFiltering(linearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
+		// Texture can be created only on the main thread, so keep the pixels for FinalizeGraphics()
+		result.Path = path;
+		result.PaletteOffset = paletteOffset;
+		result.TextureName = std::move(fullPath);
+		result.Pixels = std::move(pixels);
+		result.LinearSampling = linearSampling;
+		result.Standalone = false;
 
 		// AnimDuration is multiplied by 256 before saving, so divide it here back
 		graphics->AnimDuration = animDuration / 256.0f;
@@ -652,10 +1136,276 @@ namespace Jazz2
 			graphics->Gunspot = Vector2i(InvalidValue, InvalidValue);
 		}
 
-		return _cachedGraphics.emplace(Pair(String(path), paletteOffset), std::move(graphics)).first->second.get();
+		if (graphics->Mask != nullptr) {
+			BuildCollisionMask(*graphics);
+		}
+
+		return true;
+	}
+
+	uint16_t ContentResolver::GetIndexedPixel(uint32_t pixel, uint16_t paletteOffset)
+	{
+		// Low byte of the index is stored in red channel, green channel contains palette row in upper 2 bits and alpha in lower 6 bits
+		static_assert(IndexedPaletteCount <= 4, "Palette row must fit into 2 bits");
+		uint32_t index = std::min(paletteOffset + (pixel & 0xff), (uint32_t)(IndexedPaletteCount * ColorsPerPalette - 1));
+		uint32_t alpha = (((pixel >> 24) & 0xff) * 63 + 127) / 255;
+		return (uint16_t)((index & 0xff) | (((index >> 8) << 6 | alpha) << 8));
+	}
+
+	void ContentResolver::ConvertToIndexedPixels(uint32_t* pixels, int32_t count, uint16_t paletteOffset)
+	{
+		// Indexed pixels take only 2 bytes, so they are written to the first half of the same buffer,
+		// each source pixel is always read before it can be overwritten
+		uint8_t* dst = reinterpret_cast<uint8_t*>(pixels);
+		for (int32_t i = 0; i < count; i++) {
+			uint16_t indexedPixel = GetIndexedPixel(pixels[i], paletteOffset);
+			std::memcpy(&dst[i * 2], &indexedPixel, sizeof(indexedPixel));
+		}
+	}
+
+	void ContentResolver::BuildCollisionMask(GenericGraphicResource& graphics)
+	{
+		int32_t frameWidth = graphics.FrameDimensions.X;
+		int32_t frameHeight = graphics.FrameDimensions.Y;
+		int32_t framesX = graphics.FrameConfiguration.X;
+		int32_t frameCount = framesX * graphics.FrameConfiguration.Y;
+		int32_t stride = (frameWidth + 63) / 64;
+		int32_t sheetWidth = frameWidth * framesX;
+		if (frameWidth <= 0 || frameHeight <= 0 || frameCount <= 0) {
+			return;
+		}
+
+		size_t size = (size_t)frameCount * frameHeight * stride;
+		graphics.CollisionMask = std::make_unique<uint64_t[]>(size);
+		graphics.CollisionMaskMirrored = std::make_unique<uint64_t[]>(size);
+		graphics.CollisionMaskStride = stride;
+
+		for (int32_t frame = 0; frame < frameCount; frame++) {
+			const uint8_t* src = &graphics.Mask[(frame / framesX) * frameHeight * sheetWidth + (frame % framesX) * frameWidth];
+			uint64_t* dst = &graphics.CollisionMask[(size_t)frame * frameHeight * stride];
+			uint64_t* dstMirrored = &graphics.CollisionMaskMirrored[(size_t)frame * frameHeight * stride];
+
+			for (int32_t y = 0; y < frameHeight; y++) {
+				for (int32_t x = 0; x < frameWidth; x++) {
+					if (src[x] > GenericGraphicResource::AlphaThreshold) {
+						dst[x >> 6] |= (1ull << (x & 63));
+						int32_t xm = frameWidth - x - 1;
+						dstMirrored[xm >> 6] |= (1ull << (xm & 63));
+					}
+				}
+				src += sheetWidth;
+				dst += stride;
+				dstMirrored += stride;
+			}
+		}
+
+#if defined(DEATH_DEBUG)
+		DEATH_ASSERT(Actors::ActorBase::VerifyCollisionMask(graphics), , "Bit-packed collision mask doesn't match the byte mask");
+#endif
+	}
+
+	GenericGraphicResource* ContentResolver::FinalizeGraphics(PreloadedGraphics& preloaded)
+	{
+		// The same graphics could be already finalized by another metadata
+		auto it = _cachedGraphics.find(Pair(String::nullTerminatedView(preloaded.Path), preloaded.PaletteOffset));
+		if (it != _cachedGraphics.end()) {
+			it->second->Flags |= GenericGraphicResourceFlags::Referenced;
+			preloaded.Resource = nullptr;
+			preloaded.Pixels = nullptr;
+			return it->second.get();
+		}
+
+		std::unique_ptr<GenericGraphicResource>& graphics = preloaded.Resource;
+		int32_t width = graphics->FrameDimensions.X * graphics->FrameConfiguration.X;
+		int32_t height = graphics->FrameDimensions.Y * graphics->FrameConfiguration.Y;
+
+		// Sheets are packed into shared pages, so sprites of different resources can be batched together
+		if (!preloaded.Standalone) {
+			graphics->TextureDiffuse = _spriteAtlas.Add(preloaded.Pixels.get(), width, height, preloaded.LinearSampling, graphics->IsIndexed(), false, graphics->TextureRect);
+		}
+		if (graphics->TextureDiffuse != nullptr) {
+			graphics->Flags |= GenericGraphicResourceFlags::Packed;
+		} else {
+			graphics->TextureDiffuse = std::make_unique<Texture>(preloaded.TextureName.data(), graphics->IsIndexed() ? Texture::Format::RG8 : Texture::Format::RGBA8, width, height);
+			graphics->TextureDiffuse->loadFromTexels((unsigned char*)preloaded.Pixels.get(), 0, 0, width, height);
+			graphics->TextureDiffuse->setMinFiltering(preloaded.LinearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
+			graphics->TextureDiffuse->setMagFiltering(preloaded.LinearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
+			graphics->TextureRect = Recti(0, 0, width, height);
+		}
+		preloaded.Pixels = nullptr;
+
+		return _cachedGraphics.emplace(Pair(std::move(preloaded.Path), preloaded.PaletteOffset), std::move(graphics)).first->second.get();
+	}
+
+	void ContentResolver::RepackSpriteAtlas()
+	{
+		// Released space of a page is never reused, and which sheets of the previous level are still needed is known only after
+		// the next level is loaded. At that point, its resources already use the pages, so sheets are moved here instead,
+		// before anything of the next level is created. The previous level is no longer drawn, so its sprites can be left as is.
+		CountUsedSheets();
+		if (_spriteAtlas.EndUsageCount() == 0) {
+			return;
+		}
+
+		int32_t movedCount = 0;
+		for (auto& [key, graphics] : _cachedGraphics) {
+			if ((graphics->Flags & GenericGraphicResourceFlags::Packed) != GenericGraphicResourceFlags::Packed ||
+				!_spriteAtlas.IsSparsePage(graphics->TextureDiffuse.get())) {
+				continue;
+			}
+
+			// Pixels are not kept in memory, so the sheet has to be decoded again
+			PreloadedGraphics reloaded;
+			if (!LoadGraphicsAura(key.first(), key.second(), reloaded)) {
+				continue;
+			}
+
+			int32_t width = graphics->FrameDimensions.X * graphics->FrameConfiguration.X;
+			int32_t height = graphics->FrameDimensions.Y * graphics->FrameConfiguration.Y;
+			Recti rect;
+			std::shared_ptr<Texture> texture = _spriteAtlas.Add(reloaded.Pixels.get(), width, height, reloaded.LinearSampling, graphics->IsIndexed(), true, rect);
+			if (texture != nullptr) {
+				graphics->TextureDiffuse = std::move(texture);
+				graphics->TextureRect = rect;
+				movedCount++;
+			}
+		}
+
+		// Sparse pages are released in EndLoading() when no resource uses them anymore
+		LOGI("Moved %i sprite sheets to persistent pages of the sprite atlas", movedCount);
+	}
+
+	void ContentResolver::LogSpriteAtlasStatistics()
+	{
+		CountUsedSheets();
+		_spriteAtlas.LogStatistics();
+	}
+
+	void ContentResolver::CountUsedSheets()
+	{
+		_spriteAtlas.BeginUsageCount();
+		for (auto& [key, graphics] : _cachedGraphics) {
+			if ((graphics->Flags & GenericGraphicResourceFlags::Packed) == GenericGraphicResourceFlags::Packed) {
+				_spriteAtlas.AddUsedSheet(graphics->TextureDiffuse.get(), graphics->TextureRect);
+			}
+		}
+	}
+
+	void ContentResolver::BenchmarkImages()
+	{
+		SmallVector<String, 0> directories;
+		directories.push_back(fs::CombinePath(GetContentPath(), "Animations"_s));
+		directories.push_back(fs::CombinePath(GetCachePath(), "Animations"_s));
+
+		uint32_t fileCount = 0;
+		uint64_t pixelCount = 0;
+		float totalTime = 0.0f;
+		float maxTime = 0.0f;
+		String maxTimePath;
+
+		while (!directories.empty()) {
+			String directory = std::move(directories.back());
+			directories.pop_back();
+
+			fs::Directory dir(directory);
+			while (true) {
+				StringView item = dir.GetNext();
+				if (item == nullptr) {
+					break;
+				}
+				if (fs::DirectoryExists(item)) {
+					directories.push_back(item);
+					continue;
+				}
+				if (fs::GetExtension(item) != "aura"_s) {
+					continue;
+				}
+
+				// Files are opened the same way as in LoadGraphicsAura(), only the header is skipped
+				std::unique_ptr<Stream> s = fs::Open(item, FileAccessMode::Read | FileAccessMode::MemoryMapped);
+				if (s->GetSize() < 39) {
+					continue;
+				}
+
+				uint64_t signature1 = s->ReadValue<uint64_t>();
+				uint32_t signature2 = s->ReadValue<uint16_t>();
+				uint8_t version = s->ReadValue<uint8_t>();
+				uint8_t flags = s->ReadValue<uint8_t>();
+				if (signature1 != 0xB8EF8498E2BFBBEF || signature2 != 0x208F || version != 2 || (flags & 0x80) != 0x80) {
+					continue;
+				}
+
+				uint8_t channelCount = s->ReadValue<uint8_t>();
+				uint32_t frameDimensionsX = s->ReadValue<uint32_t>();
+				uint32_t frameDimensionsY = s->ReadValue<uint32_t>();
+				uint8_t frameConfigurationX = s->ReadValue<uint8_t>();
+				uint8_t frameConfigurationY = s->ReadValue<uint8_t>();
+				s->Seek(39, SeekOrigin::Begin);
+
+				uint32_t width = frameDimensionsX * frameConfigurationX;
+				uint32_t height = frameDimensionsY * frameConfigurationY;
+				std::unique_ptr<uint32_t[]> pixels = std::make_unique<uint32_t[]>(width * height);
+
+				TimeStamp startTime = TimeStamp::now();
+				bool success = ReadImageFromFile(s, (uint8_t*)pixels.get(), width, height, channelCount);
+				float time = startTime.millisecondsSince();
+				if (!success) {
+					LOGW("Failed to decode \"%s\"", item.data());
+					continue;
+				}
+
+				fileCount++;
+				pixelCount += (uint64_t)width * height;
+				totalTime += time;
+				if (maxTime < time) {
+					maxTime = time;
+					maxTimePath = item;
+				}
+			}
+		}
+
+		if (fileCount > 0) {
+			LOGI("Decoded %u images (%.2f Mpx) in %.3f ms, %.3f ms per image, slowest \"%s\" took %.3f ms", fileCount, pixelCount / 1000000.0f,
+				totalTime, totalTime / fileCount, maxTimePath.data(), maxTime);
+		} else {
+			LOGW("No images found");
+		}
 	}
 
-	void ContentResolver::ReadImageFromFile(std::unique_ptr<Stream>& s, uint8_t* data, int32_t width, int32_t height, int32_t channelCount)
+	bool ContentResolver::ReadImageFromFile(std::unique_ptr<Stream>& s, uint8_t* data, int32_t width, int32_t height, int32_t channelCount)
+	{
+		int32_t srcLength = s->GetSize() - s->GetPosition();
+		if (srcLength <= 0) {
+			return false;
+		}
+
+		if (s->GetType() == Stream::Type::Memory) {
+			// Files from archives are already in memory, so decode them directly without any copying
+			auto ms = static_cast<MemoryStream*>(s.get());
+			DecodeImage(ms->GetBuffer() + ms->GetPosition(), srcLength, data, width, height, channelCount);
+			ms->Seek(0, SeekOrigin::End);
+			return true;
+		}
+		if (s->GetType() == Stream::Type::Mapped) {
+			// Loose files are usually mapped to memory, so they can be decoded directly too
+			auto ms = static_cast<MappedStream*>(s.get());
+			DecodeImage(ms->GetBuffer() + ms->GetPosition(), srcLength, data, width, height, channelCount);
+			ms->Seek(0, SeekOrigin::End);
+			return true;
+		}
+
+		// Read the whole remaining payload at once instead of pulling it from the stream byte-by-byte
+		std::unique_ptr<uint8_t[]> src = std::make_unique<uint8_t[]>(srcLength);
+		srcLength = s->Read(src.get(), srcLength);
+		if (srcLength <= 0) {
+			return false;
+		}
+
+		DecodeImage(src.get(), srcLength, data, width, height, channelCount);
+		return true;
+	}
+
+	void ContentResolver::DecodeImage(const uint8_t* src, int32_t srcLength, uint8_t* data, int32_t width, int32_t height, int32_t channelCount)
 	{
 		typedef union {
 			struct {
@@ -675,9 +1425,10 @@ namespace Jazz2
 
 		#define QOI_COLOR_HASH(C) (C.rgba.r*3 + C.rgba.g*5 + C.rgba.b*7 + C.rgba.a*11)
 
+		const uint8_t* srcEnd = src + srcLength;
+
 		rgba_t index[64] { };
 		rgba_t px;
-		int32_t run = 0;
 		int32_t px_len = width * height * channelCount;
 
 		px.rgba.r = 0;
@@ -685,41 +1436,73 @@ namespace Jazz2
 		px.rgba.b = 0;
 		px.rgba.a = 255;
 
-		for (int32_t px_pos = 0; px_pos < px_len; px_pos += channelCount) {
-			if (run > 0) {
-				run--;
+		int32_t px_pos = 0;
+		while (px_pos < px_len && src < srcEnd) {
+			int32_t b1 = *src++;
+
+			if (b1 == QOI_OP_RGB) {
+				if (srcEnd - src < 3) {
+					break;
+				}
+				px.rgba.r = src[0];
+				px.rgba.g = src[1];
+				px.rgba.b = src[2];
+				src += 3;
+			} else if (b1 == QOI_OP_RGBA) {
+				if (srcEnd - src < 4) {
+					break;
+				}
+				px.rgba.r = src[0];
+				px.rgba.g = src[1];
+				px.rgba.b = src[2];
+				px.rgba.a = src[3];
+				src += 4;
+			} else if ((b1 & QOI_MASK_2) == QOI_OP_INDEX) {
+				px = index[b1];
+			} else if ((b1 & QOI_MASK_2) == QOI_OP_DIFF) {
+				px.rgba.r += ((b1 >> 4) & 0x03) - 2;
+				px.rgba.g += ((b1 >> 2) & 0x03) - 2;
+				px.rgba.b += (b1 & 0x03) - 2;
+			} else if ((b1 & QOI_MASK_2) == QOI_OP_LUMA) {
+				if (src >= srcEnd) {
+					break;
+				}
+				int32_t b2 = *src++;
+				int32_t vg = (b1 & 0x3f) - 32;
+				px.rgba.r += vg - 8 + ((b2 >> 4) & 0x0f);
+				px.rgba.g += vg;
+				px.rgba.b += vg - 8 + (b2 & 0x0f);
 			} else {
-				int32_t b1 = s->ReadValue<uint8_t>();
-
-				if (b1 == QOI_OP_RGB) {
-					px.rgba.r = s->ReadValue<uint8_t>();
-					px.rgba.g = s->ReadValue<uint8_t>();
-					px.rgba.b = s->ReadValue<uint8_t>();
-				} else if (b1 == QOI_OP_RGBA) {
-					px.rgba.r = s->ReadValue<uint8_t>();
-					px.rgba.g = s->ReadValue<uint8_t>();
-					px.rgba.b = s->ReadValue<uint8_t>();
-					px.rgba.a = s->ReadValue<uint8_t>();
-				} else if ((b1 & QOI_MASK_2) == QOI_OP_INDEX) {
-					px = index[b1];
-				} else if ((b1 & QOI_MASK_2) == QOI_OP_DIFF) {
-					px.rgba.r += ((b1 >> 4) & 0x03) - 2;
-					px.rgba.g += ((b1 >> 2) & 0x03) - 2;
-					px.rgba.b += (b1 & 0x03) - 2;
-				} else if ((b1 & QOI_MASK_2) == QOI_OP_LUMA) {
-					int32_t b2 = s->ReadValue<uint8_t>();
-					int32_t vg = (b1 & 0x3f) - 32;
-					px.rgba.r += vg - 8 + ((b2 >> 4) & 0x0f);
-					px.rgba.g += vg;
-					px.rgba.b += vg - 8 + (b2 & 0x0f);
-				} else if ((b1 & QOI_MASK_2) == QOI_OP_RUN) {
-					run = (b1 & 0x3f);
+				// QOI_OP_RUN - the color doesn't change, so the index is already up-to-date, fill the whole run at once
+				int32_t runEnd = std::min(px_pos + ((b1 & 0x3f) + 1) * channelCount, px_len);
+				if (channelCount == 4) {
+					uint32_t* dst = (uint32_t*)(data + px_pos);
+					uint32_t* dstEnd = (uint32_t*)(data + runEnd);
+					while (dst < dstEnd) {
+						*dst++ = px.v;
+					}
+				} else {
+					for (; px_pos < runEnd; px_pos += channelCount) {
+						std::memcpy(data + px_pos, &px, channelCount);
+					}
 				}
+				px_pos = runEnd;
+				continue;
+			}
 
-				index[QOI_COLOR_HASH(px) & 63] = px;
+			index[QOI_COLOR_HASH(px) & 63] = px;
+
+			if (channelCount == 4) {
+				*(uint32_t*)(data + px_pos) = px.v;
+			} else {
+				std::memcpy(data + px_pos, &px, channelCount);
 			}
+			px_pos += channelCount;
+		}
 
-			*(rgba_t*)(data + px_pos) = px;
+		// Truncated files are filled with the last color, so the texture doesn't contain uninitialized memory
+		for (; px_pos < px_len; px_pos += channelCount) {
+			std::memcpy(data + px_pos, &px, channelCount);
 		}
 	}
 
@@ -731,7 +1514,7 @@ namespace Jazz2
 			fullPath = fs::CombinePath({ GetCachePath(), "Tilesets"_s, path + ".j2t"_s });
 		}
 
-		auto s = fs::Open(fullPath, FileAccessMode::Read);
+		auto s = fs::Open(fullPath, FileAccessMode::Read | FileAccessMode::MemoryMapped);
 		if (!s->IsValid()) {
 			return nullptr;
 		}
@@ -750,35 +1533,14 @@ namespace Jazz2
 		// Read compressed palette and mask
 		int32_t compressedSize = s->ReadValue<int32_t>();
 		int32_t uncompressedSize = s->ReadValue<int32_t>();
-		std::unique_ptr<uint8_t[]> compressedBuffer = std::make_unique<uint8_t[]>(compressedSize);
-		std::unique_ptr<uint8_t[]> uncompressedBuffer = std::make_unique<uint8_t[]>(uncompressedSize);
-		s->Read(compressedBuffer.get(), compressedSize);
-
-		auto result = CompressionUtils::Inflate(compressedBuffer.get(), compressedSize, uncompressedBuffer.get(), uncompressedSize);
-		if (result != DecompressionResult::Success) {
-			return nullptr;
-		}
-		MemoryStream uc(uncompressedBuffer.get(), uncompressedSize);
+		int32_t imageOffset = s->GetPosition() + compressedSize;
+		DeflateStream uc(*s, compressedSize, uncompressedSize);
 
 		// Palette
 		if (applyPalette) {
 			uint32_t newPalette[ColorsPerPalette];
 			uc.Read(newPalette, ColorsPerPalette * sizeof(uint32_t));
-
-			if (std::memcmp(_palettes, newPalette, ColorsPerPalette * sizeof(uint32_t)) != 0) {
-				// Palettes differs, drop all cached resources, so it will be reloaded with new palette
-				if (_isLoading) {
-					_cachedMetadata.clear();
-					_cachedGraphics.clear();
-
-					for (int32_t i = 0; i < (int32_t)FontType::Count; i++) {
-						_fonts[i] = nullptr;
-					}
-				}
-
-				std::memcpy(_palettes, newPalette, ColorsPerPalette * sizeof(uint32_t));
-				RecreateGemPalettes();
-			}
+			ApplyPalette(newPalette);
 		} else {
 			uc.Seek(ColorsPerPalette * sizeof(uint32_t), SeekOrigin::Current);
 		}
@@ -793,10 +1555,16 @@ namespace Jazz2
 				mask[pixelIdx] = (((idx >> k) & 0x01) != 0);
 			}
 		}
+		if (!uc.IsValid()) {
+			return nullptr;
+		}
 
-		// Image
+		// Image follows the compressed data, but the decompressor may not consume all of it
+		s->Seek(imageOffset, SeekOrigin::Begin);
 		std::unique_ptr<uint32_t[]> pixels = std::make_unique<uint32_t[]>(width * height);
-		ReadImageFromFile(s, (uint8_t*)pixels.get(), width, height, channelCount);
+		if (!ReadImageFromFile(s, (uint8_t*)pixels.get(), width, height, channelCount)) {
+			return nullptr;
+		}
 
 		if (paletteRemapping != nullptr) {
 			for (uint32_t i = 0; i < width * height; i++) {
@@ -853,7 +1621,7 @@ namespace Jazz2
 			fullPath = fs::CombinePath({ GetCachePath(), "Episodes"_s, pathNormalized + ".j2l"_s });
 		}
 
-		auto s = fs::Open(fullPath, FileAccessMode::Read);
+		auto s = fs::Open(fullPath, FileAccessMode::Read | FileAccessMode::MemoryMapped);
 		RETURNF_ASSERT_MSG(s->IsValid(), "Cannot open file for reading");
 
 		uint64_t signature = s->ReadValue<uint64_t>();
@@ -865,15 +1633,8 @@ namespace Jazz2
 		// Read compressed data
 		int32_t compressedSize = s->ReadValue<int32_t>();
 		int32_t uncompressedSize = s->ReadValue<int32_t>();
-		std::unique_ptr<uint8_t[]> compressedBuffer = std::make_unique<uint8_t[]>(compressedSize);
-		std::unique_ptr<uint8_t[]> uncompressedBuffer = std::make_unique<uint8_t[]>(uncompressedSize);
-		s->Read(compressedBuffer.get(), compressedSize);
-
-		s->Close();
-
-		auto result = CompressionUtils::Inflate(compressedBuffer.get(), compressedSize, uncompressedBuffer.get(), uncompressedSize);
-		RETURNF_ASSERT_MSG(result == DecompressionResult::Success, "File cannot be uncompressed");
-		MemoryStream uc(uncompressedBuffer.get(), uncompressedSize);
+		// Data are decompressed while parsing, so the file stays open until the level is loaded
+		DeflateStream uc(*s, compressedSize, uncompressedSize);
 
 		// Read metadata
 		uint8_t nameSize = uc.ReadValue<uint8_t>();
@@ -923,21 +1684,7 @@ namespace Jazz2
 		if (hasCustomPalette) {
 			uint32_t newPalette[ColorsPerPalette];
 			uc.Read(newPalette, ColorsPerPalette * sizeof(uint32_t));
-
-			if (std::memcmp(_palettes, newPalette, ColorsPerPalette * sizeof(uint32_t)) != 0) {
-				// Palettes differs, drop all cached resources, so it will be reloaded with new palette
-				if (_isLoading) {
-					_cachedMetadata.clear();
-					_cachedGraphics.clear();
-
-					for (int32_t i = 0; i < (int32_t)FontType::Count; i++) {
-						_fonts[i] = nullptr;
-					}
-				}
-
-				std::memcpy(_palettes, newPalette, ColorsPerPalette * sizeof(uint32_t));
-				RecreateGemPalettes();
-			}
+			ApplyPalette(newPalette);
 		}
 
 		std::unique_ptr<Tiles::TileMap> tileMap = std::make_unique<Tiles::TileMap>(levelHandler, defaultTileset, captionTileId, pitType, !hasCustomPalette);
@@ -985,6 +1732,7 @@ namespace Jazz2
 		// Events
 		std::unique_ptr<Events::EventMap> eventMap = std::make_unique<Events::EventMap>(levelHandler, tileMap->Size(), pitType);
 		eventMap->ReadEvents(uc, tileMap, difficulty);
+		RETURNF_ASSERT_MSG(uc.IsValid(), "File cannot be uncompressed");
 
 		// TODO: Bonus level
 		levelHandler->OnLevelLoaded(fullPath, name, nextLevel, secretLevel, tileMap, eventMap, defaultMusic, ambientColor,
@@ -997,20 +1745,26 @@ namespace Jazz2
 	{
 		static_assert(sizeof(SpritePalette) == ColorsPerPalette * sizeof(uint32_t));
 
-		if (std::memcmp(_palettes, SpritePalette, ColorsPerPalette * sizeof(uint32_t)) != 0) {
-			// Palettes differs, drop all cached resources, so it will be reloaded with new palette
-			if (_isLoading) {
-				_cachedMetadata.clear();
-				_cachedGraphics.clear();
+		ApplyPalette((const uint32_t*)SpritePalette);
+	}
 
-				for (int32_t i = 0; i < (int32_t)FontType::Count; i++) {
-					_fonts[i] = nullptr;
-				}
-			}
+	void ContentResolver::ApplyPalette(const uint32_t* palette)
+	{
+		if (std::memcmp(_palettes, palette, ColorsPerPalette * sizeof(uint32_t)) == 0) {
+			return;
+		}
 
-			std::memcpy(_palettes, SpritePalette, ColorsPerPalette * sizeof(uint32_t));
-			RecreateGemPalettes();
+		// Sprites are indexed, so they can be kept in cache and only the palette texture is updated,
+		// fonts are still colorized on load, so they have to be recreated with new palette
+		if (_isLoading) {
+			for (int32_t i = 0; i < (int32_t)FontType::Count; i++) {
+				_fonts[i] = nullptr;
+			}
 		}
+
+		std::memcpy(_palettes, palette, ColorsPerPalette * sizeof(uint32_t));
+		RecreateGemPalettes();
+		UpdatePaletteTexture();
 	}
 
 	std::optional<Episode> ContentResolver::GetEpisode(const StringView& name)
@@ -1024,7 +1778,7 @@ namespace Jazz2
 
 	std::optional<Episode> ContentResolver::GetEpisodeByPath(const StringView& path)
 	{
-		auto s = fs::Open(path, FileAccessMode::Read);
+		auto s = fs::Open(path, FileAccessMode::Read | FileAccessMode::MemoryMapped);
 		if (s->GetSize() < 16) {
 			return std::nullopt;
 		}
@@ -1115,30 +1869,100 @@ namespace Jazz2
 
 		_precompiledShaders[(int32_t)PrecompiledShader::TexturedBackground] = CompileShader("TexturedBackground", Shader::DefaultVertex::SPRITE, Shaders::TexturedBackgroundFs);
 		_precompiledShaders[(int32_t)PrecompiledShader::TexturedBackgroundCircle] = CompileShader("TexturedBackgroundCircle", Shader::DefaultVertex::SPRITE, Shaders::TexturedBackgroundCircleFs);
+		// Tile layer chunks have their own vertex buffers, so no batched variant is registered for them
+		_precompiledShaders[(int32_t)PrecompiledShader::TileLayer] = CompileShader("TileLayer", Shader::DefaultVertex::MESHSPRITE, Shaders::TileLayerFs);
+		_precompiledShaders[(int32_t)PrecompiledShader::TileLayerTinted] = CompileShader("TileLayerTinted", Shader::DefaultVertex::MESHSPRITE, Shaders::TintedFs);
+
+		// Instanced variants are compiled only if enabled, other shaders are always batched using uniform blocks
+		const bool withInstancedSprites = theApplication().appConfiguration().withInstancedSprites;
 
 		_precompiledShaders[(int32_t)PrecompiledShader::Colorized] = CompileShader("Colorized", Shader::DefaultVertex::SPRITE, Shaders::ColorizedFs);
 		_precompiledShaders[(int32_t)PrecompiledShader::BatchedColorized] = CompileShader("BatchedColorized", Shader::DefaultVertex::BATCHED_SPRITES, Shaders::ColorizedFs, Shader::Introspection::NoUniformsInBlocks);
 		_precompiledShaders[(int32_t)PrecompiledShader::Colorized]->registerBatchedShader(*_precompiledShaders[(int32_t)PrecompiledShader::BatchedColorized]);
+		if (withInstancedSprites) {
+			_precompiledShaders[(int32_t)PrecompiledShader::InstancedColorized] = CompileShader("InstancedColorized", Shader::DefaultVertex::INSTANCED_SPRITES, Shaders::ColorizedFs);
+			_precompiledShaders[(int32_t)PrecompiledShader::Colorized]->registerInstancedShader(*_precompiledShaders[(int32_t)PrecompiledShader::InstancedColorized]);
+		}
 
 		_precompiledShaders[(int32_t)PrecompiledShader::Tinted] = CompileShader("Tinted", Shader::DefaultVertex::SPRITE, Shaders::TintedFs);
 		_precompiledShaders[(int32_t)PrecompiledShader::BatchedTinted] = CompileShader("BatchedTinted", Shader::DefaultVertex::BATCHED_SPRITES, Shaders::TintedFs, Shader::Introspection::NoUniformsInBlocks);
 		_precompiledShaders[(int32_t)PrecompiledShader::Tinted]->registerBatchedShader(*_precompiledShaders[(int32_t)PrecompiledShader::BatchedTinted]);
+		if (withInstancedSprites) {
+			_precompiledShaders[(int32_t)PrecompiledShader::InstancedTinted] = CompileShader("InstancedTinted", Shader::DefaultVertex::INSTANCED_SPRITES, Shaders::TintedFs);
+			_precompiledShaders[(int32_t)PrecompiledShader::Tinted]->registerInstancedShader(*_precompiledShaders[(int32_t)PrecompiledShader::InstancedTinted]);
+		}
 
 		_precompiledShaders[(int32_t)PrecompiledShader::Outline] = CompileShader("Outline", Shader::DefaultVertex::SPRITE, Shaders::OutlineFs);
 		_precompiledShaders[(int32_t)PrecompiledShader::BatchedOutline] = CompileShader("BatchedOutline", Shader::DefaultVertex::BATCHED_SPRITES, Shaders::OutlineFs, Shader::Introspection::NoUniformsInBlocks);
 		_precompiledShaders[(int32_t)PrecompiledShader::Outline]->registerBatchedShader(*_precompiledShaders[(int32_t)PrecompiledShader::BatchedOutline]);
+		if (withInstancedSprites) {
+			_precompiledShaders[(int32_t)PrecompiledShader::InstancedOutline] = CompileShader("InstancedOutline", Shader::DefaultVertex::INSTANCED_SPRITES, Shaders::OutlineFs);
+			_precompiledShaders[(int32_t)PrecompiledShader::Outline]->registerInstancedShader(*_precompiledShaders[(int32_t)PrecompiledShader::InstancedOutline]);
+		}
 
 		_precompiledShaders[(int32_t)PrecompiledShader::WhiteMask] = CompileShader("WhiteMask", Shader::DefaultVertex::SPRITE, Shaders::WhiteMaskFs);
 		_precompiledShaders[(int32_t)PrecompiledShader::BatchedWhiteMask] = CompileShader("BatchedWhiteMask", Shader::DefaultVertex::BATCHED_SPRITES, Shaders::WhiteMaskFs, Shader::Introspection::NoUniformsInBlocks);
 		_precompiledShaders[(int32_t)PrecompiledShader::WhiteMask]->registerBatchedShader(*_precompiledShaders[(int32_t)PrecompiledShader::BatchedWhiteMask]);
+		if (withInstancedSprites) {
+			_precompiledShaders[(int32_t)PrecompiledShader::InstancedWhiteMask] = CompileShader("InstancedWhiteMask", Shader::DefaultVertex::INSTANCED_SPRITES, Shaders::WhiteMaskFs);
+			_precompiledShaders[(int32_t)PrecompiledShader::WhiteMask]->registerInstancedShader(*_precompiledShaders[(int32_t)PrecompiledShader::InstancedWhiteMask]);
+		}
 
 		_precompiledShaders[(int32_t)PrecompiledShader::PartialWhiteMask] = CompileShader("PartialWhiteMask", Shader::DefaultVertex::SPRITE, Shaders::PartialWhiteMaskFs);
 		_precompiledShaders[(int32_t)PrecompiledShader::BatchedPartialWhiteMask] = CompileShader("BatchedPartialWhiteMask", Shader::DefaultVertex::BATCHED_SPRITES, Shaders::PartialWhiteMaskFs, Shader::Introspection::NoUniformsInBlocks);
 		_precompiledShaders[(int32_t)PrecompiledShader::PartialWhiteMask]->registerBatchedShader(*_precompiledShaders[(int32_t)PrecompiledShader::BatchedPartialWhiteMask]);
+		if (withInstancedSprites) {
+			_precompiledShaders[(int32_t)PrecompiledShader::InstancedPartialWhiteMask] = CompileShader("InstancedPartialWhiteMask", Shader::DefaultVertex::INSTANCED_SPRITES, Shaders::PartialWhiteMaskFs);
+			_precompiledShaders[(int32_t)PrecompiledShader::PartialWhiteMask]->registerInstancedShader(*_precompiledShaders[(int32_t)PrecompiledShader::InstancedPartialWhiteMask]);
+		}
 
 		_precompiledShaders[(int32_t)PrecompiledShader::FrozenMask] = CompileShader("FrozenMask", Shader::DefaultVertex::SPRITE, Shaders::FrozenMaskFs);
 		_precompiledShaders[(int32_t)PrecompiledShader::BatchedFrozenMask] = CompileShader("BatchedFrozenMask", Shader::DefaultVertex::BATCHED_SPRITES, Shaders::FrozenMaskFs, Shader::Introspection::NoUniformsInBlocks);
 		_precompiledShaders[(int32_t)PrecompiledShader::FrozenMask]->registerBatchedShader(*_precompiledShaders[(int32_t)PrecompiledShader::BatchedFrozenMask]);
+		if (withInstancedSprites) {
+			_precompiledShaders[(int32_t)PrecompiledShader::InstancedFrozenMask] = CompileShader("InstancedFrozenMask", Shader::DefaultVertex::INSTANCED_SPRITES, Shaders::FrozenMaskFs);
+			_precompiledShaders[(int32_t)PrecompiledShader::FrozenMask]->registerInstancedShader(*_precompiledShaders[(int32_t)PrecompiledShader::InstancedFrozenMask]);
+		}
+
+		_precompiledShaders[(int32_t)PrecompiledShader::Indexed] = CompileShader("Indexed", Shader::DefaultVertex::SPRITE, Shaders::IndexedFs);
+		_precompiledShaders[(int32_t)PrecompiledShader::BatchedIndexed] = CompileShader("BatchedIndexed", Shader::DefaultVertex::BATCHED_SPRITES, Shaders::IndexedFs, Shader::Introspection::NoUniformsInBlocks);
+		_precompiledShaders[(int32_t)PrecompiledShader::Indexed]->registerBatchedShader(*_precompiledShaders[(int32_t)PrecompiledShader::BatchedIndexed]);
+		if (withInstancedSprites) {
+			_precompiledShaders[(int32_t)PrecompiledShader::InstancedIndexed] = CompileShader("InstancedIndexed", Shader::DefaultVertex::INSTANCED_SPRITES, Shaders::IndexedFs);
+			_precompiledShaders[(int32_t)PrecompiledShader::Indexed]->registerInstancedShader(*_precompiledShaders[(int32_t)PrecompiledShader::InstancedIndexed]);
+		}
+
+		_precompiledShaders[(int32_t)PrecompiledShader::IndexedOutline] = CompileShader("IndexedOutline", Shader::DefaultVertex::SPRITE, Shaders::IndexedOutlineFs);
+		_precompiledShaders[(int32_t)PrecompiledShader::BatchedIndexedOutline] = CompileShader("BatchedIndexedOutline", Shader::DefaultVertex::BATCHED_SPRITES, Shaders::IndexedOutlineFs, Shader::Introspection::NoUniformsInBlocks);
+		_precompiledShaders[(int32_t)PrecompiledShader::IndexedOutline]->registerBatchedShader(*_precompiledShaders[(int32_t)PrecompiledShader::BatchedIndexedOutline]);
+		if (withInstancedSprites) {
+			_precompiledShaders[(int32_t)PrecompiledShader::InstancedIndexedOutline] = CompileShader("InstancedIndexedOutline", Shader::DefaultVertex::INSTANCED_SPRITES, Shaders::IndexedOutlineFs);
+			_precompiledShaders[(int32_t)PrecompiledShader::IndexedOutline]->registerInstancedShader(*_precompiledShaders[(int32_t)PrecompiledShader::InstancedIndexedOutline]);
+		}
+
+		_precompiledShaders[(int32_t)PrecompiledShader::IndexedWhiteMask] = CompileShader("IndexedWhiteMask", Shader::DefaultVertex::SPRITE, Shaders::IndexedWhiteMaskFs);
+		_precompiledShaders[(int32_t)PrecompiledShader::BatchedIndexedWhiteMask] = CompileShader("BatchedIndexedWhiteMask", Shader::DefaultVertex::BATCHED_SPRITES, Shaders::IndexedWhiteMaskFs, Shader::Introspection::NoUniformsInBlocks);
+		_precompiledShaders[(int32_t)PrecompiledShader::IndexedWhiteMask]->registerBatchedShader(*_precompiledShaders[(int32_t)PrecompiledShader::BatchedIndexedWhiteMask]);
+		if (withInstancedSprites) {
+			_precompiledShaders[(int32_t)PrecompiledShader::InstancedIndexedWhiteMask] = CompileShader("InstancedIndexedWhiteMask", Shader::DefaultVertex::INSTANCED_SPRITES, Shaders::IndexedWhiteMaskFs);
+			_precompiledShaders[(int32_t)PrecompiledShader::IndexedWhiteMask]->registerInstancedShader(*_precompiledShaders[(int32_t)PrecompiledShader::InstancedIndexedWhiteMask]);
+		}
+
+		_precompiledShaders[(int32_t)PrecompiledShader::IndexedPartialWhiteMask] = CompileShader("IndexedPartialWhiteMask", Shader::DefaultVertex::SPRITE, Shaders::IndexedPartialWhiteMaskFs);
+		_precompiledShaders[(int32_t)PrecompiledShader::BatchedIndexedPartialWhiteMask] = CompileShader("BatchedIndexedPartialWhiteMask", Shader::DefaultVertex::BATCHED_SPRITES, Shaders::IndexedPartialWhiteMaskFs, Shader::Introspection::NoUniformsInBlocks);
+		_precompiledShaders[(int32_t)PrecompiledShader::IndexedPartialWhiteMask]->registerBatchedShader(*_precompiledShaders[(int32_t)PrecompiledShader::BatchedIndexedPartialWhiteMask]);
+		if (withInstancedSprites) {
+			_precompiledShaders[(int32_t)PrecompiledShader::InstancedIndexedPartialWhiteMask] = CompileShader("InstancedIndexedPartialWhiteMask", Shader::DefaultVertex::INSTANCED_SPRITES, Shaders::IndexedPartialWhiteMaskFs);
+			_precompiledShaders[(int32_t)PrecompiledShader::IndexedPartialWhiteMask]->registerInstancedShader(*_precompiledShaders[(int32_t)PrecompiledShader::InstancedIndexedPartialWhiteMask]);
+		}
+
+		_precompiledShaders[(int32_t)PrecompiledShader::IndexedFrozenMask] = CompileShader("IndexedFrozenMask", Shader::DefaultVertex::SPRITE, Shaders::IndexedFrozenMaskFs);
+		_precompiledShaders[(int32_t)PrecompiledShader::BatchedIndexedFrozenMask] = CompileShader("BatchedIndexedFrozenMask", Shader::DefaultVertex::BATCHED_SPRITES, Shaders::IndexedFrozenMaskFs, Shader::Introspection::NoUniformsInBlocks);
+		_precompiledShaders[(int32_t)PrecompiledShader::IndexedFrozenMask]->registerBatchedShader(*_precompiledShaders[(int32_t)PrecompiledShader::BatchedIndexedFrozenMask]);
+		if (withInstancedSprites) {
+			_precompiledShaders[(int32_t)PrecompiledShader::InstancedIndexedFrozenMask] = CompileShader("InstancedIndexedFrozenMask", Shader::DefaultVertex::INSTANCED_SPRITES, Shaders::IndexedFrozenMaskFs);
+			_precompiledShaders[(int32_t)PrecompiledShader::IndexedFrozenMask]->registerInstancedShader(*_precompiledShaders[(int32_t)PrecompiledShader::InstancedIndexedFrozenMask]);
+		}
 
 		_precompiledShaders[(int32_t)PrecompiledShader::ShieldFire] = CompileShader("ShieldFire", Shaders::ShieldVs, Shaders::ShieldFireFs);
 		_precompiledShaders[(int32_t)PrecompiledShader::BatchedShieldFire] = CompileShader("BatchedShieldFire", Shaders::BatchedShieldVs, Shaders::ShieldFireFs, Shader::Introspection::NoUniformsInBlocks);
@@ -1332,6 +2156,52 @@ namespace Jazz2
 		}
 	}
 
+	void ContentResolver::UpdatePaletteTexture()
+	{
+		if (_paletteTexture == nullptr) {
+			// Only the rows that can be addressed by indexed sprites are uploaded
+			_paletteTexture = std::make_unique<Texture>("Palettes", Texture::Format::RGBA8, ColorsPerPalette, IndexedPaletteCount);
+			_paletteTexture->setMinFiltering(SamplerFilter::Nearest);
+			_paletteTexture->setMagFiltering(SamplerFilter::Nearest);
+		}
+		_paletteTexture->loadFromTexels((unsigned char*)_palettes, 0, 0, ColorsPerPalette, IndexedPaletteCount);
+	}
+
+	bool ContentResolver::ApplySpriteShader(Material& material, bool indexed)
+	{
+		bool shaderChanged = (indexed
+			? material.setShader(_precompiledShaders[(int32_t)PrecompiledShader::Indexed].get())
+			: material.setShaderProgramType(Material::ShaderProgramType::SPRITE));
+		if (shaderChanged) {
+			material.reserveUniformsDataMemory();
+
+			GLUniformCache* textureUniform = material.uniform(Material::TextureUniformName);
+			if (textureUniform && textureUniform->intValue(0) != 0) {
+				textureUniform->setIntValue(0); // GL_TEXTURE0
+			}
+		}
+
+		if (indexed) {
+			BindPaletteTexture(material);
+		} else {
+			material.setTexture(1, nullptr);
+		}
+		return shaderChanged;
+	}
+
+	void ContentResolver::BindPaletteTexture(Material& material)
+	{
+		if (_paletteTexture == nullptr) {
+			UpdatePaletteTexture();
+		}
+
+		GLUniformCache* paletteUniform = material.uniform(PaletteUniformName);
+		if (paletteUniform && paletteUniform->intValue(0) != 1) {
+			paletteUniform->setIntValue(1); // GL_TEXTURE1
+		}
+		material.setTexture(1, *_paletteTexture);
+	}
+
 #if defined(DEATH_DEBUG)
 	void ContentResolver::MigrateGraphics(const StringView& path)
 	{
@@ -1340,7 +2210,7 @@ namespace Jazz2
 			return;
 		}
 
-		auto s = fs::Open(fs::CombinePath({ GetContentPath(), "Animations"_s, path + ".res"_s }), FileAccessMode::Read);
+		auto s = fs::Open(fs::CombinePath({ GetContentPath(), "Animations"_s, path + ".res"_s }), FileAccessMode::Read | FileAccessMode::MemoryMapped);
 		auto fileSize = s->GetSize();
 		if (fileSize < 4 || fileSize > 64 * 1024 * 1024) {
 			// 64 MB file size limit, also if not found try to use cache
@@ -4,6 +4,8 @@
 #include "AnimState.h"
 #include "GameDifficulty.h"
 #include "WeaponType.h"
+#include "PakFile.h"
+#include "SpriteAtlas.h"
 #include "UI/Font.h"
 
 #include "Audio/AudioBuffer.h"
@@ -14,12 +16,17 @@
 #include "Graphics/Viewport.h"
 #include "Base/HashMap.h"
 
+#include <Containers/ArrayView.h>
 #include <Containers/Pair.h>
 #include <Containers/SmallVector.h>
 #include <Containers/StringView.h>
 #include <IO/FileSystem.h>
 #include <IO/Stream.h>
 
+#if defined(WITH_THREADS)
+#	include "Threading/ThreadSync.h"
+#endif
+
 using namespace Death::Containers;
 using namespace Death::Containers::Literals;
 using namespace Death::IO;
@@ -48,7 +55,11 @@ namespace Jazz2
 	enum class GenericGraphicResourceFlags {
 		None = 0x00,
 
-		Referenced = 0x01
+		Referenced = 0x01,
+		// Texture is a shared page of the sprite atlas, the sheet occupies only TextureRect
+		Packed = 0x02,
+		// Texture contains palette indices instead of colors, so it has to be drawn with palette lookup
+		Indexed = 0x04
 	};
 
 	DEFINE_ENUM_OPERATORS(GenericGraphicResourceFlags);
@@ -56,12 +67,20 @@ namespace Jazz2
 	class GenericGraphicResource
 	{
 	public:
+		static constexpr uint8_t AlphaThreshold = 40;
+
 		GenericGraphicResourceFlags Flags;
 		//GenericGraphicResourceAsyncFinalize AsyncFinalize;
 
-		std::unique_ptr<Texture> TextureDiffuse;
+		// Texture can be shared with other resources if it's packed in the sprite atlas
+		std::shared_ptr<Texture> TextureDiffuse;
 		std::unique_ptr<Texture> TextureNormal;
+		Recti TextureRect;
 		std::unique_ptr<uint8_t[]> Mask;
+		// 1 bit per pixel (above AlphaThreshold) for each frame, rows are padded to 64 bits, mirrored copy is used for actors facing left
+		std::unique_ptr<uint64_t[]> CollisionMask;
+		std::unique_ptr<uint64_t[]> CollisionMaskMirrored;
+		int32_t CollisionMaskStride = 0;
 		Vector2i FrameDimensions;
 		Vector2i FrameConfiguration;
 		float AnimDuration;
@@ -69,6 +88,29 @@ namespace Jazz2
 		Vector2i Hotspot;
 		Vector2i Coldspot;
 		Vector2i Gunspot;
+
+		/** @brief Converts texture coordinates relative to the sprite sheet to coordinates in @ref TextureDiffuse */
+		Vector4f RemapTexCoords(const Vector4f& texCoords) const {
+			Vector2i texSize = TextureDiffuse->size();
+			return Vector4f(texCoords.X * TextureRect.W / texSize.X, (TextureRect.X + texCoords.Y * TextureRect.W) / texSize.X,
+				texCoords.Z * TextureRect.H / texSize.Y, (TextureRect.Y + texCoords.W * TextureRect.H) / texSize.Y);
+		}
+
+		/** @brief Returns `true` if @ref TextureDiffuse contains palette indices, see @ref ContentResolver::ApplySpriteShader() */
+		bool IsIndexed() const {
+			return ((Flags & GenericGraphicResourceFlags::Indexed) == GenericGraphicResourceFlags::Indexed);
+		}
+
+		/** @brief Returns top-left corner of the frame in @ref TextureDiffuse */
+		Vector2i GetFrameTexturePosition(int32_t frame) const {
+			return Vector2i(TextureRect.X + (frame % FrameConfiguration.X) * FrameDimensions.X, TextureRect.Y + (frame / FrameConfiguration.X) * FrameDimensions.Y);
+		}
+
+		/** @brief Returns collision mask of the frame, or `nullptr` if the graphics has no mask */
+		const uint64_t* GetCollisionMask(int32_t frame, bool mirrored) const {
+			const uint64_t* mask = (mirrored ? CollisionMaskMirrored : CollisionMask).get();
+			return (mask != nullptr ? mask + (size_t)frame * FrameDimensions.Y * CollisionMaskStride : nullptr);
+		}
 	};
 
 	class GraphicResource
@@ -95,10 +137,30 @@ namespace Jazz2
 		}
 	};
 
+	enum class GenericSoundResourceFlags {
+		None = 0x00,
+
+		Referenced = 0x01
+	};
+
+	DEFINE_ENUM_OPERATORS(GenericSoundResourceFlags);
+
+	class GenericSoundResource
+	{
+	public:
+		GenericSoundResourceFlags Flags;
+		AudioBuffer Buffer;
+	};
+
 	class SoundResource
 	{
 	public:
-		SmallVector<std::unique_ptr<AudioBuffer>, 1> Buffers;
+		// Buffers are shared by all metadata which reference the same file
+		SmallVector<GenericSoundResource*, 1> Buffers;
+		// Sounds with higher priority take audio sources from less important ones
+		int32_t Priority;
+		// Maximum number of simultaneously playing instances, zero means the default limit
+		int32_t MaxInstances;
 	};
 
 	enum class MetadataFlags {
@@ -113,16 +175,29 @@ namespace Jazz2
 	class Metadata
 	{
 	public:
+		struct StateIndexEntry {
+			AnimState State;
+			const String* Identifier;
+			GraphicResource* Resource;
+		};
+
 		MetadataFlags Flags;
 
 		HashMap<String, GraphicResource> Graphics;
 		HashMap<String, SoundResource> Sounds;
 		Vector2i BoundingBox;
+		// All states of all graphics sorted by state, so lookup by state doesn't have to scan the whole map
+		SmallVector<StateIndexEntry, 0> StateIndex;
 
 		Metadata()
 			: Flags(MetadataFlags::None)
 		{
 		}
+
+		/** @brief Rebuilds @ref StateIndex, it has to be called after @ref Graphics are modified */
+		void BuildStateIndex();
+		/** @brief Returns all graphics with specified state in the same order as they are enumerated in @ref Graphics */
+		ArrayView<const StateIndexEntry> FindByState(AnimState state) const;
 	};
 
 	enum class TileDestructType {
@@ -183,19 +258,43 @@ namespace Jazz2
 
 		TexturedBackground,
 		TexturedBackgroundCircle,
+		TileLayer,
+		TileLayerTinted,
 
 		Colorized,
 		BatchedColorized,
+		InstancedColorized,
 		Tinted,
 		BatchedTinted,
+		InstancedTinted,
 		Outline,
 		BatchedOutline,
+		InstancedOutline,
 		WhiteMask,
 		BatchedWhiteMask,
+		InstancedWhiteMask,
 		PartialWhiteMask,
 		BatchedPartialWhiteMask,
+		InstancedPartialWhiteMask,
 		FrozenMask,
 		BatchedFrozenMask,
+		InstancedFrozenMask,
+
+		Indexed,
+		BatchedIndexed,
+		InstancedIndexed,
+		IndexedOutline,
+		BatchedIndexedOutline,
+		InstancedIndexedOutline,
+		IndexedWhiteMask,
+		BatchedIndexedWhiteMask,
+		InstancedIndexedWhiteMask,
+		IndexedPartialWhiteMask,
+		BatchedIndexedPartialWhiteMask,
+		InstancedIndexedPartialWhiteMask,
+		IndexedFrozenMask,
+		BatchedIndexedFrozenMask,
+		InstancedIndexedFrozenMask,
 		ShieldFire,
 		BatchedShieldFire,
 		ShieldLightning,
@@ -223,10 +322,14 @@ namespace Jazz2
 		static constexpr uint8_t EpisodeFile = 2;
 		static constexpr uint8_t CacheIndexFile = 3;
 		static constexpr uint8_t ConfigFile = 4;
+		static constexpr uint8_t SourceIndexFile = 5;
 
 		static constexpr int32_t PaletteCount = 256;
 		static constexpr int32_t ColorsPerPalette = 256;
+		/** @brief Number of palette rows that can be addressed by indexed sprites */
+		static constexpr int32_t IndexedPaletteCount = 4;
 		static constexpr int32_t InvalidValue = INT_MAX;
+		static constexpr char PaletteUniformName[] = "uPalette";
 
 		~ContentResolver();
 		
@@ -235,9 +338,16 @@ namespace Jazz2
 		void BeginLoading();
 		void EndLoading();
 
+		/** @brief Loads metadata with all its resources on worker threads, it's loaded synchronously if threading is not available */
 		void PreloadMetadataAsync(const StringView& path);
+		/** @brief Finalizes preloaded resources on the main thread until the time budget (in milliseconds) is exhausted, returns `true` if nothing is pending */
+		bool FinalizePreloadedResources(float timeBudget);
+		/** @brief Waits for all resources that are being preloaded and finalizes them at once */
+		void FinalizePreloadedResources();
 		Metadata* RequestMetadata(const StringView& path);
-		GenericGraphicResource* RequestGraphics(const StringView& path, uint16_t paletteOffset);
+		GenericGraphicResource* RequestGraphics(const StringView& path, uint16_t paletteOffset, bool standalone = false);
+		/** @brief Decodes pixels of all loose `.aura` files in "Content" and "Cache" directories and logs the time spent */
+		void BenchmarkImages();
 
 		std::unique_ptr<Tiles::TileSet> RequestTileSet(const StringView& path, uint16_t captionTileId, bool applyPalette, const uint8_t* paletteRemapping = nullptr);
 		bool LevelExists(const StringView& episodeName, const StringView& levelName);
@@ -252,6 +362,11 @@ namespace Jazz2
 		void CompileShaders();
 		static std::unique_ptr<Texture> GetNoiseTexture();
 
+		/** @brief Sets the default sprite shader to a material, palette lookup variant is used for indexed textures, returns `true` if the shader was changed */
+		bool ApplySpriteShader(Material& material, bool indexed);
+		/** @brief Binds the palette texture to a material with palette lookup shader, it has to be called again after uniforms are reserved */
+		void BindPaletteTexture(Material& material);
+
 		const uint32_t* GetPalettes() const {
 			return _palettes;
 		}
@@ -299,20 +414,101 @@ namespace Jazz2
 		static ContentResolver& Get();
 
 	private:
+		struct PendingGraphicResource {
+			String Name;
+			String Path;
+			uint16_t PaletteOffset;
+			bool Standalone;
+			bool HasFrameCount;
+			bool HasFrameRate;
+			GraphicResource Resource;
+		};
+
+		struct PendingSoundResource {
+			String Name;
+			SmallVector<String, 1> Paths;
+			int32_t Priority;
+			int32_t MaxInstances;
+		};
+
+		/** @brief Decoded graphics without texture, which can be created only on the main thread */
+		struct PreloadedGraphics {
+			String Path;
+			uint16_t PaletteOffset;
+			bool LinearSampling;
+			// Texture is sampled outside of frame rectangles, so it can't be packed into the sprite atlas
+			bool Standalone;
+			String TextureName;
+			std::unique_ptr<uint32_t[]> Pixels;
+			std::unique_ptr<GenericGraphicResource> Resource;
+		};
+
+		/** @brief Decoded samples of a sound, which are uploaded to an audio buffer on the main thread */
+		struct PreloadedSound {
+			String Path;
+			AudioBuffer::Format Format;
+			int32_t Frequency;
+			uint32_t Size;
+			std::unique_ptr<uint8_t[]> Samples;
+		};
+
+		/** @brief Parsed metadata, all resources are resolved in @ref FinalizeMetadata() */
+		struct PendingMetadata {
+			String Path;
+			Vector2i BoundingBox;
+			SmallVector<PendingGraphicResource, 0> Graphics;
+			SmallVector<PendingSoundResource, 0> Sounds;
+			SmallVector<PreloadedGraphics, 0> LoadedGraphics;
+			SmallVector<PreloadedSound, 0> LoadedSounds;
+			bool IsValid;
+			bool IsCompleted;
+
+			PendingMetadata()
+				: BoundingBox(InvalidValue, InvalidValue), IsValid(false), IsCompleted(false)
+			{
+			}
+		};
+
+#if defined(WITH_THREADS)
+		class PreloadCommand;
+#endif
+
 		ContentResolver();
 
 		ContentResolver(const ContentResolver&) = delete;
 		ContentResolver& operator=(const ContentResolver&) = delete;
 
 		void InitializePaths();
-
-		GenericGraphicResource* RequestGraphicsAura(const StringView& path, uint16_t paletteOffset);
-		static void ReadImageFromFile(std::unique_ptr<Stream>& s, uint8_t* data, int32_t width, int32_t height, int32_t channelCount);
+		void MountPakFiles();
+
+		bool ParseMetadata(PendingMetadata& pending);
+		void PreloadMetadata(PendingMetadata& pending);
+		Metadata* FinalizeMetadata(PendingMetadata& pending);
+		static PreloadedGraphics* FindPreloadedGraphics(PendingMetadata& pending, const StringView& path, uint16_t paletteOffset);
+		void WaitForPreloading();
+		void CancelPreloading();
+
+		GenericGraphicResource* RequestGraphicsAura(const StringView& path, uint16_t paletteOffset, bool standalone);
+		bool LoadGraphicsAura(const StringView& path, uint16_t paletteOffset, PreloadedGraphics& result);
+		GenericGraphicResource* FinalizeGraphics(PreloadedGraphics& preloaded);
+		/** @brief Moves sheets which outlived their level from mostly released pages of the sprite atlas to persistent pages */
+		void RepackSpriteAtlas();
+		void LogSpriteAtlasStatistics();
+		void CountUsedSheets();
+		GenericSoundResource* RequestSound(const StringView& path, PreloadedSound* preloaded);
+		static bool LoadSound(const StringView& path, PreloadedSound& result);
+		static uint16_t GetIndexedPixel(uint32_t pixel, uint16_t paletteOffset);
+		static void ConvertToIndexedPixels(uint32_t* pixels, int32_t count, uint16_t paletteOffset);
+		static void BuildCollisionMask(GenericGraphicResource& graphics);
+		static bool ReadImageFromFile(std::unique_ptr<Stream>& s, uint8_t* data, int32_t width, int32_t height, int32_t channelCount);
+		static void DecodeImage(const uint8_t* src, int32_t srcLength, uint8_t* data, int32_t width, int32_t height, int32_t channelCount);
 		
 		std::unique_ptr<Shader> CompileShader(const char* shaderName, Shader::DefaultVertex vertex, const char* fragment, Shader::Introspection introspection = Shader::Introspection::Enabled);
 		std::unique_ptr<Shader> CompileShader(const char* shaderName, const char* vertex, const char* fragment, Shader::Introspection introspection = Shader::Introspection::Enabled);
 		
+		void ApplyPalette(const uint32_t* palette);
 		void RecreateGemPalettes();
+		void UpdatePaletteTexture();
 #if defined(DEATH_DEBUG)
 		void MigrateGraphics(const StringView& path);
 #endif
@@ -321,8 +517,23 @@ namespace Jazz2
 		uint32_t _palettes[PaletteCount * ColorsPerPalette];
 		HashMap<String, std::unique_ptr<Metadata>> _cachedMetadata;
 		HashMap<Pair<String, uint16_t>, std::unique_ptr<GenericGraphicResource>> _cachedGraphics;
+		HashMap<String, std::unique_ptr<GenericSoundResource>> _cachedSounds;
+		uint64_t _soundBytesSaved;
+		uint32_t _soundBuffersSaved;
 		std::unique_ptr<UI::Font> _fonts[(int32_t)FontType::Count];
 		std::unique_ptr<Shader> _precompiledShaders[(int32_t)PrecompiledShader::Count];
+		// All palettes in one texture, indexed sprites are colorized by shaders, so changing the palette doesn't require reloading of any sprite
+		std::unique_ptr<Texture> _paletteTexture;
+		std::unique_ptr<PakFile> _animationsPak;
+		SpriteAtlas _spriteAtlas;
+
+#if defined(WITH_THREADS)
+		// Accessed only from the main thread, workers fill pending metadata until it's marked as completed
+		HashMap<String, std::unique_ptr<PendingMetadata>> _preloadingMetadata;
+		Mutex _preloadMutex;
+		CondVariable _preloadCV;
+		int32_t _preloadPendingCount;
+#endif
 
 #if defined(DEATH_TARGET_UNIX) || defined(DEATH_TARGET_WINDOWS_RT)
 		String _contentPath;
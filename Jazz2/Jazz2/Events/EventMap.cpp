@@ -8,8 +8,11 @@
 namespace Jazz2::Events
 {
 	EventMap::EventMap(ILevelHandler* levelHandler, Vector2i layoutSize, PitType pitType)
-		: _levelHandler(levelHandler), _layoutSize(layoutSize), _checkpointCreated(false), _pitType(pitType)
+		: _levelHandler(levelHandler), _layoutSize(layoutSize), _activatedArea(0, 0, 0, 0), _checkpointCreated(false), _pitType(pitType)
 	{
+		_chunkCount = Vector2i((layoutSize.X + ChunkSize - 1) / ChunkSize, (layoutSize.Y + ChunkSize - 1) / ChunkSize);
+		_chunks.resize(_chunkCount.X * _chunkCount.Y);
+		_chunksForRollback.resize(_chunkCount.X * _chunkCount.Y);
 	}
 
 	Vector2f EventMap::GetSpawnPosition(PlayerType type)
@@ -39,37 +42,60 @@ namespace Jazz2::Events
 
 	void EventMap::CreateCheckpointForRollback()
 	{
-		std::memcpy(_eventLayoutForRollback.data(), _eventLayout.data(), _eventLayout.size() * sizeof(EventTile));
+		// Chunks are only shared, they will be copied when they are modified
+		_chunksForRollback = _chunks;
 	}
 
 	void EventMap::RollbackToCheckpoint()
 	{
-		for (std::int32_t y = 0; y < _layoutSize.Y; y++) {
-			for (std::int32_t x = 0; x < _layoutSize.X; x++) {
-				std::int32_t tileID = y * _layoutSize.X + x;
-				EventTile& tile = _eventLayout[tileID];
-				EventTile& tilePrev = _eventLayoutForRollback[tileID];
+		for (std::int32_t i = 0; i < (std::int32_t)_chunks.size(); i++) {
+			// Chunks that were not modified since the checkpoint are still shared
+			if (_chunks[i] == _chunksForRollback[i]) {
+				continue;
+			}
 
-				bool respawn = (tilePrev.IsEventActive && !tile.IsEventActive);
+			// Rollback chunk
+			std::shared_ptr<EventChunk> current = std::move(_chunks[i]);
+			std::shared_ptr<EventChunk> chunkPrev = _chunksForRollback[i];
+			_chunks[i] = chunkPrev;
+			if (chunkPrev == nullptr) {
+				continue;
+			}
 
-				// Rollback tile
-				tile = tilePrev;
+			std::int32_t cx = (i % _chunkCount.X) * ChunkSize;
+			std::int32_t cy = (i / _chunkCount.X) * ChunkSize;
 
-				if (respawn && tile.Event != EventType::Empty) {
-					tile.IsEventActive = true;
+			for (auto& entry : chunkPrev->Entries) {
+				EventTile& tile = entry.Tile;
+				if (!tile.IsEventActive || tile.Event == EventType::Empty) {
+					continue;
+				}
 
-					if (tile.Event == EventType::AreaWeather) {
-						_levelHandler->SetWeather((WeatherType)tile.EventParams[0], tile.EventParams[1]);
-					} else if (tile.Event != EventType::Generator) {
-						Actors::ActorState flags = Actors::ActorState::IsCreatedFromEventMap | tile.EventFlags;
-						std::shared_ptr<Actors::ActorBase> actor = _levelHandler->EventSpawner()->SpawnEvent(tile.Event, tile.EventParams, flags, x, y, ILevelHandler::MainPlaneZ);
-						if (actor != nullptr) {
-							_levelHandler->AddActor(actor);
-						}
+				if (current != nullptr) {
+					std::int32_t idx = FindEntryIndex(*current, entry.Index);
+					if (idx < (std::int32_t)current->Entries.size() && current->Entries[idx].Index == entry.Index && current->Entries[idx].Tile.IsEventActive) {
+						continue;
+					}
+				}
+
+				std::int32_t x = cx + entry.Index % ChunkSize;
+				std::int32_t y = cy + entry.Index / ChunkSize;
+
+				if (tile.Event == EventType::AreaWeather) {
+					_levelHandler->SetWeather((WeatherType)tile.EventParams[0], tile.EventParams[1]);
+				} else if (tile.Event != EventType::Generator) {
+					Actors::ActorState flags = Actors::ActorState::IsCreatedFromEventMap | tile.EventFlags;
+					std::shared_ptr<Actors::ActorBase> actor = _levelHandler->EventSpawner()->SpawnEvent(tile.Event, tile.EventParams, flags, x, y, ILevelHandler::MainPlaneZ);
+					if (actor != nullptr) {
+						_levelHandler->AddActor(actor);
 					}
 				}
 			}
 		}
+
+		// Inactive tiles could be restored anywhere, so the next activation has to scan the whole area again
+		_activatedArea = Recti(0, 0, 0, 0);
+		_pendingTiles.clear();
 	}
 
 	void EventMap::StoreTileEvent(std::int32_t x, std::int32_t y, EventType eventType, Actors::ActorState eventFlags, std::uint8_t* tileParams)
@@ -78,33 +104,55 @@ namespace Jazz2::Events
 			return;
 		}
 
-		EventTile& previousEvent = _eventLayout[x + y * _layoutSize.X];
+		const EventTile* previousEvent = FindTile(x, y);
+		if (previousEvent == nullptr && eventType == EventType::Empty) {
+			return;
+		}
 
 		EventTile newEvent = { };
 		newEvent.Event = eventType,
 		newEvent.EventFlags = eventFlags,
-		newEvent.IsEventActive = (previousEvent.Event == eventType && previousEvent.IsEventActive);
+		newEvent.IsEventActive = (previousEvent != nullptr && previousEvent->Event == eventType && previousEvent->IsEventActive);
 
 		// Store event parameters
 		if (tileParams != nullptr) {
 			std::memcpy(newEvent.EventParams, tileParams, sizeof(newEvent.EventParams));
 		}
 
-		previousEvent = newEvent;
+		std::uint16_t index = (std::uint16_t)((y % ChunkSize) * ChunkSize + (x % ChunkSize));
+		EventChunk& chunk = GetChunkForWrite((y / ChunkSize) * _chunkCount.X + (x / ChunkSize));
+		std::int32_t idx = FindEntryIndex(chunk, index);
+		if (idx < (std::int32_t)chunk.Entries.size() && chunk.Entries[idx].Index == index) {
+			if (eventType == EventType::Empty) {
+				// Empty tiles are not stored at all
+				chunk.Entries.erase(chunk.Entries.begin() + idx);
+			} else {
+				chunk.Entries[idx].Tile = newEvent;
+			}
+		} else {
+			chunk.Entries.insert(chunk.Entries.begin() + idx, ChunkEntry { index, newEvent });
+		}
+
+		if (!newEvent.IsEventActive && eventType != EventType::Empty) {
+			InvalidateTile(x, y);
+		}
 	}
 
 	void EventMap::PreloadEventsAsync()
 	{
 		auto eventSpawner = _levelHandler->EventSpawner();
 
-		// TODO
-		//ContentResolver::Get().SuspendAsync();
-
 		// Preload all events
-		for (auto& tile : _eventLayout) {
-			// TODO: Exclude also some modifiers here ?
-			if (tile.Event != EventType::Empty && tile.Event != EventType::Generator && tile.Event != EventType::AreaWeather) {
-				eventSpawner->PreloadEvent(tile.Event, tile.EventParams);
+		for (auto& chunk : _chunks) {
+			if (chunk == nullptr) {
+				continue;
+			}
+			for (auto& entry : chunk->Entries) {
+				// TODO: Exclude also some modifiers here ?
+				EventTile& tile = entry.Tile;
+				if (tile.Event != EventType::Empty && tile.Event != EventType::Generator && tile.Event != EventType::AreaWeather) {
+					eventSpawner->PreloadEvent(tile.Event, tile.EventParams);
+				}
 			}
 		}
 
@@ -114,13 +162,16 @@ namespace Jazz2::Events
 		}
 
 		// Don't wait for finalization of resources, it will be done in a few next frames
-		//ContentResolver::Get().ResumeAsync();
 	}
 
 	void EventMap::ProcessGenerators(float timeMult)
 	{
 		for (auto& generator : _generators) {
-			if (!_eventLayout[generator.EventPos].IsEventActive) {
+			std::int32_t x = generator.EventPos % _layoutSize.X;
+			std::int32_t y = generator.EventPos / _layoutSize.X;
+			const EventTile* tile = FindTile(x, y);
+
+			if (tile == nullptr || !tile->IsEventActive) {
 				// Generator is inactive (and recharging)
 				generator.TimeLeft -= timeMult;
 			} else if (generator.SpawnedActor == nullptr || generator.SpawnedActor->GetHealth() <= 0) {
@@ -128,9 +179,6 @@ namespace Jazz2::Events
 					// Generator is active and is ready to spawn new actor
 					generator.TimeLeft = generator.Delay * FrameTimer::FramesPerSecond;
 
-					std::int32_t x = generator.EventPos % _layoutSize.X;
-					std::int32_t y = generator.EventPos / _layoutSize.X;
-
 					generator.SpawnedActor = _levelHandler->EventSpawner()->SpawnEvent(generator.Event,
 						generator.EventParams, Actors::ActorState::IsFromGenerator, x, y, ILevelHandler::SpritePlaneZ);
 					if (generator.SpawnedActor != nullptr) {
@@ -159,40 +207,181 @@ namespace Jazz2::Events
 		std::int32_t y1 = std::max(0, ty1);
 		std::int32_t y2 = std::min(_layoutSize.Y - 1, ty2);
 
-		for (std::int32_t x = x1; x <= x2; x++) {
-			for (std::int32_t y = y1; y <= y2; y++) {
-				auto& tile = _eventLayout[x + y * _layoutSize.X];
-				if (!tile.IsEventActive && tile.Event != EventType::Empty) {
-					tile.IsEventActive = true;
-
-					if (tile.Event == EventType::AreaWeather) {
-						_levelHandler->SetWeather((WeatherType)tile.EventParams[0], tile.EventParams[1]);
-					} else if (tile.Event != EventType::Generator) {
-						Actors::ActorState flags = Actors::ActorState::IsCreatedFromEventMap | tile.EventFlags;
-						if (allowAsync) {
-							flags |= Actors::ActorState::Async;
-						}
+		std::int32_t px1 = _activatedArea.X;
+		std::int32_t py1 = _activatedArea.Y;
+		std::int32_t px2 = _activatedArea.X + _activatedArea.W - 1;
+		std::int32_t py2 = _activatedArea.Y + _activatedArea.H - 1;
 
-						std::shared_ptr<Actors::ActorBase> actor = _levelHandler->EventSpawner()->SpawnEvent(tile.Event, tile.EventParams, flags, x, y, ILevelHandler::SpritePlaneZ);
-						if (actor != nullptr) {
-							_levelHandler->AddActor(actor);
-						}
-					}
+		// Spawned actors can invalidate other tiles, so the list is detached before anything is activated,
+		// tiles invalidated in the meantime are then processed in the next call
+		SmallVector<std::int32_t, 0> pendingTiles = std::move(_pendingTiles);
+		_pendingTiles.clear();
+
+		if (_activatedArea.W <= 0 || _activatedArea.H <= 0 || x1 > px2 || x2 < px1 || y1 > py2 || y2 < py1) {
+			// Nothing was activated yet or the camera jumped too far, scan the whole area
+			ActivateEventsInArea(x1, y1, x2, y2, allowAsync);
+		} else {
+			// Tiles inside the previous area are already active, so only columns and rows entering the area are scanned
+			if (x1 < px1) {
+				ActivateEventsInArea(x1, y1, px1 - 1, y2, allowAsync);
+			}
+			if (x2 > px2) {
+				ActivateEventsInArea(px2 + 1, y1, x2, y2, allowAsync);
+			}
+			std::int32_t cx1 = std::max(x1, px1);
+			std::int32_t cx2 = std::min(x2, px2);
+			if (y1 < py1) {
+				ActivateEventsInArea(cx1, y1, cx2, py1 - 1, allowAsync);
+			}
+			if (y2 > py2) {
+				ActivateEventsInArea(cx1, py2 + 1, cx2, y2, allowAsync);
+			}
+
+			for (std::int32_t tileID : pendingTiles) {
+				std::int32_t x = tileID % _layoutSize.X;
+				std::int32_t y = tileID / _layoutSize.X;
+				if (x >= x1 && y >= y1 && x <= x2 && y <= y2) {
+					ActivateEventsInArea(x, y, x, y, allowAsync);
 				}
 			}
 		}
 
+		_activatedArea = Recti(x1, y1, x2 - x1 + 1, y2 - y1 + 1);
+
 		if (!_checkpointCreated) {
 			// Create checkpostd::int32_t after first call to ActivateEvents() to avoid duplication of objects that are spawned near player spawn
-			std::memcpy(_eventLayoutForRollback.data(), _eventLayout.data(), _eventLayout.size() * sizeof(EventTile));
+			_chunksForRollback = _chunks;
 			_checkpointCreated = true;
 		}
 	}
 
+	void EventMap::ActivateEventsInArea(std::int32_t x1, std::int32_t y1, std::int32_t x2, std::int32_t y2, bool allowAsync)
+	{
+		if (x1 > x2 || y1 > y2) {
+			return;
+		}
+
+		// Spawned actors can insert or remove entries of any chunk, so tiles to activate are collected first
+		SmallVector<std::int32_t, 0> tilesToActivate;
+		for (std::int32_t cy = y1 / ChunkSize; cy <= y2 / ChunkSize; cy++) {
+			for (std::int32_t cx = x1 / ChunkSize; cx <= x2 / ChunkSize; cx++) {
+				const auto& chunk = _chunks[cy * _chunkCount.X + cx];
+				if (chunk == nullptr) {
+					continue;
+				}
+				for (const ChunkEntry& entry : chunk->Entries) {
+					std::int32_t x = cx * ChunkSize + entry.Index % ChunkSize;
+					std::int32_t y = cy * ChunkSize + entry.Index / ChunkSize;
+					if (x >= x1 && y >= y1 && x <= x2 && y <= y2 && !entry.Tile.IsEventActive && entry.Tile.Event != EventType::Empty) {
+						tilesToActivate.push_back(x + y * _layoutSize.X);
+					}
+				}
+			}
+		}
+
+		for (std::int32_t tileID : tilesToActivate) {
+			std::int32_t x = tileID % _layoutSize.X;
+			std::int32_t y = tileID / _layoutSize.X;
+
+			// The tile could be already changed by an actor spawned in a previous iteration
+			const EventTile* currentTile = FindTile(x, y);
+			if (currentTile == nullptr || currentTile->IsEventActive || currentTile->Event == EventType::Empty) {
+				continue;
+			}
+
+			EventTile* tile = FindTileForWrite(x, y);
+			tile->IsEventActive = true;
+			EventTile spawnTile = *tile;
+
+			if (spawnTile.Event == EventType::AreaWeather) {
+				_levelHandler->SetWeather((WeatherType)spawnTile.EventParams[0], spawnTile.EventParams[1]);
+			} else if (spawnTile.Event != EventType::Generator) {
+				Actors::ActorState flags = Actors::ActorState::IsCreatedFromEventMap | spawnTile.EventFlags;
+				if (allowAsync) {
+					flags |= Actors::ActorState::Async;
+				}
+
+				std::shared_ptr<Actors::ActorBase> actor = _levelHandler->EventSpawner()->SpawnEvent(spawnTile.Event, spawnTile.EventParams, flags, x, y, ILevelHandler::SpritePlaneZ);
+				if (actor != nullptr) {
+					_levelHandler->AddActor(actor);
+				}
+			}
+		}
+	}
+
+	void EventMap::InvalidateTile(std::int32_t x, std::int32_t y)
+	{
+		// Tiles outside of the activated area will be scanned when they enter the area
+		if (x >= _activatedArea.X && y >= _activatedArea.Y && x < _activatedArea.X + _activatedArea.W && y < _activatedArea.Y + _activatedArea.H) {
+			_pendingTiles.push_back(x + y * _layoutSize.X);
+		}
+	}
+
+	const EventMap::EventTile* EventMap::FindTile(std::int32_t x, std::int32_t y) const
+	{
+		if (x < 0 || y < 0 || x >= _layoutSize.X || y >= _layoutSize.Y) {
+			return nullptr;
+		}
+
+		const auto& chunk = _chunks[(y / ChunkSize) * _chunkCount.X + (x / ChunkSize)];
+		if (chunk == nullptr) {
+			return nullptr;
+		}
+
+		std::uint16_t index = (std::uint16_t)((y % ChunkSize) * ChunkSize + (x % ChunkSize));
+		std::int32_t idx = FindEntryIndex(*chunk, index);
+		return (idx < (std::int32_t)chunk->Entries.size() && chunk->Entries[idx].Index == index ? &chunk->Entries[idx].Tile : nullptr);
+	}
+
+	EventMap::EventTile* EventMap::FindTileForWrite(std::int32_t x, std::int32_t y)
+	{
+		if (FindTile(x, y) == nullptr) {
+			return nullptr;
+		}
+
+		EventChunk& chunk = GetChunkForWrite((y / ChunkSize) * _chunkCount.X + (x / ChunkSize));
+		std::uint16_t index = (std::uint16_t)((y % ChunkSize) * ChunkSize + (x % ChunkSize));
+		return &chunk.Entries[FindEntryIndex(chunk, index)].Tile;
+	}
+
+	EventMap::EventChunk& EventMap::GetChunkForWrite(std::int32_t chunkIdx)
+	{
+		auto& chunk = _chunks[chunkIdx];
+		if (chunk == nullptr) {
+			chunk = std::make_shared<EventChunk>();
+		} else if (chunk.use_count() > 1) {
+			// Chunk is shared with the checkpoint, so it has to be copied before it's modified
+			chunk = std::make_shared<EventChunk>(*chunk);
+		}
+		return *chunk;
+	}
+
+	std::int32_t EventMap::FindEntryIndex(const EventChunk& chunk, std::uint16_t index)
+	{
+		// Entries are appended in order during loading, so check the last one first
+		std::int32_t count = (std::int32_t)chunk.Entries.size();
+		if (count == 0 || chunk.Entries[count - 1].Index < index) {
+			return count;
+		}
+
+		std::int32_t first = 0;
+		while (count > 0) {
+			std::int32_t step = count / 2;
+			if (chunk.Entries[first + step].Index < index) {
+				first += step + 1;
+				count -= step + 1;
+			} else {
+				count = step;
+			}
+		}
+		return first;
+	}
+
 	void EventMap::Deactivate(std::int32_t x, std::int32_t y)
 	{
 		if (HasEventByPosition(x, y)) {
-			_eventLayout[x + y * _layoutSize.X].IsEventActive = false;
+			FindTileForWrite(x, y)->IsEventActive = false;
+			InvalidateTile(x, y);
 		}
 	}
 
@@ -200,7 +389,12 @@ namespace Jazz2::Events
 	{
 		// Linked actor was deactivated, but not destroyed
 		// Reset its generator, so it can be respawned immediately
-		std::uint32_t generatorIdx = *(std::uint32_t*)_eventLayout[tx + ty * _layoutSize.X].EventParams;
+		const EventTile* tile = FindTile(tx, ty);
+		if (tile == nullptr) {
+			return;
+		}
+
+		std::uint32_t generatorIdx = *(std::uint32_t*)tile->EventParams;
 		_generators[generatorIdx].TimeLeft = 0.0f;
 		_generators[generatorIdx].SpawnedActor = nullptr;
 	}
@@ -216,16 +410,19 @@ namespace Jazz2::Events
 			return (_pitType == PitType::InstantDeathPit ? EventType::ModifierDeath : EventType::Empty);
 		}
 
-		if (x >= 0 && y >= 0 && y < _layoutSize.Y && x < _layoutSize.X) {
-			*eventParams = _eventLayout[x + y * _layoutSize.X].EventParams;
-			return _eventLayout[x + y * _layoutSize.X].Event;
+		const EventTile* tile = FindTile(x, y);
+		if (tile != nullptr) {
+			// Parameters must not be modified through the pointer, because the chunk can be shared with the checkpoint
+			*eventParams = const_cast<std::uint8_t*>(tile->EventParams);
+			return tile->Event;
 		}
 		return EventType::Empty;
 	}
 
 	bool EventMap::HasEventByPosition(std::int32_t x, std::int32_t y)
 	{
-		return (x >= 0 && y >= 0 && y < _layoutSize.Y && x < _layoutSize.X && _eventLayout[x + y * _layoutSize.X].Event != EventType::Empty);
+		const EventTile* tile = FindTile(x, y);
+		return (tile != nullptr && tile->Event != EventType::Empty);
 	}
 
 	std::int32_t EventMap::GetWarpByPosition(float x, float y)
@@ -265,9 +462,6 @@ namespace Jazz2::Events
 
 	void EventMap::ReadEvents(Stream& s, const std::unique_ptr<Tiles::TileMap>& tileMap, GameDifficulty difficulty)
 	{
-		_eventLayout.resize(_layoutSize.X * _layoutSize.Y);
-		_eventLayoutForRollback.resize(_layoutSize.X * _layoutSize.Y);
-
 		std::uint8_t difficultyBit;
 		switch (difficulty) {
 			case GameDifficulty::Easy:
@@ -4,6 +4,8 @@
 #include "../GameDifficulty.h"
 #include "../PitType.h"
 
+#include <memory>
+
 #include <IO/Stream.h>
 
 namespace Jazz2::Events
@@ -36,6 +38,9 @@ namespace Jazz2::Events
 		void AddSpawnPosition(std::uint8_t typeMask, std::int32_t x, std::int32_t y);
 
 	private:
+		// Events are stored sparsely in square chunks, because most tiles of the layout are empty
+		static constexpr std::int32_t ChunkSize = 32;
+
 		struct EventTile {
 			EventType Event;
 			Actors::ActorState EventFlags;
@@ -43,6 +48,17 @@ namespace Jazz2::Events
 			bool IsEventActive;
 		};
 
+		struct ChunkEntry {
+			// Index of the tile inside the chunk, entries are sorted by it
+			std::uint16_t Index;
+			EventTile Tile;
+		};
+
+		// Chunks are shared with the checkpoint until they are modified (copy-on-write)
+		struct EventChunk {
+			SmallVector<ChunkEntry, 0> Entries;
+		};
+
 		struct GeneratorInfo {
 			std::int32_t EventPos;
 
@@ -67,11 +83,24 @@ namespace Jazz2::Events
 		ILevelHandler* _levelHandler;
 		Vector2i _layoutSize;
 		PitType _pitType;
-		SmallVector<EventTile, 0> _eventLayout;
-		SmallVector<EventTile, 0> _eventLayoutForRollback;
+		Vector2i _chunkCount;
+		SmallVector<std::shared_ptr<EventChunk>, 0> _chunks;
+		SmallVector<std::shared_ptr<EventChunk>, 0> _chunksForRollback;
 		SmallVector<GeneratorInfo, 0> _generators;
 		SmallVector<SpawnPoint, 0> _spawnPoints;
 		SmallVector<WarpTarget, 0> _warpTargets;
+		// Area activated by the last call to ActivateEvents(), only tiles entering the area are scanned next time
+		Recti _activatedArea;
+		// Tiles inside the activated area that were deactivated or changed and have to be checked again
+		SmallVector<std::int32_t, 0> _pendingTiles;
 		bool _checkpointCreated;
+
+		void ActivateEventsInArea(std::int32_t x1, std::int32_t y1, std::int32_t x2, std::int32_t y2, bool allowAsync);
+		void InvalidateTile(std::int32_t x, std::int32_t y);
+		const EventTile* FindTile(std::int32_t x, std::int32_t y) const;
+		EventTile* FindTileForWrite(std::int32_t x, std::int32_t y);
+		EventChunk& GetChunkForWrite(std::int32_t chunkIdx);
+
+		static std::int32_t FindEntryIndex(const EventChunk& chunk, std::uint16_t index);
 	};
 }
\ No newline at end of file
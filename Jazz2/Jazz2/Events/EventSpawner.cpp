@@ -1,5 +1,6 @@
 ﻿#include "EventSpawner.h"
 
+#include "../Actors/ActorPool.h"
 #include "../Actors/Collectibles/AmmoCollectible.h"
 #include "../Actors/Collectibles/CarrotCollectible.h"
 #include "../Actors/Collectibles/CarrotFlyCollectible.h"
@@ -219,7 +220,7 @@ namespace Jazz2::Events
 	void EventSpawner::RegisterSpawnable(EventType type)
 	{
 		_spawnableEvents[type] = { [](const ActorActivationDetails& details) -> std::shared_ptr<ActorBase> {
-			std::shared_ptr<ActorBase> actor = std::make_shared<T>();
+			std::shared_ptr<ActorBase> actor = CreatePooled<T>();
 			actor->OnActivated(details);
 			return actor;
 		}, T::Preload };
@@ -32,6 +32,7 @@ namespace Jazz2
 		virtual const char* GetNewestVersion() const = 0;
 
 		virtual void RefreshCacheLevels() = 0;
+		virtual float GetRefreshCacheProgress() const = 0;
 		
 	private:
 		/// Deleted copy constructor
@@ -13,6 +13,7 @@ namespace Jazz2
 
 		virtual void OnBeginFrame() { }
 		virtual void OnEndFrame() { }
+		virtual void OnInterpolateFrame(float factor) { }
 		virtual void OnInitializeViewport(int width, int height) { }
 
 		virtual void OnKeyPressed(const nCine::KeyboardEvent& event) { }
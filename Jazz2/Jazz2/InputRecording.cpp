@@ -0,0 +1,141 @@
+﻿#include "InputRecording.h"
+
+#include "Base/TimeStamp.h"
+
+#include <IO/FileSystem.h>
+
+using namespace Death::IO;
+
+namespace Jazz2
+{
+	InputRecording::InputRecording()
+		: Difficulty(GameDifficulty::Normal), IsReforged(true), LastExitType(ExitType::None), Player { }, Seed(TimeStamp::now().ticks()),
+			_frameCount(0), _currentRun(0), _currentRunFrame(0)
+	{
+	}
+
+	bool InputRecording::LoadFromFile(const StringView& path)
+	{
+		auto s = fs::Open(path, FileAccessMode::Read);
+		if (s->GetSize() < 24) {
+			LOGE("Cannot open input recording \"%s\"", String::nullTerminatedView(path).data());
+			return false;
+		}
+
+		uint64_t signature = s->ReadValue<uint64_t>();
+		uint8_t fileType = s->ReadValue<uint8_t>();
+		uint16_t version = s->ReadValue<uint16_t>();
+		if (signature != Signature || fileType != FileType || version > Version) {
+			LOGE("File \"%s\" is not valid input recording", String::nullTerminatedView(path).data());
+			return false;
+		}
+
+		uint8_t episodeNameLength = s->ReadValue<uint8_t>();
+		EpisodeName = String(NoInit, episodeNameLength);
+		s->Read(EpisodeName.data(), episodeNameLength);
+		uint8_t levelNameLength = s->ReadValue<uint8_t>();
+		LevelName = String(NoInit, levelNameLength);
+		s->Read(LevelName.data(), levelNameLength);
+
+		Difficulty = (GameDifficulty)s->ReadValue<uint8_t>();
+		IsReforged = (s->ReadValue<uint8_t>() != 0);
+		LastExitType = (ExitType)s->ReadValue<uint8_t>();
+		uint16_t playerSize = s->ReadValue<uint16_t>();
+		if (playerSize != sizeof(PlayerCarryOver)) {
+			LOGE("Input recording \"%s\" was created by incompatible version", String::nullTerminatedView(path).data());
+			return false;
+		}
+		s->Read(&Player, sizeof(PlayerCarryOver));
+		Seed = s->ReadValue<uint64_t>();
+
+		uint32_t runCount = s->ReadValue<uint32_t>();
+		_runs.clear();
+		_runs.reserve(runCount);
+		_frameCount = 0;
+		for (uint32_t i = 0; i < runCount; i++) {
+			auto& run = _runs.emplace_back();
+			run.Count = s->ReadValue<uint32_t>();
+			run.Frame.PressedActions = s->ReadValue<uint32_t>();
+			run.Frame.RequiredMovement.X = s->ReadValue<float>();
+			run.Frame.RequiredMovement.Y = s->ReadValue<float>();
+			run.Frame.NumericKey = s->ReadValue<uint8_t>();
+			_frameCount += run.Count;
+		}
+
+		_currentRun = 0;
+		_currentRunFrame = 0;
+		return true;
+	}
+
+	bool InputRecording::SaveToFile(const StringView& path) const
+	{
+		auto so = fs::Open(path, FileAccessMode::Write);
+		if (!so->IsValid()) {
+			LOGE("Cannot save input recording to \"%s\"", String::nullTerminatedView(path).data());
+			return false;
+		}
+
+		so->WriteValue<uint64_t>(Signature);
+		so->WriteValue<uint8_t>(FileType);
+		so->WriteValue<uint16_t>(Version);
+
+		so->WriteValue<uint8_t>((uint8_t)EpisodeName.size());
+		so->Write(EpisodeName.data(), (uint32_t)EpisodeName.size());
+		so->WriteValue<uint8_t>((uint8_t)LevelName.size());
+		so->Write(LevelName.data(), (uint32_t)LevelName.size());
+
+		so->WriteValue<uint8_t>((uint8_t)Difficulty);
+		so->WriteValue<uint8_t>(IsReforged ? 1 : 0);
+		so->WriteValue<uint8_t>((uint8_t)LastExitType);
+		so->WriteValue<uint16_t>((uint16_t)sizeof(PlayerCarryOver));
+		so->Write(&Player, sizeof(PlayerCarryOver));
+		so->WriteValue<uint64_t>(Seed);
+
+		so->WriteValue<uint32_t>((uint32_t)_runs.size());
+		for (auto& run : _runs) {
+			so->WriteValue<uint32_t>(run.Count);
+			so->WriteValue<uint32_t>(run.Frame.PressedActions);
+			so->WriteValue<float>(run.Frame.RequiredMovement.X);
+			so->WriteValue<float>(run.Frame.RequiredMovement.Y);
+			so->WriteValue<uint8_t>(run.Frame.NumericKey);
+		}
+
+		LOGI("Input recording with %u frames (%u runs) saved to \"%s\"", _frameCount, (uint32_t)_runs.size(), String::nullTerminatedView(path).data());
+		return true;
+	}
+
+	LevelInitialization InputRecording::CreateLevelInitialization() const
+	{
+		LevelInitialization levelInit(EpisodeName, LevelName, Difficulty, IsReforged, false, Player.Type);
+		levelInit.LastExitType = LastExitType;
+		levelInit.PlayerCarryOvers[0] = Player;
+		return levelInit;
+	}
+
+	void InputRecording::AddFrame(const InputFrame& frame)
+	{
+		if (!_runs.empty() && _runs.back().Frame == frame) {
+			_runs.back().Count++;
+		} else {
+			auto& run = _runs.emplace_back();
+			run.Frame = frame;
+			run.Count = 1;
+		}
+		_frameCount++;
+	}
+
+	bool InputRecording::NextFrame(InputFrame& frame)
+	{
+		if (_currentRun >= _runs.size()) {
+			return false;
+		}
+
+		frame = _runs[_currentRun].Frame;
+		_currentRunFrame++;
+		if (_currentRunFrame >= _runs[_currentRun].Count) {
+			_currentRun++;
+			_currentRunFrame = 0;
+		}
+		return true;
+	}
+}
@@ -0,0 +1,91 @@
+﻿#pragma once
+
+#include "../Common.h"
+#include "LevelInitialization.h"
+
+#include "Primitives/Vector2.h"
+
+#include <Containers/SmallVector.h>
+#include <Containers/String.h>
+#include <Containers/StringView.h>
+
+using namespace Death::Containers;
+using namespace nCine;
+
+namespace Jazz2
+{
+	/** @brief Player input of a single frame as seen by @ref LevelHandler */
+	struct InputFrame {
+		static constexpr uint8_t NoNumericKey = 0xFF;
+
+		/** @brief Currently pressed actions including gamepad bits (lower half of pressed actions) */
+		uint32_t PressedActions;
+		/** @brief Analog movement of the first player */
+		Vector2f RequiredMovement;
+		/** @brief Pressed numeric key used to switch weapons or @ref NoNumericKey */
+		uint8_t NumericKey;
+
+		bool operator==(const InputFrame& other) const {
+			return (PressedActions == other.PressedActions && RequiredMovement == other.RequiredMovement && NumericKey == other.NumericKey);
+		}
+		bool operator!=(const InputFrame& other) const {
+			return !operator==(other);
+		}
+	};
+
+	/** @brief Per-frame player input of a single level with random seed, so the gameplay can be replayed deterministically */
+	class InputRecording
+	{
+	public:
+		static constexpr uint64_t Signature = 0x2095A59FF0BFBBEF;
+		static constexpr uint8_t FileType = 7;
+		static constexpr uint16_t Version = 1;
+
+		/** @brief Sequence used to initialize the random generator together with @ref Seed */
+		static constexpr uint64_t SeedSequence = 0xda3e39cb94b95bdbULL;
+
+		InputRecording();
+
+		InputRecording(const InputRecording&) = delete;
+		InputRecording& operator=(const InputRecording&) = delete;
+
+		String EpisodeName;
+		String LevelName;
+		GameDifficulty Difficulty;
+		bool IsReforged;
+		ExitType LastExitType;
+		/** @brief State of the first player carried over from the previous level */
+		PlayerCarryOver Player;
+		uint64_t Seed;
+
+		/** @brief Returns level initialization that starts the recorded level in the same state */
+		LevelInitialization CreateLevelInitialization() const;
+
+		bool LoadFromFile(const StringView& path);
+		bool SaveToFile(const StringView& path) const;
+
+		/** @brief Appends a frame, consecutive identical frames are stored only once */
+		void AddFrame(const InputFrame& frame);
+		/** @brief Returns the next frame during replay, or `false` if the end of the recording was reached */
+		bool NextFrame(InputFrame& frame);
+
+		uint32_t GetFrameCount() const {
+			return _frameCount;
+		}
+
+		bool IsAtEnd() const {
+			return (_currentRun >= _runs.size());
+		}
+
+	private:
+		struct FrameRun {
+			InputFrame Frame;
+			uint32_t Count;
+		};
+
+		SmallVector<FrameRun, 0> _runs;
+		uint32_t _frameCount;
+		uint32_t _currentRun;
+		uint32_t _currentRunFrame;
+	};
+}
@@ -19,6 +19,7 @@
 #include "Graphics/RenderQueue.h"
 #include "Audio/AudioReaderMpt.h"
 #include "Base/Random.h"
+#include "Base/TimeStamp.h"
 
 #include "Actors/Player.h"
 #include "Actors/SolidObjectBase.h"
@@ -35,11 +36,12 @@ namespace Jazz2
 	LevelHandler::LevelHandler(IRootController* root, const LevelInitialization& levelInit)
 		: _root(root), _eventSpawner(this), _levelFileName(levelInit.LevelName), _episodeName(levelInit.EpisodeName),
 			_difficulty(levelInit.Difficulty), _isReforged(levelInit.IsReforged), _cheatsUsed(levelInit.CheatsUsed), _cheatsBufferLength(0),
-			_nextLevelType(ExitType::None), _nextLevelTime(0.0f), _elapsedFrames(0.0f), _checkpointFrames(0.0f),
+			_nextLevelType(ExitType::None), _nextLevelTime(0.0f), _resourcesPreloaded(false), _elapsedFrames(0.0f), _checkpointFrames(0.0f),
 			_shakeDuration(0.0f), _waterLevel(FLT_MAX), _ambientLightTarget(1.0f), _weatherType(WeatherType::None),
 			_downsamplePass(this), _blurPass1(this), _blurPass2(this), _blurPass3(this), _blurPass4(this),
 			_pressedKeys((uint32_t)KeySym::COUNT), _pressedActions(0), _overrideActions(0), _playerFrozenEnabled(false),
-			_lastPressedNumericKey(UINT32_MAX)
+			_lastPressedNumericKey(UINT32_MAX), _inputRecording(nullptr), _isReplayingInput(false), _animationBenchmarkFrames(0),
+			_animationBenchmarkTime(0.0f), _animationBenchmarkMaxTime(0.0f)
 	{
 		constexpr float DefaultGravity = 0.3f;
 
@@ -110,6 +112,10 @@ namespace Jazz2
 
 		_eventMap->PreloadEventsAsync();
 
+		if (PreferencesCache::BenchmarkAnimationActors > 0) {
+			SpawnAnimationBenchmarkActors();
+		}
+
 		resolver.EndLoading();
 	}
 
@@ -118,6 +124,12 @@ namespace Jazz2
 		// Remove nodes from UpscaleRenderPass
 		_combineRenderer->setParent(nullptr);
 		_hud->setParent(nullptr);
+
+#if defined(WITH_AUDIO)
+		_voiceManager.LogStatistics();
+		// Actors can outlive the level, so their sounds are stopped here
+		_voiceManager.Clear();
+#endif
 	}
 
 	Recti LevelHandler::LevelBounds() const
@@ -166,6 +178,10 @@ namespace Jazz2
 
 		_eventMap = std::move(eventMap);
 
+		Vector2i layoutSize = _tileMap->Size();
+		_eventBucketCount = Vector2i((layoutSize.X + EventBucketSize - 1) / EventBucketSize, (layoutSize.Y + EventBucketSize - 1) / EventBucketSize);
+		_eventBuckets.resize(_eventBucketCount.X * _eventBucketCount.Y);
+
 		Vector2i levelBounds = _tileMap->LevelBounds();
 		_levelBounds = Recti(0, 0, levelBounds.X, levelBounds.Y);
 		_viewBounds = Rectf((float)_levelBounds.X, (float)_levelBounds.Y, (float)_levelBounds.W, (float)_levelBounds.H);
@@ -214,6 +230,18 @@ namespace Jazz2
 	{
 		float timeMult = theApplication().timeMult();
 
+		// Game logic should never see the interpolated camera position
+		_cameraPos = _cameraUpdatedPos;
+
+		// Resources are preloaded on worker threads, but textures and audio buffers have to be created here
+		if (_inputRecording != nullptr && !_resourcesPreloaded) {
+			// Recorded input must be applied to the same state, so the gameplay cannot depend on preloading speed
+			ContentResolver::Get().FinalizePreloadedResources();
+			_resourcesPreloaded = true;
+		} else if (ContentResolver::Get().FinalizePreloadedResources(PreloadFinalizeTimeBudget)) {
+			_resourcesPreloaded = true;
+		}
+
 		UpdatePressedActions();
 
 		if (PlayerActionHit(0, PlayerActions::Menu) && _pauseMenu == nullptr && _nextLevelType == ExitType::None) {
@@ -234,13 +262,7 @@ namespace Jazz2
 			}
 		}
 
-		for (int32_t i = (int32_t)_playingSounds.size() - 1; i >= 0; i--) {
-			if (_playingSounds[i]->isStopped()) {
-				_playingSounds.erase(&_playingSounds[i]);
-			} else {
-				break;
-			}
-		}
+		_voiceManager.Update(timeMult, _cameraPos);
 #endif
 
 		if (_pauseMenu == nullptr) {
@@ -289,7 +311,8 @@ namespace Jazz2
 				}
 			}
 
-			if (_difficulty != GameDifficulty::Multiplayer) {
+			// Events are spawned only after all preloaded resources are finalized
+			if (_difficulty != GameDifficulty::Multiplayer && _resourcesPreloaded) {
 				if (!_players.empty()) {
 					auto& pos = _players[0]->GetPos();
 					int32_t tx1 = (int32_t)pos.X / Tiles::TileSet::DefaultTileSize;
@@ -302,27 +325,7 @@ namespace Jazz2
 					tx2 += ActivateTileRange;
 					ty2 += ActivateTileRange;
 
-					int32_t tx1d = tx1 - 4;
-					int32_t ty1d = ty1 - 4;
-					int32_t tx2d = tx2 + 4;
-					int32_t ty2d = ty2 + 4;
-
-					for (auto& actor : _actors) {
-						if ((actor->_state & (Actors::ActorState::IsCreatedFromEventMap | Actors::ActorState::IsFromGenerator)) != Actors::ActorState::None) {
-							Vector2i originTile = actor->_originTile;
-							if (originTile.X < tx1d || originTile.Y < ty1d || originTile.X > tx2d || originTile.Y > ty2d) {
-								if (actor->OnTileDeactivated()) {
-									if ((actor->_state & Actors::ActorState::IsFromGenerator) == Actors::ActorState::IsFromGenerator) {
-										_eventMap->ResetGenerator(originTile.X, originTile.Y);
-									}
-
-									_eventMap->Deactivate(originTile.X, originTile.Y);
-
-									actor->_state |= Actors::ActorState::IsDestroyed;
-								}
-							}
-						}
-					}
+					DeactivateEventActors(tx1 - 4, ty1 - 4, tx2 + 4, ty2 + 4);
 
 					_eventMap->ActivateEvents(tx1, ty1, tx2, ty2, true);
 				}
@@ -374,15 +377,17 @@ namespace Jazz2
 							debris.Time = 180.0f;
 
 							uint32_t curAnimFrame = it->second.FrameOffset + Random().Next(0, it->second.FrameCount);
-							uint32_t col = curAnimFrame % resBase->FrameConfiguration.X;
-							uint32_t row = curAnimFrame / resBase->FrameConfiguration.X;
+							Vector2i framePos = resBase->GetFrameTexturePosition(curAnimFrame);
 							debris.TexScaleX = (float(resBase->FrameDimensions.X) / float(texSize.X));
-							debris.TexBiasX = (float(resBase->FrameDimensions.X * col) / float(texSize.X));
+							debris.TexBiasX = (float(framePos.X) / float(texSize.X));
 							debris.TexScaleY = (float(resBase->FrameDimensions.Y) / float(texSize.Y));
-							debris.TexBiasY = (float(resBase->FrameDimensions.Y * row) / float(texSize.Y));
+							debris.TexBiasY = (float(framePos.Y) / float(texSize.Y));
 
 							debris.DiffuseTexture = resBase->TextureDiffuse.get();
 							debris.Flags = debrisFlags;
+							if (resBase->IsIndexed()) {
+								debris.Flags |= TileMap::DebrisFlags::Indexed;
+							}
 
 							_tileMap->CreateDebris(debris);
 						}
@@ -413,15 +418,17 @@ namespace Jazz2
 							debris.Time = 180.0f;
 
 							uint32_t curAnimFrame = it->second.FrameOffset + Random().Next(0, it->second.FrameCount);
-							uint32_t col = curAnimFrame % resBase->FrameConfiguration.X;
-							uint32_t row = curAnimFrame / resBase->FrameConfiguration.X;
+							Vector2i framePos = resBase->GetFrameTexturePosition(curAnimFrame);
 							debris.TexScaleX = (float(resBase->FrameDimensions.X) / float(texSize.X));
-							debris.TexBiasX = (float(resBase->FrameDimensions.X * col) / float(texSize.X));
+							debris.TexBiasX = (float(framePos.X) / float(texSize.X));
 							debris.TexScaleY = (float(resBase->FrameDimensions.Y) / float(texSize.Y));
-							debris.TexBiasY = (float(resBase->FrameDimensions.Y * row) / float(texSize.Y));
+							debris.TexBiasY = (float(framePos.Y) / float(texSize.Y));
 
 							debris.DiffuseTexture = resBase->TextureDiffuse.get();
 							debris.Flags = debrisFlags;
+							if (resBase->IsIndexed()) {
+								debris.Flags |= TileMap::DebrisFlags::Indexed;
+							}
 
 							_tileMap->CreateDebris(debris);
 						}
@@ -463,11 +470,31 @@ namespace Jazz2
 			UpdateCamera(timeMult);
 
 			_elapsedFrames += timeMult;
+
+			if (!_animationBenchmarkActors.empty()) {
+				UpdateAnimationBenchmark();
+			}
+		}
+
+		if (_tileMap != nullptr) {
+			// Vertex buffers of changed tiles are reallocated here, because the visit can run on worker threads
+			_tileMap->PrepareLayerChunks();
 		}
 
 		_lightingView->setClearColor(_ambientColor.W, 0.0f, 0.0f, 1.0f);
 	}
 
+	void LevelHandler::OnInterpolateFrame(float factor)
+	{
+		if (_players.empty()) {
+			return;
+		}
+
+		_cameraPos.X = std::round(lerp(_cameraPrevUpdatedPos.X, _cameraUpdatedPos.X, factor));
+		_cameraPos.Y = std::round(lerp(_cameraPrevUpdatedPos.Y, _cameraUpdatedPos.Y, factor));
+		_camera->setView(_cameraPos, 0.0f, 1.0f);
+	}
+
 	void LevelHandler::OnInitializeViewport(int32_t width, int32_t height)
 	{
 		constexpr float defaultRatio = (float)DefaultWidth / DefaultHeight;
@@ -671,48 +698,33 @@ namespace Jazz2
 
 		if (!actor->GetState(Actors::ActorState::ForceDisableCollisions)) {
 			actor->UpdateAABB();
-			actor->CollisionProxyID = _collisions.CreateProxy(actor->AABB, actor.get());
+			actor->CollisionProxyID = _collisions.CreateProxy(actor->AABB, actor.get(), (uint32_t)actor->_collisionCategory);
+		}
+
+		if ((actor->_state & (Actors::ActorState::IsCreatedFromEventMap | Actors::ActorState::IsFromGenerator)) != Actors::ActorState::None && !_eventBuckets.empty()) {
+			GetEventBucket(actor->_originTile).push_back(actor.get());
 		}
 
 		_actors.emplace_back(actor);
 	}
 
-	std::shared_ptr<AudioBufferPlayer> LevelHandler::PlaySfx(AudioBuffer* buffer, const Vector3f& pos, bool sourceRelative, float gain, float pitch)
+	std::shared_ptr<AudioBufferPlayer> LevelHandler::PlaySfx(const SoundResource& resource, const Vector3f& pos, bool sourceRelative, float gain, float pitch)
 	{
-		auto& player = _playingSounds.emplace_back(std::make_shared<AudioBufferPlayer>(buffer));
-		player->setPosition(Vector3f(pos.X, pos.Y, 100.0f));
-		player->setGain(gain * PreferencesCache::MasterVolume * PreferencesCache::SfxVolume);
-		player->setSourceRelative(sourceRelative);
-
-		if (pos.Y >= _waterLevel) {
-			player->setLowPass(0.05f);
-			player->setPitch(pitch * 0.7f);
-		} else {
-			player->setPitch(pitch);
+		if (resource.Buffers.empty()) {
+			return nullptr;
 		}
 
-		player->play();
-		return player;
+		int32_t idx = (resource.Buffers.size() > 1 ? Random().Next(0, (int32_t)resource.Buffers.size()) : 0);
+		bool isUnderwater = (pos.Y >= _waterLevel);
+		return _voiceManager.Play(&resource, &resource.Buffers[idx]->Buffer, Vector3f(pos.X, pos.Y, 100.0f), sourceRelative,
+			gain * PreferencesCache::MasterVolume * PreferencesCache::SfxVolume, isUnderwater ? pitch * 0.7f : pitch, isUnderwater ? 0.05f : 1.0f);
 	}
 
 	std::shared_ptr<AudioBufferPlayer> LevelHandler::PlayCommonSfx(const StringView& identifier, const Vector3f& pos, float gain, float pitch)
 	{
 		auto it = _commonResources->Sounds.find(String::nullTerminatedView(identifier));
 		if (it != _commonResources->Sounds.end()) {
-			int32_t idx = (it->second.Buffers.size() > 1 ? Random().Next(0, (int32_t)it->second.Buffers.size()) : 0);
-			auto& player = _playingSounds.emplace_back(std::make_shared<AudioBufferPlayer>(it->second.Buffers[idx].get()));
-			player->setPosition(Vector3f(pos.X, pos.Y, 100.0f));
-			player->setGain(gain * PreferencesCache::MasterVolume * PreferencesCache::SfxVolume);
-
-			if (pos.Y >= _waterLevel) {
-				player->setLowPass(/*0.2f*/0.05f);
-				player->setPitch(pitch * 0.7f);
-			} else {
-				player->setPitch(pitch);
-			}
-
-			player->play();
-			return player;
+			return PlaySfx(it->second, pos, false, gain, pitch);
 		} else {
 			return nullptr;
 		}
@@ -738,6 +750,8 @@ namespace Jazz2
 			_cameraPos.Y = focusPos.Y;
 			_cameraLastPos = _cameraPos + diff;
 		}
+		// Don't interpolate the camera movement caused by warping
+		_cameraUpdatedPos = _cameraPos;
 	}
 
 	bool LevelHandler::IsPositionEmpty(Actors::ActorBase* self, const AABBf& aabb, TileCollisionParams& params, Actors::ActorBase** collider)
@@ -782,8 +796,9 @@ namespace Jazz2
 					return true;
 				}
 
-				Actors::SolidObjectBase* solidObject = dynamic_cast<Actors::SolidObjectBase*>(actor);
-				if (solidObject == nullptr || !solidObject->IsOneWay || params.Downwards) {
+				bool isOneWay = ((actor->GetCollisionCategory() & Actors::CollisionCategory::SolidObject) == Actors::CollisionCategory::SolidObject &&
+					static_cast<Actors::SolidObjectBase*>(actor)->IsOneWay);
+				if (!isOneWay || params.Downwards) {
 					std::shared_ptr selfShared = self->shared_from_this();
 					std::shared_ptr actorShared = actor->shared_from_this();
 					if (!selfShared->OnHandleCollision(actorShared) && !actorShared->OnHandleCollision(selfShared)) {
@@ -793,7 +808,7 @@ namespace Jazz2
 				}
 
 				return true;
-			});
+			}, ~(Actors::CollisionCategory::Shot | Actors::CollisionCategory::Collectible));
 
 			*collider = colliderActor;
 		}
@@ -801,7 +816,7 @@ namespace Jazz2
 		return (*collider == nullptr);
 	}
 
-	void LevelHandler::FindCollisionActorsByAABB(Actors::ActorBase* self, const AABBf& aabb, const std::function<bool(Actors::ActorBase*)>& callback)
+	void LevelHandler::FindCollisionActorsByAABB(Actors::ActorBase* self, const AABBf& aabb, const std::function<bool(Actors::ActorBase*)>& callback, Actors::CollisionCategory categories)
 	{
 		struct QueryHelper {
 			const LevelHandler* Handler;
@@ -822,10 +837,10 @@ namespace Jazz2
 		};
 
 		QueryHelper helper = { this, self, aabb, callback };
-		_collisions.Query(&helper, aabb);
+		_collisions.Query(&helper, aabb, (uint32_t)categories);
 	}
 
-	void LevelHandler::FindCollisionActorsByRadius(float x, float y, float radius, const std::function<bool(Actors::ActorBase*)>& callback)
+	void LevelHandler::FindCollisionActorsByRadius(float x, float y, float radius, const std::function<bool(Actors::ActorBase*)>& callback, Actors::CollisionCategory categories)
 	{
 		AABBf aabb = AABBf(x - radius, y - radius, x + radius, y + radius);
 		float radiusSquared = (radius * radius);
@@ -861,7 +876,7 @@ namespace Jazz2
 		};
 
 		QueryHelper helper = { this, x, y, radiusSquared, callback };
-		_collisions.Query(&helper, aabb);
+		_collisions.Query(&helper, aabb, (uint32_t)categories);
 	}
 
 	void LevelHandler::GetCollidingPlayers(const AABBf& aabb, const std::function<bool(Actors::ActorBase*)> callback)
@@ -1044,7 +1059,8 @@ namespace Jazz2
 		auto it = _commonResources->Sounds.find(String::nullTerminatedView("SugarRush"_s));
 		if (it != _commonResources->Sounds.end()) {
 			int32_t idx = (it->second.Buffers.size() > 1 ? Random().Next(0, (int32_t)it->second.Buffers.size()) : 0);
-			_sugarRushMusic = _playingSounds.emplace_back(std::make_shared<AudioBufferPlayer>(it->second.Buffers[idx].get()));
+			// Sugar Rush replaces the music, so it's not managed together with other sounds
+			_sugarRushMusic = std::make_shared<AudioBufferPlayer>(&it->second.Buffers[idx]->Buffer);
 			_sugarRushMusic->setPosition(Vector3f(0.0f, 0.0f, 100.0f));
 			_sugarRushMusic->setGain(PreferencesCache::MasterVolume * PreferencesCache::MusicVolume);
 			_sugarRushMusic->setSourceRelative(true);
@@ -1208,29 +1224,32 @@ namespace Jazz2
 
 	void LevelHandler::ResolveCollisions(float timeMult)
 	{
-		auto it = _actors.begin();
-		while (it != _actors.end()) {
-			Actors::ActorBase* actor = it->get();
+		int32_t i = 0;
+		while (i < (int32_t)_actors.size()) {
+			Actors::ActorBase* actor = _actors[i].get();
 			if (actor->GetState(Actors::ActorState::IsDestroyed)) {
 				if (actor->CollisionProxyID != Collisions::NullNode) {
 					_collisions.DestroyProxy(actor->CollisionProxyID);
 					actor->CollisionProxyID = Collisions::NullNode;
 				}
+				if ((actor->_state & (Actors::ActorState::IsCreatedFromEventMap | Actors::ActorState::IsFromGenerator)) != Actors::ActorState::None) {
+					RemoveFromEventBucket(actor);
+				}
 
-				it = _actors.erase(it);
+				// Order of actors doesn't matter, so the last one is moved to the free slot instead of shifting the rest
+				if (i != (int32_t)_actors.size() - 1) {
+					_actors[i] = std::move(_actors.back());
+				}
+				_actors.pop_back();
 				continue;
 			}
 			
-			if (actor->GetState(Actors::ActorState::IsDirty)) {
-				if (actor->CollisionProxyID == Collisions::NullNode) {
-					continue;
-				}
-
+			if (actor->GetState(Actors::ActorState::IsDirty) && actor->CollisionProxyID != Collisions::NullNode) {
 				actor->UpdateAABB();
 				_collisions.MoveProxy(actor->CollisionProxyID, actor->AABB, actor->_speed * timeMult);
 				actor->SetState(Actors::ActorState::IsDirty, false);
 			}
-			++it;
+			i++;
 		}
 
 		struct UpdatePairsHelper {
@@ -1242,10 +1261,11 @@ namespace Jazz2
 				}
 
 				if (actorA->IsCollidingWith(actorB)) {
+					// Callbacks take the other actor by reference, so each actor is referenced only once per pair
 					std::shared_ptr<Actors::ActorBase> actorSharedA = actorA->shared_from_this();
 					std::shared_ptr<Actors::ActorBase> actorSharedB = actorB->shared_from_this();
-					if (!actorSharedA->OnHandleCollision(actorSharedB->shared_from_this())) {
-						actorSharedB->OnHandleCollision(actorSharedA->shared_from_this());
+					if (!actorA->OnHandleCollision(actorSharedB)) {
+						actorB->OnHandleCollision(actorSharedA);
 					}
 				}
 			}
@@ -1254,6 +1274,121 @@ namespace Jazz2
 		_collisions.UpdatePairs(&helper);
 	}
 
+	void LevelHandler::SpawnAnimationBenchmarkActors()
+	{
+		if (_players.empty()) {
+			return;
+		}
+
+		// Enemies are placed in rows above the first player, so they are active for the whole benchmark
+		Vector2f origin = _players[0]->GetPos();
+		uint8_t spawnParams[Events::EventSpawner::SpawnParamsSize] = { };
+		for (uint32_t i = 0; i < PreferencesCache::BenchmarkAnimationActors; i++) {
+			Vector3i pos = Vector3i((int32_t)origin.X + (int32_t)(i % 20) * 24 - 240, (int32_t)origin.Y - (int32_t)(i / 20) * 32 - 32, ILevelHandler::MainPlaneZ);
+			std::shared_ptr<Actors::ActorBase> actor = _eventSpawner.SpawnEvent(EventType::EnemyTurtle, spawnParams, Actors::ActorState::None, pos);
+			if (actor != nullptr) {
+				_animationBenchmarkActors.push_back(actor);
+				AddActor(actor);
+			}
+		}
+
+		LOGI("Spawned %u enemies for animation benchmark", (uint32_t)_animationBenchmarkActors.size());
+	}
+
+	void LevelHandler::UpdateAnimationBenchmark()
+	{
+		constexpr uint32_t BenchmarkFrameCount = 600;
+
+		// Each enemy resolves two animations and one transition per frame, frames until all metadata are loaded are not counted
+		uint32_t actorCount = 0;
+		TimeStamp startTime = TimeStamp::now();
+		for (auto& actor : _animationBenchmarkActors) {
+			if (actor->_metadata == nullptr) {
+				continue;
+			}
+			actor->SetAnimation(AnimState::Idle);
+			actor->SetAnimation(AnimState::Walk);
+			actor->SetTransition(AnimState::TransitionTurn, true);
+			actor->CancelTransition();
+			actorCount++;
+		}
+		float time = startTime.millisecondsSince();
+
+		if (actorCount < _animationBenchmarkActors.size()) {
+			return;
+		}
+
+		_animationBenchmarkFrames++;
+		_animationBenchmarkTime += time;
+		_animationBenchmarkMaxTime = std::max(_animationBenchmarkMaxTime, time);
+
+		if (_animationBenchmarkFrames >= BenchmarkFrameCount) {
+			LOGI("Animation benchmark finished: %u enemies, %u frames, %.3f ms per frame (max. %.3f ms)", actorCount, _animationBenchmarkFrames,
+				_animationBenchmarkTime / _animationBenchmarkFrames, _animationBenchmarkMaxTime);
+			_animationBenchmarkActors.clear();
+			theApplication().quit();
+		}
+	}
+
+	void LevelHandler::DeactivateEventActors(int32_t tx1, int32_t ty1, int32_t tx2, int32_t ty2)
+	{
+		for (int32_t by = 0; by < _eventBucketCount.Y; by++) {
+			for (int32_t bx = 0; bx < _eventBucketCount.X; bx++) {
+				// Buckets that lie completely inside the area can't contain any actor to deactivate
+				if (bx * EventBucketSize >= tx1 && (bx + 1) * EventBucketSize - 1 <= tx2 &&
+					by * EventBucketSize >= ty1 && (by + 1) * EventBucketSize - 1 <= ty2) {
+					continue;
+				}
+
+				auto& bucket = _eventBuckets[by * _eventBucketCount.X + bx];
+				for (int32_t i = (int32_t)bucket.size() - 1; i >= 0; i--) {
+					Actors::ActorBase* actor = bucket[i];
+					Vector2i originTile = actor->_originTile;
+					if (originTile.X >= tx1 && originTile.Y >= ty1 && originTile.X <= tx2 && originTile.Y <= ty2) {
+						continue;
+					}
+
+					if (actor->OnTileDeactivated()) {
+						if ((actor->_state & Actors::ActorState::IsFromGenerator) == Actors::ActorState::IsFromGenerator) {
+							_eventMap->ResetGenerator(originTile.X, originTile.Y);
+						}
+
+						_eventMap->Deactivate(originTile.X, originTile.Y);
+
+						actor->_state |= Actors::ActorState::IsDestroyed;
+
+						bucket[i] = bucket.back();
+						bucket.pop_back();
+					}
+				}
+			}
+		}
+	}
+
+	SmallVector<Actors::ActorBase*, 0>& LevelHandler::GetEventBucket(Vector2i originTile)
+	{
+		int32_t bx = std::clamp(originTile.X / EventBucketSize, 0, _eventBucketCount.X - 1);
+		int32_t by = std::clamp(originTile.Y / EventBucketSize, 0, _eventBucketCount.Y - 1);
+		return _eventBuckets[by * _eventBucketCount.X + bx];
+	}
+
+	void LevelHandler::RemoveFromEventBucket(Actors::ActorBase* actor)
+	{
+		if (_eventBuckets.empty()) {
+			return;
+		}
+
+		// Actors that were deactivated are already removed from their bucket
+		auto& bucket = GetEventBucket(actor->_originTile);
+		for (int32_t i = 0; i < (int32_t)bucket.size(); i++) {
+			if (bucket[i] == actor) {
+				bucket[i] = bucket.back();
+				bucket.pop_back();
+				break;
+			}
+		}
+	}
+
 	void LevelHandler::InitializeCamera()
 	{
 		if (_players.empty()) {
@@ -1279,6 +1414,8 @@ namespace Jazz2
 		}
 
 		_cameraLastPos = _cameraPos;
+		_cameraUpdatedPos = _cameraPos;
+		_cameraPrevUpdatedPos = _cameraPos;
 		_camera->setView(_cameraPos, 0.0f, 1.0f);
 	}
 
@@ -1305,6 +1442,7 @@ namespace Jazz2
 		// The position to focus on
 		Vector2f focusPos = targetObj->_pos;
 
+		_cameraPrevUpdatedPos = _cameraUpdatedPos;
 		_cameraLastPos.X = lerp(_cameraLastPos.X, focusPos.X, 0.5f * timeMult);
 		_cameraLastPos.Y = lerp(_cameraLastPos.Y, focusPos.Y, 0.5f * timeMult);
 
@@ -1338,6 +1476,7 @@ namespace Jazz2
 			_cameraPos.Y = std::floor(_viewBounds.Y + _viewBounds.H * 0.5f + _shakeOffset.Y);
 		}
 
+		_cameraUpdatedPos = _cameraPos;
 		_camera->setView(_cameraPos, 0.0f, 1.0f);
 
 		// Update audio listener position
@@ -1468,21 +1607,11 @@ namespace Jazz2
 			_pressedActions |= (1 << (int32_t)PlayerActions::Menu);
 		}
 
-		// Use numeric key to switch weapons for the first player
-		if (!_players.empty()) {
-			bool found = false;
-			for (uint32_t i = 0; i < 9; i++) {
-				if (_pressedKeys[(uint32_t)KeySym::N1 + i]) {
-					if (_lastPressedNumericKey != i) {
-						_lastPressedNumericKey = i;
-						_players[0]->SwitchToWeaponByIndex(i);
-					}
-					found = true;
-					break;
-				}
-			}
-			if (!found) {
-				_lastPressedNumericKey = UINT32_MAX;
+		uint8_t numericKey = InputFrame::NoNumericKey;
+		for (uint32_t i = 0; i < 9; i++) {
+			if (_pressedKeys[(uint32_t)KeySym::N1 + i]) {
+				numericKey = (uint8_t)i;
+				break;
 			}
 		}
 
@@ -1547,6 +1676,43 @@ namespace Jazz2
 
 		// Also apply overriden actions (by touch controls)
 		_pressedActions |= _overrideActions;
+
+		if (_inputRecording != nullptr) {
+			InputFrame frame;
+			if (_isReplayingInput) {
+				if (_inputRecording->NextFrame(frame)) {
+					_pressedActions = (_pressedActions & 0xffffffff00000000ull) | frame.PressedActions;
+					_playerRequiredMovement = frame.RequiredMovement;
+					numericKey = frame.NumericKey;
+				} else {
+					LOGI("Input replay finished after %u frames", _inputRecording->GetFrameCount());
+					_inputRecording = nullptr;
+				}
+			} else {
+				frame.PressedActions = (uint32_t)_pressedActions;
+				frame.RequiredMovement = _playerRequiredMovement;
+				frame.NumericKey = numericKey;
+				_inputRecording->AddFrame(frame);
+			}
+		}
+
+		// Use numeric key to switch weapons for the first player
+		if (!_players.empty()) {
+			if (numericKey != InputFrame::NoNumericKey) {
+				if (_lastPressedNumericKey != numericKey) {
+					_lastPressedNumericKey = numericKey;
+					_players[0]->SwitchToWeaponByIndex(numericKey);
+				}
+			} else {
+				_lastPressedNumericKey = UINT32_MAX;
+			}
+		}
+	}
+
+	void LevelHandler::SetInputRecording(InputRecording* recording, bool replay)
+	{
+		_inputRecording = recording;
+		_isReplayingInput = replay;
 	}
 
 	void LevelHandler::PauseGame()
@@ -1561,12 +1727,11 @@ namespace Jazz2
 		if (_music != nullptr) {
 			_music->setLowPass(0.1f);
 		}
-		for (auto& sound : _playingSounds) {
-			if (sound->isPlaying()) {
-				sound->pause();
-			}
-		}
+		_voiceManager.Pause();
 		// If Sugar Rush music is playing, pause it and play normal music instead
+		if (_sugarRushMusic != nullptr && _sugarRushMusic->isPlaying()) {
+			_sugarRushMusic->pause();
+		}
 		if (_sugarRushMusic != nullptr && _music != nullptr) {
 			_music->play();
 		}
@@ -1586,10 +1751,9 @@ namespace Jazz2
 			_music->pause();
 		}
 		// Resume all SFX
-		for (auto& sound : _playingSounds) {
-			if (sound->isPaused()) {
-				sound->play();
-			}
+		_voiceManager.Resume();
+		if (_sugarRushMusic != nullptr && _sugarRushMusic->isPaused()) {
+			_sugarRushMusic->play();
 		}
 		if (_music != nullptr) {
 			_music->setLowPass(1.0f);
@@ -3,12 +3,14 @@
 #include "ILevelHandler.h"
 #include "IStateHandler.h"
 #include "IRootController.h"
+#include "InputRecording.h"
 #include "WeatherType.h"
 #include "Events/EventMap.h"
 #include "Events/EventSpawner.h"
 #include "Tiles/TileMap.h"
 #include "Collisions/DynamicTreeBroadPhase.h"
 #include "UI/UpscaleRenderPass.h"
+#include "VoiceManager.h"
 #include "UI/Menu/InGameMenu.h"
 
 #include "Graphics/Shader.h"
@@ -57,6 +59,8 @@ namespace Jazz2
 		static constexpr int32_t DefaultWidth = 720;
 		static constexpr int32_t DefaultHeight = 405;
 		static constexpr int32_t ActivateTileRange = 26;
+		static constexpr int32_t EventBucketSize = 16;
+		static constexpr float PreloadFinalizeTimeBudget = 4.0f;
 
 		LevelHandler(IRootController* root, const LevelInitialization& levelInit);
 		~LevelHandler() override;
@@ -65,6 +69,9 @@ namespace Jazz2
 			return (_tileMap != nullptr && _eventMap != nullptr);
 		}
 
+		/** @brief Records input of the first player to the specified recording, or replays it instead of the actual input */
+		void SetInputRecording(InputRecording* recording, bool replay);
+
 		Events::EventSpawner* EventSpawner() override {
 			return &_eventSpawner;
 		}
@@ -99,6 +106,7 @@ namespace Jazz2
 
 		void OnBeginFrame() override;
 		void OnEndFrame() override;
+		void OnInterpolateFrame(float factor) override;
 		void OnInitializeViewport(int32_t width, int32_t height) override;
 
 		void OnKeyPressed(const KeyboardEvent& event) override;
@@ -107,12 +115,12 @@ namespace Jazz2
 
 		void AddActor(std::shared_ptr<Actors::ActorBase> actor) override;
 
-		std::shared_ptr<AudioBufferPlayer> PlaySfx(AudioBuffer* buffer, const Vector3f& pos, bool sourceRelative, float gain = 1.0f, float pitch = 1.0f) override;
+		std::shared_ptr<AudioBufferPlayer> PlaySfx(const SoundResource& resource, const Vector3f& pos, bool sourceRelative, float gain = 1.0f, float pitch = 1.0f) override;
 		std::shared_ptr<AudioBufferPlayer> PlayCommonSfx(const StringView& identifier, const Vector3f& pos, float gain = 1.0f, float pitch = 1.0f) override;
 		void WarpCameraToTarget(const std::shared_ptr<Actors::ActorBase>& actor, bool fast = false) override;
 		bool IsPositionEmpty(Actors::ActorBase* self, const AABBf& aabb, TileCollisionParams& params, Actors::ActorBase** collider) override;
-		void FindCollisionActorsByAABB(Actors::ActorBase* self, const AABBf& aabb, const std::function<bool(Actors::ActorBase*)>& callback) override;
-		void FindCollisionActorsByRadius(float x, float y, float radius, const std::function<bool(Actors::ActorBase*)>& callback) override;
+		void FindCollisionActorsByAABB(Actors::ActorBase* self, const AABBf& aabb, const std::function<bool(Actors::ActorBase*)>& callback, Actors::CollisionCategory categories = Actors::CollisionCategory::All) override;
+		void FindCollisionActorsByRadius(float x, float y, float radius, const std::function<bool(Actors::ActorBase*)>& callback, Actors::CollisionCategory categories = Actors::CollisionCategory::All) override;
 		void GetCollidingPlayers(const AABBf& aabb, const std::function<bool(Actors::ActorBase*)> callback) override;
 
 		void BroadcastTriggeredEvent(Actors::ActorBase* initiator, EventType eventType, uint8_t* eventParams) override;
@@ -249,6 +257,9 @@ namespace Jazz2
 		std::unique_ptr<Scripting::LevelScriptLoader> _scripts;
 #endif
 		SmallVector<std::shared_ptr<Actors::ActorBase>, 0> _actors;
+		// Actors created from event map grouped by origin tile, so deactivation doesn't have to check all actors
+		SmallVector<SmallVector<Actors::ActorBase*, 0>, 0> _eventBuckets;
+		Vector2i _eventBucketCount;
 		SmallVector<Actors::Player*, LevelInitialization::MaxPlayerCount> _players;
 
 		String _levelFileName;
@@ -266,6 +277,7 @@ namespace Jazz2
 		String _nextLevel;
 		ExitType _nextLevelType;
 		float _nextLevelTime;
+		bool _resourcesPreloaded;
 
 		Events::EventSpawner _eventSpawner;
 		std::unique_ptr<Events::EventMap> _eventMap;
@@ -278,6 +290,9 @@ namespace Jazz2
 		Rectf _viewBoundsTarget;
 		Vector2f _cameraPos;
 		Vector2f _cameraLastPos;
+		// Camera positions after the last two updates, used to interpolate rendering with fixed update rate
+		Vector2f _cameraUpdatedPos;
+		Vector2f _cameraPrevUpdatedPos;
 		Vector2f _cameraDistanceFactor;
 		float _shakeDuration;
 		Vector2f _shakeOffset;
@@ -285,7 +300,7 @@ namespace Jazz2
 		float _ambientLightTarget;
 		Vector4f _ambientColor;
 		std::unique_ptr<AudioStreamPlayer> _music;
-		SmallVector<std::shared_ptr<AudioBufferPlayer>> _playingSounds;
+		VoiceManager _voiceManager;
 		Metadata* _commonResources;
 		std::unique_ptr<UI::HUD> _hud;
 		std::shared_ptr<UI::Menu::InGameMenu> _pauseMenu;
@@ -301,12 +316,24 @@ namespace Jazz2
 		Vector2f _playerFrozenMovement;
 		bool _playerFrozenEnabled;
 		uint32_t _lastPressedNumericKey;
+		InputRecording* _inputRecording;
+		bool _isReplayingInput;
+		// Enemies spawned by "/benchmark-animations" command-line parameter
+		SmallVector<std::shared_ptr<Actors::ActorBase>, 0> _animationBenchmarkActors;
+		uint32_t _animationBenchmarkFrames;
+		float _animationBenchmarkTime;
+		float _animationBenchmarkMaxTime;
 
 		void OnLevelLoaded(const StringView& fullPath, const StringView& name, const StringView& nextLevel, const StringView& secretLevel,
 			std::unique_ptr<Tiles::TileMap>& tileMap, std::unique_ptr<Events::EventMap>& eventMap,
 			const StringView& musicPath, const Vector4f& ambientColor, WeatherType weatherType, uint8_t weatherIntensity, uint16_t waterLevel, SmallVectorImpl<String>& levelTexts);
 
 		void ResolveCollisions(float timeMult);
+		void SpawnAnimationBenchmarkActors();
+		void UpdateAnimationBenchmark();
+		void DeactivateEventActors(int32_t tx1, int32_t ty1, int32_t tx2, int32_t ty2);
+		SmallVector<Actors::ActorBase*, 0>& GetEventBucket(Vector2i originTile);
+		void RemoveFromEventBucket(Actors::ActorBase* actor);
 		void InitializeCamera();
 		void UpdateCamera(float timeMult);
 		void UpdatePressedActions();
@@ -0,0 +1,203 @@
+﻿#include "PakFile.h"
+
+#include "Base/Algorithms.h"
+#include "Base/HashFunctions.h"
+
+#include <cstring>
+
+using namespace nCine;
+
+namespace Jazz2
+{
+	PakFile::PakFile(const StringView& path)
+		: _data(nullptr), _size(0), _entries(nullptr), _entryCount(0), _dataOffset(0)
+	{
+		if (!fs::IsReadableFile(path)) {
+			return;
+		}
+
+#if defined(DEATH_TARGET_UNIX) || (defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_WINDOWS_RT))
+		auto mappedFile = fs::OpenAsMemoryMapped(path, FileAccessMode::Read);
+		if (!mappedFile || mappedFile->size() < HeaderSize || mappedFile->size() > INT32_MAX) {
+			return;
+		}
+		_mappedFile = std::move(*mappedFile);
+		const uint8_t* data = (const uint8_t*)_mappedFile.data();
+		int32_t size = (int32_t)_mappedFile.size();
+#else
+		// Memory mapping is not supported on this platform, so read the whole file at once instead
+		auto s = fs::Open(path, FileAccessMode::Read);
+		int32_t size = s->GetSize();
+		if (size < HeaderSize) {
+			return;
+		}
+		_buffer = std::make_unique<uint8_t[]>(size);
+		s->Read(_buffer.get(), size);
+		const uint8_t* data = _buffer.get();
+#endif
+
+		uint64_t signature; uint16_t version; uint32_t entryCount, dataOffset;
+		std::memcpy(&signature, data, sizeof(signature));
+		std::memcpy(&version, data + 10, sizeof(version));
+		std::memcpy(&entryCount, data + 12, sizeof(entryCount));
+		std::memcpy(&dataOffset, data + 16, sizeof(dataOffset));
+
+		if (signature != Signature || data[8] != FileType || version != Version ||
+			entryCount > (uint32_t)(size - HeaderSize) / sizeof(IndexEntry) || dataOffset > (uint32_t)size) {
+			LOGE("File \"%s\" is not valid archive", String::nullTerminatedView(path).data());
+			return;
+		}
+
+		_data = data;
+		_size = size;
+		_entries = (const IndexEntry*)(data + HeaderSize);
+		_entryCount = entryCount;
+		_dataOffset = dataOffset;
+
+		LOGI("Archive \"%s\" mounted with %u files", String::nullTerminatedView(path).data(), entryCount);
+	}
+
+	std::unique_ptr<Stream> PakFile::OpenFile(const StringView& path) const
+	{
+		if (_data == nullptr) {
+			return nullptr;
+		}
+
+		char normalizedPath[MaxPathLength];
+		int32_t normalizedPathLength = (int32_t)path.size();
+		if (normalizedPathLength > MaxPathLength) {
+			return nullptr;
+		}
+		uint64_t hash = GetPathHash(path, normalizedPath, normalizedPathLength);
+
+		// Entries are sorted by path hash, collisions are resolved by comparing the paths
+		uint32_t first = 0, count = _entryCount;
+		while (count > 0) {
+			uint32_t step = count / 2;
+			if (_entries[first + step].PathHash < hash) {
+				first += step + 1;
+				count -= step + 1;
+			} else {
+				count = step;
+			}
+		}
+
+		for (const IndexEntry* entry = _entries + first, *end = _entries + _entryCount; entry != end && entry->PathHash == hash; entry++) {
+			if (entry->PathLength != normalizedPathLength || entry->PathOffset + entry->PathLength > (uint32_t)_size ||
+				std::memcmp(_data + entry->PathOffset, normalizedPath, normalizedPathLength) != 0) {
+				continue;
+			}
+
+			uint64_t offset = (uint64_t)_dataOffset + entry->Offset;
+			if (offset + entry->Size > (uint64_t)_size) {
+				LOGE("File \"%s\" exceeds the archive bounds", String::nullTerminatedView(path).data());
+				return nullptr;
+			}
+
+			return std::make_unique<MemoryStream>(_data + offset, (int32_t)entry->Size);
+		}
+
+		return nullptr;
+	}
+
+	uint64_t PakFile::GetPathHash(const StringView& path, char* normalizedPath, int32_t normalizedPathLength)
+	{
+		for (int32_t i = 0; i < normalizedPathLength; i++) {
+			char c = path[i];
+			if (c == '\\') {
+				c = '/';
+			} else if (c >= 'A' && c <= 'Z') {
+				c = (char)(c - 'A' + 'a');
+			}
+			normalizedPath[i] = c;
+		}
+
+		return fasthash64(normalizedPath, normalizedPathLength, Signature);
+	}
+
+	PakWriter::PakWriter(const StringView& path)
+		: _data(1024 * 1024)
+	{
+		_outputStream = fs::Open(path, FileAccessMode::Write);
+	}
+
+	PakWriter::~PakWriter()
+	{
+		Finalize();
+	}
+
+	void PakWriter::AddFile(const StringView& path, const uint8_t* data, int32_t size)
+	{
+		if (path.size() > PakFile::MaxPathLength) {
+			LOGE("Path \"%s\" is too long to be included in archive", String::nullTerminatedView(path).data());
+			return;
+		}
+
+		auto& entry = _entries.emplace_back();
+		entry.Path = String(NoInit, path.size());
+		entry.PathHash = PakFile::GetPathHash(path, entry.Path.data(), (int32_t)path.size());
+		entry.Offset = (uint32_t)_data.GetPosition();
+		entry.Size = (uint32_t)size;
+
+		_data.Write(data, size);
+	}
+
+	bool PakWriter::Finalize()
+	{
+		if (_outputStream == nullptr) {
+			return false;
+		}
+		if (!_outputStream->IsValid()) {
+			_outputStream = nullptr;
+			return false;
+		}
+
+		// Sort the entries by hash, so the reader can use binary search directly on the mapped index
+		quicksort(_entries.begin(), _entries.end(), [](const PendingEntry& a, const PendingEntry& b) -> bool {
+			return a.PathHash < b.PathHash;
+		});
+
+		uint32_t pathsOffset = PakFile::HeaderSize + (uint32_t)(_entries.size() * sizeof(PakFile::IndexEntry));
+		uint32_t pathsSize = 0;
+		for (auto& entry : _entries) {
+			pathsSize += (uint32_t)entry.Path.size();
+		}
+		// Align data to 8 bytes
+		uint32_t dataOffset = (pathsOffset + pathsSize + 7) & ~7u;
+
+		_outputStream->WriteValue<uint64_t>(PakFile::Signature);
+		_outputStream->WriteValue<uint8_t>(PakFile::FileType);
+		_outputStream->WriteValue<uint8_t>(0);
+		_outputStream->WriteValue<uint16_t>(PakFile::Version);
+		_outputStream->WriteValue<uint32_t>((uint32_t)_entries.size());
+		_outputStream->WriteValue<uint32_t>(dataOffset);
+		_outputStream->WriteValue<uint32_t>(0);
+
+		uint32_t pathOffset = pathsOffset;
+		for (auto& entry : _entries) {
+			PakFile::IndexEntry indexEntry;
+			indexEntry.PathHash = entry.PathHash;
+			indexEntry.Offset = entry.Offset;
+			indexEntry.Size = entry.Size;
+			indexEntry.PathOffset = pathOffset;
+			indexEntry.PathLength = (uint16_t)entry.Path.size();
+			indexEntry.Reserved = 0;
+			_outputStream->Write(&indexEntry, sizeof(indexEntry));
+			pathOffset += (uint32_t)entry.Path.size();
+		}
+
+		for (auto& entry : _entries) {
+			_outputStream->Write(entry.Path.data(), (int32_t)entry.Path.size());
+		}
+
+		uint8_t padding[8] { };
+		_outputStream->Write(padding, (int32_t)(dataOffset - pathOffset));
+		_outputStream->Write(_data.GetBuffer(), _data.GetSize());
+
+		LOGI("Archive with %u files was created", (uint32_t)_entries.size());
+
+		_outputStream = nullptr;
+		_entries.clear();
+		return true;
+	}
+}
@@ -0,0 +1,102 @@
+﻿#pragma once
+
+#include "../Common.h"
+
+#include <memory>
+
+#include <Containers/SmallVector.h>
+#include <Containers/String.h>
+#include <Containers/StringView.h>
+#include <IO/FileSystem.h>
+#include <IO/MemoryStream.h>
+
+using namespace Death::Containers;
+using namespace Death::IO;
+
+namespace Jazz2
+{
+	/** @brief Read-only archive of many small files, mapped into memory once and served as zero-copy streams */
+	class PakFile
+	{
+	public:
+		static constexpr uint64_t Signature = 0x2095A59FF0BFBBEF;
+		static constexpr uint8_t FileType = 6;
+		static constexpr uint16_t Version = 1;
+
+		PakFile(const StringView& path);
+
+		PakFile(const PakFile&) = delete;
+		PakFile& operator=(const PakFile&) = delete;
+
+		bool IsValid() const {
+			return (_data != nullptr);
+		}
+
+		/** @brief Returns a stream over the packed file, or `nullptr` if the file is not in the archive */
+		std::unique_ptr<Stream> OpenFile(const StringView& path) const;
+
+		/** @brief Returns hash of normalized path (lowercase with forward slashes) as stored in the index */
+		static uint64_t GetPathHash(const StringView& path, char* normalizedPath, int32_t normalizedPathLength);
+
+	private:
+		friend class PakWriter;
+
+		static constexpr int32_t HeaderSize = 24;
+		static constexpr int32_t MaxPathLength = 512;
+
+#pragma pack(push, 1)
+		struct IndexEntry {
+			uint64_t PathHash;
+			uint32_t Offset;
+			uint32_t Size;
+			uint32_t PathOffset;
+			uint16_t PathLength;
+			uint16_t Reserved;
+		};
+#pragma pack(pop)
+
+		static_assert(sizeof(IndexEntry) == 24, "IndexEntry must be 24 bytes long");
+
+#if defined(DEATH_TARGET_UNIX) || (defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_WINDOWS_RT))
+		Array<char, fs::MapDeleter> _mappedFile;
+#endif
+		std::unique_ptr<uint8_t[]> _buffer;
+		const uint8_t* _data;
+		int32_t _size;
+		const IndexEntry* _entries;
+		uint32_t _entryCount;
+		uint32_t _dataOffset;
+	};
+
+	/** @brief Creates @ref PakFile from files added in arbitrary order */
+	class PakWriter
+	{
+	public:
+		PakWriter(const StringView& path);
+		~PakWriter();
+
+		PakWriter(const PakWriter&) = delete;
+		PakWriter& operator=(const PakWriter&) = delete;
+
+		bool IsValid() const {
+			return (_outputStream != nullptr && _outputStream->IsValid());
+		}
+
+		/** @brief Adds a file to the archive, path should be relative to the directory the archive replaces */
+		void AddFile(const StringView& path, const uint8_t* data, int32_t size);
+		/** @brief Writes index and all added files, it's called automatically on destruction */
+		bool Finalize();
+
+	private:
+		struct PendingEntry {
+			String Path;
+			uint64_t PathHash;
+			uint32_t Offset;
+			uint32_t Size;
+		};
+
+		std::unique_ptr<Stream> _outputStream;
+		SmallVector<PendingEntry, 0> _entries;
+		MemoryStream _data;
+	};
+}
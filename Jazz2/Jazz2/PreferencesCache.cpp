@@ -45,6 +45,14 @@ namespace Jazz2
 	Vector2f PreferencesCache::TouchRightPadding;
 	char PreferencesCache::Language[6] { };
 	bool PreferencesCache::BypassCache = false;
+	bool PreferencesCache::UseFixedUpdateRate = false;
+	bool PreferencesCache::UseParallelVisit = false;
+	bool PreferencesCache::UseInstancedSprites = false;
+	String PreferencesCache::RecordInputPath;
+	String PreferencesCache::ReplayInputPath;
+	bool PreferencesCache::ReplayAsBenchmark = false;
+	bool PreferencesCache::BenchmarkImages = false;
+	uint32_t PreferencesCache::BenchmarkAnimationActors = 0;
 	float PreferencesCache::MasterVolume = 0.8f;
 	float PreferencesCache::SfxVolume = 0.8f;
 	float PreferencesCache::MusicVolume = 0.4f;
@@ -289,6 +297,35 @@ namespace Jazz2
 				if (paramValue > 0) {
 					MaxFps = std::max(paramValue, 30ul);
 				}
+			} else if (arg == "/fixed-update"_s) {
+				// Game logic is updated with constant rate independently of rendering
+				UseFixedUpdateRate = true;
+			} else if (arg == "/parallel-visit"_s) {
+				// Viewports are visited on worker threads, so render commands of each viewport are prepared concurrently
+				UseParallelVisit = true;
+			} else if (arg == "/instanced-sprites"_s) {
+				// Batches of sprites are drawn with instanced rendering instead of uniform blocks
+				UseInstancedSprites = true;
+			} else if (arg.hasPrefix("/record:"_s)) {
+				// Input of the first started level is recorded, so it can be replayed later
+				RecordInputPath = arg.exceptPrefix("/record:"_s);
+				UseFixedUpdateRate = true;
+			} else if (arg.hasPrefix("/replay:"_s)) {
+				ReplayInputPath = arg.exceptPrefix("/replay:"_s);
+				UseFixedUpdateRate = true;
+			} else if (arg.hasPrefix("/benchmark:"_s)) {
+				// Recorded input is replayed as fast as possible without rendering and audio
+				ReplayInputPath = arg.exceptPrefix("/benchmark:"_s);
+				ReplayAsBenchmark = true;
+				UseFixedUpdateRate = true;
+			} else if (arg == "/benchmark-images"_s) {
+				// All animation images are decoded once and the game quits right after
+				BenchmarkImages = true;
+			} else if (arg.hasPrefix("/benchmark-animations:"_s)) {
+				// Specified number of enemies is spawned next to the player and their animation changes are timed
+				char* end;
+				unsigned long paramValue = strtoul(arg.exceptPrefix("/benchmark-animations:"_s).data(), &end, 10);
+				BenchmarkAnimationActors = (uint32_t)std::min(paramValue, 10000ul);
 			} else if (arg == "/no-rgb"_s) {
 				EnableRgbLights = false;
 			} else if (arg == "/no-rescale"_s) {
@@ -108,6 +108,14 @@ namespace Jazz2
 		static Vector2f TouchRightPadding;
 		static char Language[6];
 		static bool BypassCache;
+		static bool UseFixedUpdateRate;
+		static bool UseParallelVisit;
+		static bool UseInstancedSprites;
+		static String RecordInputPath;
+		static String ReplayInputPath;
+		static bool ReplayAsBenchmark;
+		static bool BenchmarkImages;
+		static uint32_t BenchmarkAnimationActors;
 
 		// Sounds
 		static float MasterVolume;
@@ -375,7 +375,7 @@ shared abstract class CollectibleBase : )" AsClassName R"(
 		engine->ReturnContext(ctx);
 	}
 
-	bool ScriptActorWrapper::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool ScriptActorWrapper::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (_onHandleCollision != nullptr) {
 			if (auto otherWrapper = dynamic_cast<ScriptActorWrapper*>(other.get())) {
@@ -644,7 +644,7 @@ shared abstract class CollectibleBase : )" AsClassName R"(
 		async_return success;
 	}
 
-	bool ScriptCollectibleWrapper::OnHandleCollision(std::shared_ptr<ActorBase> other)
+	bool ScriptCollectibleWrapper::OnHandleCollision(const std::shared_ptr<ActorBase>& other)
 	{
 		if (auto player = dynamic_cast<Player*>(other.get())) {
 			if (OnCollect(player)) {
@@ -40,7 +40,7 @@ namespace Jazz2::Scripting
 			return *this;
 		}
 
-		bool OnHandleCollision(std::shared_ptr<ActorBase> other) override;
+		bool OnHandleCollision(const std::shared_ptr<ActorBase>& other) override;
 
 	protected:
 		LevelScriptLoader* _levelScripts;
@@ -101,7 +101,7 @@ namespace Jazz2::Scripting
 	public:
 		ScriptCollectibleWrapper(LevelScriptLoader* levelScripts, asIScriptObject* obj);
 
-		bool OnHandleCollision(std::shared_ptr<ActorBase> other) override;
+		bool OnHandleCollision(const std::shared_ptr<ActorBase>& other) override;
 
 	protected:
 		Task<bool> OnActivatedAsync(const Actors::ActorActivationDetails& details) override;
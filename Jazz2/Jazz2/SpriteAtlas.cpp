@@ -0,0 +1,210 @@
+﻿#include "SpriteAtlas.h"
+
+#include "ServiceLocator.h"
+#include "Base/Algorithms.h"
+
+#include <cstring>
+
+namespace Jazz2
+{
+	SpriteAtlas::SpriteAtlas()
+		: _pageSize(0), _createdPageCount(0)
+	{
+	}
+
+	std::shared_ptr<Texture> SpriteAtlas::Add(const uint32_t* pixels, int32_t width, int32_t height, bool linearSampling, bool indexed, bool persistent, Recti& rect)
+	{
+		if (_pageSize == 0) {
+			const IGfxCapabilities& gfxCaps = theServiceLocator().gfxCapabilities();
+			_pageSize = std::min(DefaultPageSize, gfxCaps.value(IGfxCapabilities::GLIntValues::MAX_TEXTURE_SIZE));
+		}
+
+		// Large sheets would fill most of the page, so there is nothing to gain
+		int32_t paddedWidth = width + 2 * Padding;
+		int32_t paddedHeight = height + 2 * Padding;
+		if (paddedWidth > _pageSize / 2 || paddedHeight > _pageSize / 2) {
+			return nullptr;
+		}
+
+		Page* target = nullptr;
+		Vector2i pos;
+		for (auto& page : _pages) {
+			if (!page.IsFull && page.LinearSampling == linearSampling && page.Indexed == indexed && page.Persistent == persistent && TryAllocate(page, paddedWidth, paddedHeight, _pageSize, pos)) {
+				target = &page;
+				break;
+			}
+		}
+
+		if (target == nullptr) {
+			char name[32];
+			formatString(name, arraySize(name), "SpriteAtlas%u", _createdPageCount);
+			_createdPageCount++;
+
+			target = &_pages.emplace_back();
+			target->TextureDiffuse = std::make_shared<Texture>(name, indexed ? Texture::Format::RG8 : Texture::Format::RGBA8, _pageSize, _pageSize);
+			target->TextureDiffuse->setMinFiltering(linearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
+			target->TextureDiffuse->setMagFiltering(linearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
+			target->UsedHeight = 0;
+			target->UsedArea = 0;
+			target->SheetCount = 0;
+			target->LiveArea = 0;
+			target->LiveSheetCount = 0;
+			target->LinearSampling = linearSampling;
+			target->Indexed = indexed;
+			target->Persistent = persistent;
+			target->IsFull = false;
+			target->IsSparse = false;
+			TryAllocate(*target, paddedWidth, paddedHeight, _pageSize, pos);
+		}
+
+		// Contents of a new page are undefined, so the padding is uploaded together with the sheet
+		int32_t bytesPerPixel = (indexed ? 2 : 4);
+		const uint8_t* src = reinterpret_cast<const uint8_t*>(pixels);
+		std::unique_ptr<uint8_t[]> padded = std::make_unique<uint8_t[]>(paddedWidth * paddedHeight * bytesPerPixel);
+		for (int32_t y = 0; y < height; y++) {
+			std::memcpy(&padded[((y + Padding) * paddedWidth + Padding) * bytesPerPixel], &src[y * width * bytesPerPixel], width * bytesPerPixel);
+		}
+		target->TextureDiffuse->loadFromTexels(padded.get(), pos.X, pos.Y, paddedWidth, paddedHeight);
+
+		target->UsedArea += (int64_t)width * height;
+		target->SheetCount++;
+		target->LiveArea += (int64_t)width * height;
+		target->LiveSheetCount++;
+
+		rect = Recti(pos.X + Padding, pos.Y + Padding, width, height);
+		return target->TextureDiffuse;
+	}
+
+	void SpriteAtlas::FinishPages()
+	{
+		for (auto& page : _pages) {
+			if (!page.Persistent) {
+				page.IsFull = true;
+			}
+		}
+	}
+
+	void SpriteAtlas::ReleaseUnusedPages()
+	{
+		for (int32_t i = (int32_t)_pages.size() - 1; i >= 0; i--) {
+			// The atlas holds the last reference, so all resources packed in the page were released
+			if (_pages[i].TextureDiffuse.use_count() <= 1) {
+				_pages.erase(_pages.begin() + i);
+			}
+		}
+	}
+
+	void SpriteAtlas::Clear()
+	{
+		_pages.clear();
+	}
+
+	void SpriteAtlas::BeginUsageCount()
+	{
+		for (auto& page : _pages) {
+			page.LiveArea = 0;
+			page.LiveSheetCount = 0;
+		}
+	}
+
+	void SpriteAtlas::AddUsedSheet(const Texture* texture, const Recti& rect)
+	{
+		if (Page* page = FindPage(texture)) {
+			page->LiveArea += (int64_t)rect.W * rect.H;
+			page->LiveSheetCount++;
+		}
+	}
+
+	int32_t SpriteAtlas::EndUsageCount()
+	{
+		int32_t sparseCount = 0;
+		for (auto& page : _pages) {
+			// Released space is never reused, so a few remaining sheets could keep the whole page resident
+			page.IsSparse = (page.LiveSheetCount > 0 && page.LiveArea * 2 < page.UsedArea);
+			if (page.IsSparse) {
+				page.IsFull = true;
+				sparseCount++;
+			}
+		}
+		return sparseCount;
+	}
+
+	bool SpriteAtlas::IsSparsePage(const Texture* texture) const
+	{
+		for (auto& page : _pages) {
+			if (page.TextureDiffuse.get() == texture) {
+				return page.IsSparse;
+			}
+		}
+		return false;
+	}
+
+	void SpriteAtlas::LogStatistics() const
+	{
+		if (_pages.empty()) {
+			return;
+		}
+
+		int64_t usedArea = 0, liveArea = 0;
+		int32_t liveSheetCount = 0;
+		uint32_t persistentCount = 0;
+		uint64_t residentBytes = 0;
+		for (auto& page : _pages) {
+			usedArea += page.UsedArea;
+			liveArea += page.LiveArea;
+			liveSheetCount += page.LiveSheetCount;
+			residentBytes += page.TextureDiffuse->dataSize();
+			if (page.Persistent) {
+				persistentCount++;
+			}
+		}
+
+		// Each page replaces many separate textures, so sprites from the same page can be drawn without texture switches
+		float totalArea = (float)_pageSize * _pageSize * _pages.size();
+		LOGI("Sprite atlas has %u resident pages of %ix%i (%u persistent, %llu KB), %i sheets in use occupy %0.1f%%, released sheets %0.1f%%",
+			(uint32_t)_pages.size(), _pageSize, _pageSize, persistentCount, (unsigned long long)(residentBytes / 1024), liveSheetCount,
+			(float)liveArea * 100.0f / totalArea, (float)(usedArea - liveArea) * 100.0f / totalArea);
+	}
+
+	SpriteAtlas::Page* SpriteAtlas::FindPage(const Texture* texture)
+	{
+		for (auto& page : _pages) {
+			if (page.TextureDiffuse.get() == texture) {
+				return &page;
+			}
+		}
+		return nullptr;
+	}
+
+	bool SpriteAtlas::TryAllocate(Page& page, int32_t width, int32_t height, int32_t pageSize, Vector2i& pos)
+	{
+		// Use the lowest shelf which is high enough to minimize wasted space
+		Shelf* best = nullptr;
+		for (auto& shelf : page.Shelves) {
+			if (height <= shelf.Height && shelf.UsedWidth + width <= pageSize && (best == nullptr || shelf.Height < best->Height)) {
+				best = &shelf;
+			}
+		}
+
+		// Open a new shelf instead if the sheet would waste more than half of the shelf height
+		if (best != nullptr && best->Height > height * 2 && page.UsedHeight + height <= pageSize) {
+			best = nullptr;
+		}
+
+		if (best == nullptr) {
+			if (page.UsedHeight + height > pageSize) {
+				return false;
+			}
+
+			best = &page.Shelves.emplace_back();
+			best->Y = page.UsedHeight;
+			best->Height = height;
+			best->UsedWidth = 0;
+			page.UsedHeight += height;
+		}
+
+		pos = Vector2i(best->UsedWidth, best->Y);
+		best->UsedWidth += width;
+		return true;
+	}
+}
@@ -0,0 +1,82 @@
+﻿#pragma once
+
+#include "../Common.h"
+
+#include "Graphics/Texture.h"
+
+#include <memory>
+
+#include <Containers/SmallVector.h>
+
+using namespace Death::Containers;
+using namespace nCine;
+
+namespace Jazz2
+{
+	/** @brief Packs sprite sheets loaded together into shared texture pages, so they can be drawn without switching textures */
+	class SpriteAtlas
+	{
+	public:
+		static constexpr int32_t DefaultPageSize = 2048;
+		// Transparent border around each sheet, so linear filtering and outline shaders don't sample neighbouring sheets
+		static constexpr int32_t Padding = 1;
+
+		SpriteAtlas();
+
+		SpriteAtlas(const SpriteAtlas&) = delete;
+		SpriteAtlas& operator=(const SpriteAtlas&) = delete;
+
+		/** @brief Uploads pixels of a sheet to a page (RGBA, or 2 bytes per pixel if indexed), returns `nullptr` if the sheet is too large to be packed */
+		std::shared_ptr<Texture> Add(const uint32_t* pixels, int32_t width, int32_t height, bool linearSampling, bool indexed, bool persistent, Recti& rect);
+		/** @brief Marks all pages except persistent ones as full, so sheets of the next level are packed together into new pages */
+		void FinishPages();
+		/** @brief Releases pages that are no longer used by any resource */
+		void ReleaseUnusedPages();
+		/** @brief Releases all pages */
+		void Clear();
+
+		/** @brief Starts counting of sheets which are still in use, @ref AddUsedSheet() has to be called for each of them */
+		void BeginUsageCount();
+		/** @brief Counts a sheet which is still in use */
+		void AddUsedSheet(const Texture* texture, const Recti& rect);
+		/** @brief Marks pages where most of the allocated area belongs to released sheets as full, returns number of such pages */
+		int32_t EndUsageCount();
+		/** @brief Returns `true` if the page was marked by the last @ref EndUsageCount(), so its sheets should be added again */
+		bool IsSparsePage(const Texture* texture) const;
+
+		/** @brief Logs resident pages and how much of them is used, usage has to be counted first */
+		void LogStatistics() const;
+
+	private:
+		struct Shelf {
+			int32_t Y;
+			int32_t Height;
+			int32_t UsedWidth;
+		};
+
+		struct Page {
+			std::shared_ptr<Texture> TextureDiffuse;
+			SmallVector<Shelf, 0> Shelves;
+			int32_t UsedHeight;
+			// Allocated area including sheets which were released, the space is not reused
+			int64_t UsedArea;
+			int32_t SheetCount;
+			int64_t LiveArea;
+			int32_t LiveSheetCount;
+			bool LinearSampling;
+			// Indexed sheets are drawn with palette lookup, so they can't share a page with true color sheets
+			bool Indexed;
+			// Sheets that outlived the level they were loaded for, they are kept apart so they don't hold pages of other levels
+			bool Persistent;
+			bool IsFull;
+			bool IsSparse;
+		};
+
+		SmallVector<Page, 0> _pages;
+		int32_t _pageSize;
+		uint32_t _createdPageCount;
+
+		Page* FindPage(const Texture* texture);
+		static bool TryAllocate(Page& page, int32_t width, int32_t height, int32_t pageSize, Vector2i& pos);
+	};
+}
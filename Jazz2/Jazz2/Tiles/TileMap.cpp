@@ -6,11 +6,13 @@
 #include "Graphics/RenderQueue.h"
 #include "Base/Random.h"
 
+#include <cstring>
+
 namespace Jazz2::Tiles
 {
 	TileMap::TileMap(LevelHandler* levelHandler, const StringView& tileSetPath, std::uint16_t captionTileId, PitType pitType, bool applyPalette)
-		: _levelHandler(levelHandler), _sprLayerIndex(-1), _pitType(pitType), _renderCommandsCount(0), _collapsingTimer(0.0f),
-			_triggerState(TriggerCount), _texturedBackgroundLayer(-1), _texturedBackgroundPass(this)
+		: _levelHandler(levelHandler), _sprLayerIndex(-1), _pitType(pitType), _collapsingTimer(0.0f), _triggerState(TriggerCount),
+			_renderCommandsCount(0), _chunkRenderCommandsCount(0), _chunkDrawCounter(0), _hasDirtyChunks(false), _texturedBackgroundLayer(-1), _texturedBackgroundPass(this)
 	{
 		auto& tileSetPart = _tileSets.emplace_back();
 		tileSetPart.Data = ContentResolver::Get().RequestTileSet(tileSetPath, captionTileId, applyPalette);
@@ -122,9 +124,11 @@ namespace Jazz2::Tiles
 		SceneNode::OnDraw(renderQueue);
 
 		_renderCommandsCount = 0;
+		_chunkRenderCommandsCount = 0;
+		_chunkDrawCounter++;
 
-		for (auto& layer : _layers) {
-			DrawLayer(renderQueue, layer);
+		for (std::int32_t i = 0; i < (std::int32_t)_layers.size(); i++) {
+			DrawLayer(renderQueue, _layers[i], _layerChunks[i]);
 		}
 
 		DrawDebris(renderQueue);
@@ -225,7 +229,7 @@ namespace Jazz2::Tiles
 							}
 
 							return true;
-						});
+						}, Actors::CollisionCategory::Other);
 
 						if (!iceBlockFound) {
 							std::shared_ptr<Actors::Environment::IceBlock> iceBlock = std::make_shared<Actors::Environment::IceBlock>();
@@ -291,16 +295,8 @@ namespace Jazz2::Tiles
 						bottom = (TileSet::DefaultTileSize - 1 - top2);
 					}
 
-					top *= TileSet::DefaultTileSize;
-					bottom *= TileSet::DefaultTileSize;
-
-					std::uint8_t* mask = tileSet->GetTileMask(tileId);
-					for (std::int32_t ry = top; ry <= bottom; ry += TileSet::DefaultTileSize) {
-						for (std::int32_t rx = left; rx <= right; rx++) {
-							if (mask[ry | rx]) {
-								return false;
-							}
-						}
+					if (tileSet->IsTileMaskOverlapping(tileId, left, top, right, bottom)) {
+						return false;
 					}
 				}
 			}
@@ -404,16 +400,8 @@ namespace Jazz2::Tiles
 						bottom = (TileSet::DefaultTileSize - 1 - top2);
 					}
 
-					top *= TileSet::DefaultTileSize;
-					bottom *= TileSet::DefaultTileSize;
-
-					std::uint8_t* mask = tileSet->GetTileMask(tileId);
-					for (std::int32_t ry = top; ry <= bottom; ry += TileSet::DefaultTileSize) {
-						for (std::int32_t rx = left; rx <= right; rx++) {
-							if (mask[ry | rx]) {
-								return false;
-							}
-						}
+					if (tileSet->IsTileMaskOverlapping(tileId, left, top, right, bottom)) {
+						return false;
 					}
 				}
 			}
@@ -510,6 +498,7 @@ namespace Jazz2::Tiles
 
 			tile.DestructFrameIndex += current;
 			tile.TileID = anim.Tiles[tile.DestructFrameIndex].TileID;
+			InvalidateLayerChunk(_sprLayerIndex, tx, ty);
 			if (tile.DestructFrameIndex >= max) {
 				if (!soundName.empty()) {
 					_levelHandler->PlayCommonSfx(soundName, Vector3f(tx * TileSet::DefaultTileSize + (TileSet::DefaultTileSize / 2),
@@ -557,7 +546,7 @@ namespace Jazz2::Tiles
 		}
 	}
 
-	void TileMap::DrawLayer(RenderQueue& renderQueue, TileMapLayer& layer)
+	void TileMap::DrawLayer(RenderQueue& renderQueue, TileMapLayer& layer, LayerChunks& chunks)
 	{
 		if (!layer.Visible) {
 			return;
@@ -567,7 +556,6 @@ namespace Jazz2::Tiles
 		Vector2f viewCenter = _levelHandler->GetCameraPos();
 
 		Vector2i tileCount = layer.LayoutSize;
-		Vector2i tileSize = Vector2i(TileSet::DefaultTileSize, TileSet::DefaultTileSize);
 
 		// Get current layer offsets and speeds
 		float loX = layer.Description.OffsetX;
@@ -645,119 +633,298 @@ namespace Jazz2::Tiles
 			float remY = fmodf(yt, (float)TileSet::DefaultTileSize);
 
 			// Calculate the index (on the layer map) of the first tile that needs to be drawn to the position determined earlier
-			std::int32_t tileX, tileY, tileAbsX, tileAbsY;
+			std::int32_t tileAbsX = (std::int32_t)(xt > 0 ? std::floor(xt / (float)TileSet::DefaultTileSize) : std::ceil(xt / (float)TileSet::DefaultTileSize));
+			std::int32_t tileAbsY = (std::int32_t)(yt > 0 ? std::floor(yt / (float)TileSet::DefaultTileSize) : std::ceil(yt / (float)TileSet::DefaultTileSize));
+
+			// Top-left corner of the first layout repetition, tiles are always aligned to whole pixels
+			float originX = std::floor(x1 - remX - (float)(tileAbsX * TileSet::DefaultTileSize));
+			float originY = std::floor(y1 - remY - (float)(tileAbsY * TileSet::DefaultTileSize));
+
+			// Range of tiles (including the ones from other repetitions of the layer) that need to be drawn
+			std::int32_t firstX = tileAbsX + 1;
+			std::int32_t lastX = tileAbsX + (viewSize.X + TileSet::DefaultTileSize * 3 - 1) / TileSet::DefaultTileSize;
+			std::int32_t firstY = tileAbsY + 1;
+			std::int32_t lastY = tileAbsY + (viewSize.Y + TileSet::DefaultTileSize * 3 - 1) / TileSet::DefaultTileSize;
+
+			if (!layer.Description.RepeatX) {
+				// Only the first iteration of the layer is drawn horizontally
+				firstX = std::max(firstX, 0);
+				lastX = std::min(lastX, tileCount.X - 1);
+			}
+			if (!layer.Description.RepeatY) {
+				// Only the first iteration of the layer is drawn vertically
+				firstY = std::max(firstY, 0);
+				lastY = std::min(lastY, tileCount.Y - 1);
+			}
+			if (firstX > lastX || firstY > lastY) {
+				return;
+			}
 
-			// Get the actual tile coords on the layer layout
-			if (xt > 0) {
-				tileAbsX = (std::int32_t)std::floor(xt / (float)TileSet::DefaultTileSize);
-				tileX = tileAbsX % tileCount.X;
-			} else {
-				tileAbsX = (std::int32_t)std::ceil(xt / (float)TileSet::DefaultTileSize);
-				tileX = tileAbsX % tileCount.X;
-				while (tileX < 0) {
-					tileX += tileCount.X;
+			std::int32_t repFirstX = (std::int32_t)std::floor((float)firstX / tileCount.X);
+			std::int32_t repLastX = (std::int32_t)std::floor((float)lastX / tileCount.X);
+			std::int32_t repFirstY = (std::int32_t)std::floor((float)firstY / tileCount.Y);
+			std::int32_t repLastY = (std::int32_t)std::floor((float)lastY / tileCount.Y);
+
+			for (std::int32_t ry = repFirstY; ry <= repLastY; ry++) {
+				std::int32_t repOffsetY = ry * tileCount.Y;
+				std::int32_t cy1 = (std::max(firstY, repOffsetY) - repOffsetY) / ChunkSize;
+				std::int32_t cy2 = (std::min(lastY, repOffsetY + tileCount.Y - 1) - repOffsetY) / ChunkSize;
+
+				for (std::int32_t rx = repFirstX; rx <= repLastX; rx++) {
+					std::int32_t repOffsetX = rx * tileCount.X;
+					std::int32_t cx1 = (std::max(firstX, repOffsetX) - repOffsetX) / ChunkSize;
+					std::int32_t cx2 = (std::min(lastX, repOffsetX + tileCount.X - 1) - repOffsetX) / ChunkSize;
+
+					for (std::int32_t cy = cy1; cy <= cy2; cy++) {
+						for (std::int32_t cx = cx1; cx <= cx2; cx++) {
+							LayerChunk& chunk = chunks.Chunks[cy * chunks.ChunkCount.X + cx];
+							float x = originX + (float)((repOffsetX + cx * ChunkSize) * TileSet::DefaultTileSize);
+							float y = originY + (float)((repOffsetY + cy * ChunkSize) * TileSet::DefaultTileSize);
+							DrawLayerChunk(renderQueue, layer, chunk, x, y, viewSize);
+						}
+					}
 				}
 			}
+		}
+	}
+
+	void TileMap::DrawLayerChunk(RenderQueue& renderQueue, TileMapLayer& layer, LayerChunk& chunk, float x, float y, Vector2i viewSize)
+	{
+		if (!chunk.IsDirty && !UpdateLayerChunkAnimatedTiles(layer, chunk)) {
+			// Current frame of some animated tile is from another tile set, so the chunk has to be rebuilt,
+			// vertex buffers can be reallocated only outside of the visit, so the old ones are drawn in this frame
+			chunk.IsDirty = true;
+			_hasDirtyChunks = true;
+		}
+
+		for (auto& part : chunk.Parts) {
+			if (part.TileCount == 0) {
+				continue;
+			}
 
-			if (yt > 0) {
-				tileAbsY = (std::int32_t)std::floor(yt / (float)TileSet::DefaultTileSize);
-				tileY = tileAbsY % tileCount.Y;
+			// The prebuilt command can be used only once per frame, other repetitions of the same chunk share its vertex buffer
+			RenderCommand* command;
+			if (part.LastDrawn != _chunkDrawCounter) {
+				part.LastDrawn = _chunkDrawCounter;
+				command = part.Command.get();
 			} else {
-				tileAbsY = (std::int32_t)std::ceil(yt / (float)TileSet::DefaultTileSize);
-				tileY = tileAbsY % tileCount.Y;
-				while (tileY < 0) {
-					tileY += tileCount.Y;
-				}
+				command = RentChunkRenderCommand(layer.Description.RendererType);
+				command->geometry().shareVbo(&part.Command->geometry());
+				command->geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, part.TileCount * ChunkVerticesPerTile);
 			}
 
-			// update x1 and y1 with the remainder so that we start at the tile boundary
-			// minus 1 because indices are updated in the beginning of the loops
-			x1 -= remX - (float)TileSet::DefaultTileSize;
-			y1 -= remY - (float)TileSet::DefaultTileSize;
-
-			// Save the tile Y at the left border so that we can roll back to it at the start of every row iteration
-			std::int32_t tileYs = tileY;
-
-			// Calculate the last coordinates we want to draw to
-			float x3 = x1 + (TileSet::DefaultTileSize * 2) + viewSize.X;
-			float y3 = y1 + (TileSet::DefaultTileSize * 2) + viewSize.Y;
-
-			std::int32_t tile_xo = -1;
-			for (float x2 = x1; x2 < x3; x2 += TileSet::DefaultTileSize) {
-				tileX = (tileX + 1) % tileCount.X;
-				tile_xo++;
-				if (!layer.Description.RepeatX) {
-					// If the current tile isn't in the first iteration of the layer horizontally, don't draw this column
-					if (tileAbsX + tile_xo + 1 < 0 || tileAbsX + tile_xo + 1 >= tileCount.X) {
+			TileSet* tileSet = _tileSets[part.TileSetIndex].Data.get();
+			Vector2i texSize = tileSet->TextureDiffuse->size();
+			float texBiasX = ((viewSize.X & 1) == 1 ? 0.5f / float(texSize.X) : 0.0f);
+			float texBiasY = ((viewSize.Y & 1) == 1 ? -0.5f / float(texSize.Y) : 0.0f);
+
+			auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
+			instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(1.0f, texBiasX, 1.0f, texBiasY);
+			instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(1.0f, 1.0f);
+
+			Vector4f color = layer.Description.Color;
+			color.W *= part.Alpha / 255.0f;
+			instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(color.Data());
+
+			command->setTransformation(Matrix4x4f::Translation(x, y, 0.0f));
+			command->setLayer(layer.Description.Depth);
+			command->material().setTexture(*tileSet->TextureDiffuse);
+
+			renderQueue.addCommand(command);
+		}
+	}
+
+	void TileMap::RebuildLayerChunk(TileMapLayer& layer, LayerChunk& chunk, std::int32_t cx, std::int32_t cy)
+	{
+		chunk.IsDirty = false;
+
+		for (auto& part : chunk.Parts) {
+			part.TileCount = 0;
+			part.AnimatedTiles.clear();
+		}
+
+		std::int32_t x1 = cx * ChunkSize;
+		std::int32_t y1 = cy * ChunkSize;
+		std::int32_t x2 = std::min(x1 + ChunkSize, layer.LayoutSize.X);
+		std::int32_t y2 = std::min(y1 + ChunkSize, layer.LayoutSize.Y);
+
+		// First pass counts tiles of each part, so vertex buffers are reallocated at most once
+		for (std::int32_t pass = 0; pass < 2; pass++) {
+			for (std::int32_t y = y1; y < y2; y++) {
+				for (std::int32_t x = x1; x < x2; x++) {
+					std::int32_t layoutIndex = x + y * layer.LayoutSize.X;
+					LayerTile& tile = layer.Layout[layoutIndex];
+					if (tile.Alpha == 0) {
 						continue;
 					}
-				}
-				tileY = tileYs;
-				std::int32_t tile_yo = -1;
-				for (float y2 = y1; y2 < y3; y2 += TileSet::DefaultTileSize) {
-					tileY = (tileY + 1) % tileCount.Y;
-					tile_yo++;
-
-					LayerTile tile = layer.Layout[tileX + tileY * layer.LayoutSize.X];
-
-					if (!layer.Description.RepeatY) {
-						// If the current tile isn't in the first iteration of the layer vertically, don't draw it
-						if (tileAbsY + tile_yo + 1 < 0 || tileAbsY + tile_yo + 1 >= tileCount.Y) {
-							continue;
-						}
-					}
 
+					bool isAnimated = ((tile.Flags & LayerTileFlags::Animated) == LayerTileFlags::Animated);
 					std::int32_t tileId = ResolveTileID(tile);
-					if (tileId == 0 || tile.Alpha == 0) {
-						continue;
+					std::int32_t tileSetIndex = -1;
+					if (tileId != 0) {
+						tileSetIndex = ResolveTileSetIndex(tileId);
+					} else if (isAnimated && tile.TileID < (std::int32_t)_animatedTiles.size()) {
+						// Current frame of the animated tile is empty, reserve the space in a part of any other non-empty frame
+						for (auto& frame : _animatedTiles[tile.TileID].Tiles) {
+							std::int32_t frameTileId = frame.TileID;
+							if (frameTileId != 0) {
+								tileSetIndex = ResolveTileSetIndex(frameTileId);
+								break;
+							}
+						}
 					}
-					TileSet* tileSet = ResolveTileSet(tileId);
-					if (tileSet == nullptr) {
+					if (tileSetIndex < 0) {
 						continue;
 					}
 
-					auto command = RentRenderCommand(layer.Description.RendererType);
-					command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+					ChunkPart* part = nullptr;
+					for (auto& current : chunk.Parts) {
+						if (current.TileSetIndex == tileSetIndex && current.Alpha == tile.Alpha) {
+							part = &current;
+							break;
+						}
+					}
 
-					Vector2i texSize = tileSet->TextureDiffuse->size();
-					float texScaleX = TileSet::DefaultTileSize / float(texSize.X);
-					float texBiasX = (tileId % tileSet->TilesPerRow) * TileSet::DefaultTileSize / float(texSize.X);
-					float texScaleY = TileSet::DefaultTileSize / float(texSize.Y);
-					float texBiasY = (tileId / tileSet->TilesPerRow) * TileSet::DefaultTileSize / float(texSize.Y);
+					if (pass == 0) {
+						if (part == nullptr) {
+							part = &chunk.Parts.emplace_back();
+							part->TileSetIndex = tileSetIndex;
+							part->Alpha = tile.Alpha;
+							part->TileCount = 0;
+							part->TileCapacity = 0;
+							part->LastDrawn = 0;
+						}
+						part->TileCount++;
+						continue;
+					}
 
-					// ToDo: Flip normal map somehow
-					if ((tile.Flags & LayerTileFlags::FlipX) == LayerTileFlags::FlipX) {
-						texBiasX += texScaleX;
-						texScaleX *= -1;
+					std::int32_t vertexIndex = part->TileCount * ChunkVerticesPerTile;
+					float* vertices = &part->Vertices[vertexIndex * ChunkFloatsPerVertex];
+					if (tileId != 0) {
+						WriteChunkTileVertices(vertices, (x - x1) * TileSet::DefaultTileSize, (y - y1) * TileSet::DefaultTileSize,
+							_tileSets[tileSetIndex].Data.get(), tileId, tile.Flags);
+					} else {
+						std::memset(vertices, 0, ChunkVerticesPerTile * ChunkFloatsPerVertex * sizeof(float));
 					}
-					if ((tile.Flags & LayerTileFlags::FlipY) == LayerTileFlags::FlipY) {
-						texBiasY += texScaleY;
-						texScaleY *= -1;
+					if (isAnimated) {
+						auto& animatedTile = part->AnimatedTiles.emplace_back();
+						animatedTile.LayoutIndex = layoutIndex;
+						animatedTile.VertexIndex = vertexIndex;
+						animatedTile.LastTileId = ResolveTileID(tile);
 					}
+					part->TileCount++;
+				}
+			}
 
-					if ((viewSize.X & 1) == 1) {
-						texBiasX += 0.5f / float(texSize.X);
-					}
-					if ((viewSize.Y & 1) == 1) {
-						texBiasY -= 0.5f / float(texSize.Y);
+			if (pass == 0) {
+				for (auto& part : chunk.Parts) {
+					if (part.TileCount > part.TileCapacity) {
+						// Allocate some additional space, so destructible tiles don't cause reallocation every time
+						part.TileCapacity = std::min(part.TileCount + 8, ChunkSize * ChunkSize);
+						std::int32_t floatCount = part.TileCapacity * ChunkVerticesPerTile * ChunkFloatsPerVertex;
+						part.Vertices = std::make_unique<float[]>(floatCount);
+						if (part.Command == nullptr) {
+							part.Command = std::make_unique<RenderCommand>();
+							part.Command->material().setBlendingEnabled(true);
+							part.Command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+							SetChunkRenderCommandShader(part.Command.get(), layer.Description.RendererType);
+						}
+						part.Command->geometry().createCustomVbo(floatCount, GL_DYNAMIC_DRAW);
 					}
+					part.TileCount = 0;
+				}
+			}
+		}
 
-					auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-					instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
-					instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(TileSet::DefaultTileSize, TileSet::DefaultTileSize);
+		for (auto& part : chunk.Parts) {
+			part.Command->geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, part.TileCount * ChunkVerticesPerTile);
+			part.Command->geometry().setHostVertexPointer(part.Vertices.get());
+		}
+	}
 
-					Vector4f color = layer.Description.Color;
-					color.W *= tile.Alpha / 255.0f;
-					instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(color.Data());
+	bool TileMap::UpdateLayerChunkAnimatedTiles(TileMapLayer& layer, LayerChunk& chunk)
+	{
+		for (auto& part : chunk.Parts) {
+			bool hasChanged = false;
+			for (auto& animatedTile : part.AnimatedTiles) {
+				LayerTile& tile = layer.Layout[animatedTile.LayoutIndex];
+				std::int32_t tileId = ResolveTileID(tile);
+				if (tileId == animatedTile.LastTileId) {
+					continue;
+				}
 
-					command->setTransformation(Matrix4x4f::Translation(std::floor(x2 + (TileSet::DefaultTileSize / 2)), std::floor(y2 + (TileSet::DefaultTileSize / 2)), 0.0f));
-					command->setLayer(layer.Description.Depth);
-					command->material().setTexture(*tileSet->TextureDiffuse);
+				animatedTile.LastTileId = tileId;
+				hasChanged = true;
 
-					renderQueue.addCommand(command);
+				float* vertices = &part.Vertices[animatedTile.VertexIndex * ChunkFloatsPerVertex];
+				if (tileId == 0) {
+					std::memset(vertices, 0, ChunkVerticesPerTile * ChunkFloatsPerVertex * sizeof(float));
+					continue;
 				}
+
+				if (ResolveTileSetIndex(tileId) != part.TileSetIndex) {
+					return false;
+				}
+
+				std::int32_t x = animatedTile.LayoutIndex % layer.LayoutSize.X;
+				std::int32_t y = animatedTile.LayoutIndex / layer.LayoutSize.X;
+				WriteChunkTileVertices(vertices, (x % ChunkSize) * TileSet::DefaultTileSize, (y % ChunkSize) * TileSet::DefaultTileSize,
+					_tileSets[part.TileSetIndex].Data.get(), tileId, tile.Flags);
+			}
+
+			if (hasChanged) {
+				// Mark vertices as dirty, so they will be uploaded again
+				part.Command->geometry().setHostVertexPointer(part.Vertices.get());
 			}
 		}
+
+		return true;
+	}
+
+	void TileMap::InvalidateLayerChunk(std::int32_t layerIndex, std::int32_t tx, std::int32_t ty)
+	{
+		if (layerIndex < 0 || layerIndex >= (std::int32_t)_layerChunks.size()) {
+			return;
+		}
+
+		auto& chunks = _layerChunks[layerIndex];
+		chunks.Chunks[(ty / ChunkSize) * chunks.ChunkCount.X + (tx / ChunkSize)].IsDirty = true;
+		_hasDirtyChunks = true;
+	}
+
+	void TileMap::WriteChunkTileVertices(float* vertices, std::int32_t x, std::int32_t y, TileSet* tileSet, std::int32_t tileId, LayerTileFlags flags)
+	{
+		Vector2i texSize = tileSet->TextureDiffuse->size();
+		float u1 = (tileId % tileSet->TilesPerRow) * TileSet::DefaultTileSize / float(texSize.X);
+		float v1 = (tileId / tileSet->TilesPerRow) * TileSet::DefaultTileSize / float(texSize.Y);
+		float u2 = u1 + TileSet::DefaultTileSize / float(texSize.X);
+		float v2 = v1 + TileSet::DefaultTileSize / float(texSize.Y);
+
+		// ToDo: Flip normal map somehow
+		if ((flags & LayerTileFlags::FlipX) == LayerTileFlags::FlipX) {
+			std::swap(u1, u2);
+		}
+		if ((flags & LayerTileFlags::FlipY) == LayerTileFlags::FlipY) {
+			std::swap(v1, v2);
+		}
+
+		float x1 = (float)x;
+		float y1 = (float)y;
+		float x2 = (float)(x + TileSet::DefaultTileSize);
+		float y2 = (float)(y + TileSet::DefaultTileSize);
+
+		// Each tile is a triangle strip with the same vertex order as sprites, first and last vertex
+		// are duplicated to create degenerate triangles between adjacent tiles
+		const float tileVertices[] = {
+			x2, y2, u2, v2,
+			x2, y2, u2, v2,
+			x2, y1, u2, v1,
+			x1, y2, u1, v2,
+			x1, y1, u1, v1,
+			x1, y1, u1, v1
+		};
+		static_assert(sizeof(tileVertices) == ChunkVerticesPerTile * ChunkFloatsPerVertex * sizeof(float));
+		std::memcpy(vertices, tileVertices, sizeof(tileVertices));
 	}
 
 	float TileMap::TranslateCoordinate(float coordinate, float speed, float offset, std::int32_t viewSize, bool isY)
@@ -774,7 +941,7 @@ namespace Jazz2::Tiles
 		return (coordinate * speed + offset + alignment * (speed - 1.0f));
 	}
 
-	RenderCommand* TileMap::RentRenderCommand(LayerRendererType type)
+	RenderCommand* TileMap::RentRenderCommand(LayerRendererType type, bool indexed)
 	{
 		RenderCommand* command;
 		if (_renderCommandsCount < _renderCommands.size()) {
@@ -788,7 +955,9 @@ namespace Jazz2::Tiles
 		bool shaderChanged;
 		switch (type) {
 			case LayerRendererType::Tinted: shaderChanged = command->material().setShader(ContentResolver::Get().GetShader(PrecompiledShader::Tinted)); break;
-			default: shaderChanged = command->material().setShaderProgramType(Material::ShaderProgramType::SPRITE); break;
+			default: shaderChanged = (indexed
+				? command->material().setShader(ContentResolver::Get().GetShader(PrecompiledShader::Indexed))
+				: command->material().setShaderProgramType(Material::ShaderProgramType::SPRITE)); break;
 		}
 		if (shaderChanged) {
 			command->material().reserveUniformsDataMemory();
@@ -800,9 +969,48 @@ namespace Jazz2::Tiles
 			}
 		}
 
+		if (indexed) {
+			ContentResolver::Get().BindPaletteTexture(command->material());
+		} else {
+			command->material().setTexture(1, nullptr);
+		}
+
 		return command;
 	}
 
+	RenderCommand* TileMap::RentChunkRenderCommand(LayerRendererType type)
+	{
+		RenderCommand* command;
+		if (_chunkRenderCommandsCount < _chunkRenderCommands.size()) {
+			command = _chunkRenderCommands[_chunkRenderCommandsCount].get();
+		} else {
+			command = _chunkRenderCommands.emplace_back(std::make_unique<RenderCommand>()).get();
+			command->material().setBlendingEnabled(true);
+			command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		}
+		_chunkRenderCommandsCount++;
+
+		SetChunkRenderCommandShader(command, type);
+		return command;
+	}
+
+	bool TileMap::SetChunkRenderCommandShader(RenderCommand* command, LayerRendererType type)
+	{
+		bool shaderChanged = command->material().setShader(ContentResolver::Get().GetShader(type == LayerRendererType::Tinted
+			? PrecompiledShader::TileLayerTinted
+			: PrecompiledShader::TileLayer));
+		if (shaderChanged) {
+			command->material().reserveUniformsDataMemory();
+			command->geometry().setNumElementsPerVertex(ChunkFloatsPerVertex);
+
+			GLUniformCache* textureUniform = command->material().uniform(Material::TextureUniformName);
+			if (textureUniform && textureUniform->intValue(0) != 0) {
+				textureUniform->setIntValue(0); // GL_TEXTURE0
+			}
+		}
+		return shaderChanged;
+	}
+
 	void TileMap::AddTileSet(const StringView& tileSetPath, std::uint16_t offset, std::uint16_t count, const std::uint8_t* paletteRemapping)
 	{
 		auto& tileSetPart = _tileSets.emplace_back();
@@ -905,6 +1113,16 @@ namespace Jazz2::Tiles
 				tile.Alpha = 255;
 			}
 		}
+
+		// All chunks are built by PrepareLayerChunks() before they are drawn for the first time
+		LayerChunks& newChunks = _layerChunks.emplace_back();
+		newChunks.ChunkCount = Vector2i((width + ChunkSize - 1) / ChunkSize, (height + ChunkSize - 1) / ChunkSize);
+		std::int32_t chunkCount = newChunks.ChunkCount.X * newChunks.ChunkCount.Y;
+		newChunks.Chunks = std::make_unique<LayerChunk[]>(chunkCount);
+		for (std::int32_t i = 0; i < chunkCount; i++) {
+			newChunks.Chunks[i].IsDirty = true;
+		}
+		_hasDirtyChunks = true;
 	}
 
 	void TileMap::ReadAnimatedTiles(Stream& s)
@@ -974,6 +1192,8 @@ namespace Jazz2::Tiles
 				SetTileDestructibleEventParams(tile, TileDestructType::Collapse, tileParams[0]);
 				break;
 		}
+
+		InvalidateLayerChunk(_sprLayerIndex, x, y);
 	}
 
 	void TileMap::SetTileDestructibleEventParams(LayerTile& tile, TileDestructType type, std::uint16_t tileParams)
@@ -1087,6 +1307,7 @@ namespace Jazz2::Tiles
 		float x = pos.X - res->Base->Hotspot.X;
 		float y = pos.Y - res->Base->Hotspot.Y;
 		Vector2i texSize = res->Base->TextureDiffuse->size();
+		Vector2i framePos = res->Base->GetFrameTexturePosition(currentFrame);
 
 		for (std::int32_t fy = 0; fy < res->Base->FrameDimensions.Y; fy += DebrisSize + 1) {
 			for (std::int32_t fx = 0; fx < res->Base->FrameDimensions.X; fx += DebrisSize + 1) {
@@ -1111,12 +1332,15 @@ namespace Jazz2::Tiles
 				debris.Time = 320.0f;
 
 				debris.TexScaleX = (currentSize / float(texSize.X));
-				debris.TexBiasX = (((float)(currentFrame % res->Base->FrameConfiguration.X) / res->Base->FrameConfiguration.X) + ((float)fx / float(texSize.X)));
+				debris.TexBiasX = ((float)(framePos.X + fx) / float(texSize.X));
 				debris.TexScaleY = (currentSize / float(texSize.Y));
-				debris.TexBiasY = (((float)(currentFrame / res->Base->FrameConfiguration.X) / res->Base->FrameConfiguration.Y) + ((float)fy / float(texSize.Y)));
+				debris.TexBiasY = ((float)(framePos.Y + fy) / float(texSize.Y));
 
 				debris.DiffuseTexture = res->Base->TextureDiffuse.get();
 				debris.Flags = DebrisFlags::Bounce;
+				if (res->Base->IsIndexed()) {
+					debris.Flags |= DebrisFlags::Indexed;
+				}
 			}
 		}
 	}
@@ -1148,15 +1372,17 @@ namespace Jazz2::Tiles
 			debris.Time = 560.0f;
 
 			std::int32_t curAnimFrame = res->FrameOffset + Random().Next(0, res->FrameCount);
-			std::int32_t col = curAnimFrame % res->Base->FrameConfiguration.X;
-			std::int32_t row = curAnimFrame / res->Base->FrameConfiguration.X;
+			Vector2i framePos = res->Base->GetFrameTexturePosition(curAnimFrame);
 			debris.TexScaleX = (float(res->Base->FrameDimensions.X) / float(texSize.X));
-			debris.TexBiasX = (float(res->Base->FrameDimensions.X * col) / float(texSize.X));
+			debris.TexBiasX = (float(framePos.X) / float(texSize.X));
 			debris.TexScaleY = (float(res->Base->FrameDimensions.Y) / float(texSize.Y));
-			debris.TexBiasY = (float(res->Base->FrameDimensions.Y * row) / float(texSize.Y));
+			debris.TexBiasY = (float(framePos.Y) / float(texSize.Y));
 
 			debris.DiffuseTexture = res->Base->TextureDiffuse.get();
 			debris.Flags = DebrisFlags::Bounce;
+			if (res->Base->IsIndexed()) {
+				debris.Flags |= DebrisFlags::Indexed;
+			}
 		}
 	}
 
@@ -1239,7 +1465,7 @@ namespace Jazz2::Tiles
 	void TileMap::DrawDebris(RenderQueue& renderQueue)
 	{
 		for (auto& debris : _debrisList) {
-			auto command = RentRenderCommand(LayerRendererType::Default);
+			auto command = RentRenderCommand(LayerRendererType::Default, (debris.Flags & DebrisFlags::Indexed) == DebrisFlags::Indexed);
 
 			if ((debris.Flags & DebrisFlags::AdditiveBlending) == DebrisFlags::AdditiveBlending) {
 				command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE);
@@ -1285,6 +1511,7 @@ namespace Jazz2::Tiles
 				if (_animatedTiles[tile.DestructAnimation].Tiles.size() > 1) {
 					tile.DestructFrameIndex = (newState ? 1 : 0);
 					tile.TileID = _animatedTiles[tile.DestructAnimation].Tiles[tile.DestructFrameIndex].TileID;
+					InvalidateLayerChunk(_sprLayerIndex, i % layoutSize.X, i / layoutSize.X);
 				}
 			}
 		}
@@ -1324,6 +1551,30 @@ namespace Jazz2::Tiles
 		if (_texturedBackgroundLayer != -1) {
 			_texturedBackgroundPass.Initialize();
 		}
+
+		PrepareLayerChunks();
+	}
+
+	void TileMap::PrepareLayerChunks()
+	{
+		if (!_hasDirtyChunks) {
+			return;
+		}
+
+		_hasDirtyChunks = false;
+
+		for (std::int32_t i = 0; i < (std::int32_t)_layers.size(); i++) {
+			TileMapLayer& layer = _layers[i];
+			LayerChunks& chunks = _layerChunks[i];
+			for (std::int32_t cy = 0; cy < chunks.ChunkCount.Y; cy++) {
+				for (std::int32_t cx = 0; cx < chunks.ChunkCount.X; cx++) {
+					LayerChunk& chunk = chunks.Chunks[cy * chunks.ChunkCount.X + cx];
+					if (chunk.IsDirty) {
+						RebuildLayerChunk(layer, chunk, cx, cy);
+					}
+				}
+			}
+		}
 	}
 
 	TileSet* TileMap::ResolveTileSet(std::int32_t& tileId)
@@ -1340,6 +1591,21 @@ namespace Jazz2::Tiles
 		return nullptr;
 	}
 
+	std::int32_t TileMap::ResolveTileSetIndex(std::int32_t& tileId)
+	{
+		for (std::int32_t i = 0; i < (std::int32_t)_tileSets.size(); i++) {
+			auto& tileSetPart = _tileSets[i];
+			if (tileId < tileSetPart.Count) {
+				tileId += tileSetPart.Offset;
+				return (tileSetPart.Data != nullptr ? i : -1);
+			}
+
+			tileId -= tileSetPart.Count;
+		}
+
+		return -1;
+	}
+
 	void TileMap::TexturedBackgroundPass::Initialize()
 	{
 		bool notInitialized = (_view == nullptr);
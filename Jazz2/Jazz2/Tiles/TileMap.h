@@ -106,7 +106,9 @@ namespace Jazz2::Tiles
 			None = 0x00,
 			Disappear = 0x01,
 			Bounce = 0x02,
-			AdditiveBlending = 0x04
+			AdditiveBlending = 0x04,
+			// Texture contains palette indices, see GenericGraphicResource::IsIndexed()
+			Indexed = 0x08
 		};
 
 		DEFINE_PRIVATE_ENUM_OPERATORS(DebrisFlags);
@@ -173,6 +175,8 @@ namespace Jazz2::Tiles
 		void SetTrigger(std::uint8_t triggerId, bool newState);
 
 		void OnInitializeViewport();
+		// Rebuilds invalidated layer chunks, it has to be called on the main thread outside of the visit
+		void PrepareLayerChunks();
 
 	private:
 		enum class LayerType {
@@ -187,6 +191,40 @@ namespace Jazz2::Tiles
 			std::int32_t Count;
 		};
 
+		// Static tile layers are split into chunks of ChunkSize×ChunkSize tiles, each chunk has prebuilt vertex buffers
+		// that are rebuilt only if any tile inside changes, animated tiles are patched in place. Chunks are rebuilt
+		// in PrepareLayerChunks() instead of OnDraw(), because the visit can run on a thread without GL context
+		static constexpr std::int32_t ChunkSize = 16;
+		static constexpr std::int32_t ChunkVerticesPerTile = 6;
+		static constexpr std::int32_t ChunkFloatsPerVertex = 4;
+
+		struct ChunkAnimatedTile {
+			std::int32_t LayoutIndex;
+			std::int32_t VertexIndex;
+			std::int32_t LastTileId;
+		};
+
+		struct ChunkPart {
+			std::int32_t TileSetIndex;
+			std::uint8_t Alpha;
+			std::int32_t TileCount;
+			std::int32_t TileCapacity;
+			std::int32_t LastDrawn;
+			std::unique_ptr<float[]> Vertices;
+			std::unique_ptr<RenderCommand> Command;
+			SmallVector<ChunkAnimatedTile, 0> AnimatedTiles;
+		};
+
+		struct LayerChunk {
+			SmallVector<ChunkPart, 1> Parts;
+			bool IsDirty;
+		};
+
+		struct LayerChunks {
+			std::unique_ptr<LayerChunk[]> Chunks;
+			Vector2i ChunkCount;
+		};
+
 		class TexturedBackgroundPass : public SceneNode
 		{
 			friend class TileMap;
@@ -225,13 +263,25 @@ namespace Jazz2::Tiles
 		SmallVector<DestructibleDebris, 0> _debrisList;
 		SmallVector<std::unique_ptr<RenderCommand>, 0> _renderCommands;
 		std::int32_t _renderCommandsCount;
+		SmallVector<LayerChunks, 0> _layerChunks;
+		SmallVector<std::unique_ptr<RenderCommand>, 0> _chunkRenderCommands;
+		std::int32_t _chunkRenderCommandsCount;
+		std::int32_t _chunkDrawCounter;
+		bool _hasDirtyChunks;
 
 		std::int32_t _texturedBackgroundLayer;
 		TexturedBackgroundPass _texturedBackgroundPass;
 
-		void DrawLayer(RenderQueue& renderQueue, TileMapLayer& layer);
+		void DrawLayer(RenderQueue& renderQueue, TileMapLayer& layer, LayerChunks& chunks);
+		void DrawLayerChunk(RenderQueue& renderQueue, TileMapLayer& layer, LayerChunk& chunk, float x, float y, Vector2i viewSize);
+		void RebuildLayerChunk(TileMapLayer& layer, LayerChunk& chunk, std::int32_t cx, std::int32_t cy);
+		bool UpdateLayerChunkAnimatedTiles(TileMapLayer& layer, LayerChunk& chunk);
+		void InvalidateLayerChunk(std::int32_t layerIndex, std::int32_t tx, std::int32_t ty);
+		static void WriteChunkTileVertices(float* vertices, std::int32_t x, std::int32_t y, TileSet* tileSet, std::int32_t tileId, LayerTileFlags flags);
 		static float TranslateCoordinate(float coordinate, float speed, float offset, std::int32_t viewSize, bool isY);
-		RenderCommand* RentRenderCommand(LayerRendererType type);
+		RenderCommand* RentRenderCommand(LayerRendererType type, bool indexed = false);
+		RenderCommand* RentChunkRenderCommand(LayerRendererType type);
+		static bool SetChunkRenderCommandShader(RenderCommand* command, LayerRendererType type);
 
 		bool AdvanceDestructibleTileAnimation(LayerTile& tile, std::int32_t tx, std::int32_t ty, std::int32_t& amount, const StringView& soundName);
 		void AdvanceCollapsingTileTimers(float timeMult);
@@ -243,6 +293,7 @@ namespace Jazz2::Tiles
 		void RenderTexturedBackground(RenderQueue& renderQueue, TileMapLayer& layer, float x, float y);
 
 		TileSet* ResolveTileSet(std::int32_t& tileId);
+		std::int32_t ResolveTileSetIndex(std::int32_t& tileId);
 
 		inline std::int32_t ResolveTileID(LayerTile& tile)
 		{
@@ -15,6 +15,7 @@ namespace Jazz2::Tiles
 		_isMaskEmpty.SetSize(TileCount);
 		_isMaskFilled.SetSize(TileCount);
 		_isTileFilled.SetSize(TileCount);
+		_maskRows = std::make_unique<uint32_t[]>(TileCount * DefaultTileSize);
 
 		//_defaultLayerTiles.reserve(_tileCount);
 		uint32_t maskMaxTiles = maskSize / (DefaultTileSize * DefaultTileSize);
@@ -30,10 +31,14 @@ namespace Jazz2::Tiles
 				//auto pixelOffset = &pixels[(i * Tiles::TileSet::DefaultTileSize * w) + (j * Tiles::TileSet::DefaultTileSize)];
 				if (k < maskMaxTiles) {
 					auto maskOffset = &_mask[k * DefaultTileSize * DefaultTileSize];
+					auto maskRows = &_maskRows[k * DefaultTileSize];
 					for (int x = 0; x < DefaultTileSize * DefaultTileSize; x++) {
 						bool masked = (maskOffset[x] > 0);
 						maskEmpty &= !masked;
 						maskFilled &= masked;
+						if (masked) {
+							maskRows[x / DefaultTileSize] |= (1u << (x % DefaultTileSize));
+						}
 
 						//ColorRgba pxTex = texture[j * DefaultTileSize + x, i * DefaultTileSize + y];
 						//masked = (pxTex.A > 20);
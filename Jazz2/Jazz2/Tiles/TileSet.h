@@ -25,6 +25,27 @@ namespace Jazz2::Tiles
 			return &_mask[tileId * DefaultTileSize * DefaultTileSize];
 		}
 
+		/** @brief Returns true if any masked pixel of the tile lies inside the specified rectangle (inclusive) */
+		bool IsTileMaskOverlapping(int tileId, int left, int top, int right, int bottom) const
+		{
+			if (tileId >= TileCount) {
+				return false;
+			}
+			if (_isMaskFilled[tileId]) {
+				return true;
+			}
+
+			// Each row is packed into one bit per pixel, so the whole row range is tested at once
+			uint32_t columns = (0xFFFFFFFFu >> (DefaultTileSize - 1 - right)) & (0xFFFFFFFFu << left);
+			const uint32_t* rows = &_maskRows[tileId * DefaultTileSize];
+			for (int y = top; y <= bottom; y++) {
+				if ((rows[y] & columns) != 0) {
+					return true;
+				}
+			}
+			return false;
+		}
+
 		bool IsTileMaskEmpty(int tileId) const
 		{
 			if (tileId >= TileCount) {
@@ -58,7 +79,10 @@ namespace Jazz2::Tiles
 		}
 
 	private:
+		static_assert(DefaultTileSize == 32, "Mask rows must fit into 32-bit integer");
+
 		std::unique_ptr<uint8_t[]> _mask;
+		std::unique_ptr<uint32_t[]> _maskRows;
 		std::unique_ptr<Color[]> _captionTile;
 		BitArray _isMaskEmpty;
 		BitArray _isMaskFilled;
@@ -1,4 +1,5 @@
 ﻿#include "Canvas.h"
+#include "../ContentResolver.h"
 
 #include "Graphics/RenderQueue.h"
 #include "Base/Random.h"
@@ -33,19 +34,13 @@ namespace Jazz2::UI
 		_currentRenderQueue->addCommand(command);
 	}
 
-	void Canvas::DrawTexture(const Texture& texture, const Vector2f& pos, uint16_t z, const Vector2f& size, const Vector4f& texCoords, const Colorf& color, bool additiveBlending, float angle)
+	void Canvas::DrawTexture(const Texture& texture, const Vector2f& pos, uint16_t z, const Vector2f& size, const Vector4f& texCoords, const Colorf& color, bool additiveBlending, float angle, bool indexed)
 	{
 		auto command = RentRenderCommand();
-		if (command->material().setShaderProgramType(Material::ShaderProgramType::SPRITE)) {
-			command->material().reserveUniformsDataMemory();
+		if (ContentResolver::Get().ApplySpriteShader(command->material(), indexed)) {
 			command->geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, 4);
 			// Required to reset render command properly
 			command->setTransformation(command->transformation());
-
-			GLUniformCache* textureUniform = command->material().uniform(Material::TextureUniformName);
-			if (textureUniform && textureUniform->intValue(0) != 0) {
-				textureUniform->setIntValue(0); // GL_TEXTURE0
-			}
 		}
 
 		if (additiveBlending) {
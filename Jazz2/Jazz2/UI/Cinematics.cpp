@@ -9,13 +9,12 @@
 #include "Input/IInputManager.h"
 #include "Audio/AudioReaderMpt.h"
 #include "Base/FrameTimer.h"
-#include "IO/CompressionUtils.h"
 
 namespace Jazz2::UI
 {
 	Cinematics::Cinematics(IRootController* root, const String& path, const std::function<bool(IRootController*, bool)>& callback)
 		: _root(root), _callback(callback), _frameDelay(0.0f), _frameProgress(0.0f), _framesLeft(0),
-			_currentOffsets { }, _pressedKeys((uint32_t)KeySym::COUNT), _pressedActions(0)
+			_pressedKeys((uint32_t)KeySym::COUNT), _pressedActions(0)
 	{
 		theApplication().gfxDevice().setWindowTitle("Jazz² Resurrection"_s);
 
@@ -158,38 +157,33 @@ namespace Jazz2::UI
 		_currentFrame = std::make_unique<uint32_t[]>(_width * _height);
 
 		// Read all 4 compressed streams
-		SmallVector<uint8_t, 0> compressedStreams[countof(_decompressedStreams)];
-		uint32_t currentOffsets[countof(_decompressedStreams)] { };
+		uint32_t currentOffsets[countof(_compressedStreams)] { };
 		uint32_t totalOffset = s->GetPosition();
 
 		while (totalOffset < s->GetSize()) {
-			for (int32_t i = 0; i < countof(_decompressedStreams); i++) {
+			for (int32_t i = 0; i < countof(_compressedStreams); i++) {
 				uint32_t bytesLeft = s->ReadValue<uint32_t>();
 				totalOffset += 4 + bytesLeft;
 
-				compressedStreams[i].resize_for_overwrite(currentOffsets[i] + bytesLeft);
+				_compressedStreams[i].resize_for_overwrite(currentOffsets[i] + bytesLeft);
 
 				while (bytesLeft > 0) {
-					uint32_t bytesRead = s->Read(&compressedStreams[i][currentOffsets[i]], bytesLeft);
+					uint32_t bytesRead = s->Read(&_compressedStreams[i][currentOffsets[i]], bytesLeft);
 					currentOffsets[i] += bytesRead;
 					bytesLeft -= bytesRead;
 				}
 			}
 		}
 
-		for (int32_t i = 0; i < countof(_decompressedStreams); i++) {
-			// Stream 3 contains pixel data and is probably compressed with higher ratio
-			_decompressedStreams[i].resize_for_overwrite(currentOffsets[i] * (i == 3 ? 8 : 3));
-
-		Retry:
-			int32_t compressedSize = currentOffsets[i] - 2;
-			int32_t decompressedSize = _decompressedStreams[i].size();
-			auto result = CompressionUtils::Inflate(compressedStreams[i].begin() + 2, compressedSize, _decompressedStreams[i].begin(), decompressedSize);
-			if (result == DecompressionResult::BufferTooSmall) {
-				_decompressedStreams[i].resize_for_overwrite(_decompressedStreams[i].size() * 2);
-				LOGI("Cinematics stream %i was larger than expected, resizing buffer to %i", i, _decompressedStreams[i].size());
-				goto Retry;
+		for (int32_t i = 0; i < countof(_compressedStreams); i++) {
+			if (currentOffsets[i] < 2) {
+				return false;
 			}
+
+			// Skip zlib header, the rest is raw Deflate data
+			_compressedReaders[i] = std::make_unique<MemoryStream>((const uint8_t*)_compressedStreams[i].data(), (int32_t)currentOffsets[i]);
+			_compressedReaders[i]->Seek(2, SeekOrigin::Begin);
+			_decompressedStreams[i] = std::make_unique<DeflateStream>(*_compressedReaders[i], (int32_t)currentOffsets[i] - 2);
 		}
 
 		return true;
@@ -293,15 +287,26 @@ namespace Jazz2::UI
 		if (textureUniform && textureUniform->intValue(0) != 0) {
 			textureUniform->setIntValue(0); // GL_TEXTURE0
 		}
+
+		for (auto& command : _progressCommands) {
+			command.material().setShaderProgramType(Material::ShaderProgramType::SPRITE_NO_TEXTURE);
+			command.material().setBlendingEnabled(true);
+			command.material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			command.material().reserveUniformsDataMemory();
+			command.geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, 4);
+			command.setLayer(1);
+		}
 	}
 
 	bool Cinematics::CinematicsCanvas::OnDraw(RenderQueue& renderQueue)
 	{
+		Vector2i viewSize = _owner->_upscalePass.GetViewSize();
+		bool progressDrawn = DrawRefreshCacheProgress(renderQueue, viewSize);
+
 		if (_owner->_frameDelay == 0.0f) {
-			return false;
+			return progressDrawn;
 		}
 
-		Vector2i viewSize = _owner->_upscalePass.GetViewSize();
 		float ratioTarget = (float)viewSize.Y / viewSize.X;
 		float ratioSource = (float)_owner->_height / _owner->_width;
 
@@ -330,4 +335,35 @@ namespace Jazz2::UI
 
 		return true;
 	}
+
+	bool Cinematics::CinematicsCanvas::DrawRefreshCacheProgress(RenderQueue& renderQueue, const Vector2i& viewSize)
+	{
+		// Cache is refreshed while the intro is playing, so the progress is shown until it's done
+		if (_owner->_callback == nullptr || (_owner->_root->GetFlags() & IRootController::Flags::IsVerified) == IRootController::Flags::IsVerified) {
+			return false;
+		}
+		float progress = _owner->_root->GetRefreshCacheProgress();
+		if (progress <= 0.0f) {
+			return false;
+		}
+
+		constexpr float BarHeight = 2.0f;
+		float barWidth = viewSize.X * 0.5f;
+		float filledWidth = barWidth * std::min(progress, 1.0f);
+		float y = viewSize.Y * -0.5f + 8.0f;
+
+		const Vector2f sizes[] = { Vector2f(barWidth, BarHeight), Vector2f(filledWidth, BarHeight) };
+		const Colorf colors[] = { Colorf(1.0f, 1.0f, 1.0f, 0.2f), Colorf(1.0f, 1.0f, 1.0f, 0.7f) };
+		for (int32_t i = 0; i < (int32_t)countof(_progressCommands); i++) {
+			auto instanceBlock = _progressCommands[i].material().uniformBlock(Material::InstanceBlockName);
+			instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatVector(sizes[i].Data());
+			instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(colors[i].Data());
+
+			// Sprites are centered, so the filled part is shifted to start at the left edge of the track
+			_progressCommands[i].setTransformation(Matrix4x4f::Translation((sizes[i].X - barWidth) * 0.5f, y, 0.0f));
+			renderQueue.addCommand(&_progressCommands[i]);
+		}
+
+		return true;
+	}
 }
\ No newline at end of file
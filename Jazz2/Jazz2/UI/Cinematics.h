@@ -11,6 +11,9 @@
 #include "Input/InputEvents.h"
 #include "Audio/AudioStreamPlayer.h"
 
+#include <IO/DeflateStream.h>
+#include <IO/MemoryStream.h>
+
 #include <functional>
 
 namespace Jazz2::UI
@@ -50,6 +53,10 @@ namespace Jazz2::UI
 		private:
 			Cinematics* _owner;
 			RenderCommand _renderCommand;
+			// Track and filled part of the progress bar
+			RenderCommand _progressCommands[2];
+
+			bool DrawRefreshCacheProgress(RenderQueue& renderQueue, const Vector2i& viewSize);
 		};
 
 		UI::UpscaleRenderPass _upscalePass;
@@ -64,8 +71,10 @@ namespace Jazz2::UI
 		std::unique_ptr<uint8_t[]> _lastBuffer;
 		std::unique_ptr<uint32_t[]> _currentFrame;
 		uint32_t _palette[256];
-		SmallVector<uint8_t, 0> _decompressedStreams[4];
-		uint32_t _currentOffsets[countof(_decompressedStreams)];
+		// Only compressed streams are kept in memory, frames are decompressed as they are played
+		SmallVector<uint8_t, 0> _compressedStreams[4];
+		std::unique_ptr<MemoryStream> _compressedReaders[countof(_compressedStreams)];
+		std::unique_ptr<DeflateStream> _decompressedStreams[countof(_compressedStreams)];
 
 		BitArray _pressedKeys;
 		uint32_t _pressedActions;
@@ -75,12 +84,10 @@ namespace Jazz2::UI
 		void UpdatePressedActions();
 
 		inline void Read(int streamIndex, void* buffer, uint32_t bytes) {
-			if (_currentOffsets[streamIndex] + bytes > _decompressedStreams[streamIndex].size()) {
-				memset(buffer, 0, bytes);
-			} else {
-				memcpy(buffer, &_decompressedStreams[streamIndex][_currentOffsets[streamIndex]], bytes);
+			int32_t bytesRead = _decompressedStreams[streamIndex]->Read(buffer, bytes);
+			if (bytesRead < (int32_t)bytes) {
+				memset((uint8_t*)buffer + bytesRead, 0, bytes - bytesRead);
 			}
-			_currentOffsets[streamIndex] += bytes;
 		}
 
 		template<typename T>
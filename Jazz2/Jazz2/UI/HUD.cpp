@@ -351,7 +351,7 @@ namespace Jazz2::UI
 					x = x - ViewSize.X * 0.5f;
 					y = ViewSize.Y * 0.5f - y;
 
-					DrawTexture(*button.Graphics->Base->TextureDiffuse, Vector2f(x, y), TouchButtonsLayer, Vector2f(button.Width, button.Height), Vector4f(1.0f, 0.0f, -1.0f, 1.0f), Colorf::White);
+					DrawTexture(*button.Graphics->Base->TextureDiffuse, Vector2f(x, y), TouchButtonsLayer, Vector2f(button.Width, button.Height), button.Graphics->Base->RemapTexCoords(Vector4f(1.0f, 0.0f, -1.0f, 1.0f)), Colorf::White, false, 0.0f, button.Graphics->Base->IsIndexed());
 				}
 			}
 		}
@@ -665,19 +665,18 @@ namespace Jazz2::UI
 		Vector2f adjustedPos = ApplyAlignment(align, Vector2f(x - ViewSize.X * 0.5f, ViewSize.Y * 0.5f - y), size);
 
 		Vector2i texSize = base->TextureDiffuse->size();
-		int32_t col = frame % base->FrameConfiguration.X;
-		int32_t row = frame / base->FrameConfiguration.X;
+		Vector2i framePos = base->GetFrameTexturePosition(frame);
 		Vector4f texCoords = Vector4f(
 			float(base->FrameDimensions.X) / float(texSize.X),
-			float(base->FrameDimensions.X * col) / float(texSize.X),
+			float(framePos.X) / float(texSize.X),
 			float(base->FrameDimensions.Y) / float(texSize.Y),
-			float(base->FrameDimensions.Y * row) / float(texSize.Y)
+			float(framePos.Y) / float(texSize.Y)
 		);
 
 		texCoords.W += texCoords.Z;
 		texCoords.Z *= -1;
 
-		DrawTexture(*base->TextureDiffuse.get(), adjustedPos, z, size, texCoords, color, additiveBlending, angle);
+		DrawTexture(*base->TextureDiffuse.get(), adjustedPos, z, size, texCoords, color, additiveBlending, angle, base->IsIndexed());
 	}
 
 	void HUD::DrawElementClipped(const StringView& name, int32_t frame, float x, float y, uint16_t z, Alignment align, const Colorf& color, float clipX, float clipY)
@@ -697,13 +696,12 @@ namespace Jazz2::UI
 			ViewSize.Y * 0.5f - y - (1.0f - clipY) * 0.5f * base->FrameDimensions.Y), size);
 
 		Vector2i texSize = base->TextureDiffuse->size();
-		int32_t col = frame % base->FrameConfiguration.X;
-		int32_t row = frame / base->FrameConfiguration.X;
+		Vector2i framePos = base->GetFrameTexturePosition(frame);
 		Vector4f texCoords = Vector4f(
 			float(base->FrameDimensions.X) / float(texSize.X),
-			float(base->FrameDimensions.X * col) / float(texSize.X),
+			float(framePos.X) / float(texSize.X),
 			float(base->FrameDimensions.Y) / float(texSize.Y),
-			float(base->FrameDimensions.Y * row) / float(texSize.Y)
+			float(framePos.Y) / float(texSize.Y)
 		);
 
 		texCoords.X *= clipX;
@@ -712,7 +710,7 @@ namespace Jazz2::UI
 		texCoords.W += texCoords.Z;
 		texCoords.Z *= -1;
 
-		DrawTexture(*base->TextureDiffuse.get(), adjustedPos, z, size, texCoords, color);
+		DrawTexture(*base->TextureDiffuse.get(), adjustedPos, z, size, texCoords, color, false, 0.0f, base->IsIndexed());
 	}
 
 	StringView HUD::GetCurrentWeapon(Actors::Player* player, WeaponType weapon, Vector2f& offset)
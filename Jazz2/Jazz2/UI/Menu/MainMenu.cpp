@@ -363,19 +363,18 @@ namespace Jazz2::UI::Menu
 		Vector2f adjustedPos = Canvas::ApplyAlignment(align, Vector2f(x - currentCanvas->ViewSize.X * 0.5f, currentCanvas->ViewSize.Y * 0.5f - y), size);
 
 		Vector2i texSize = base->TextureDiffuse->size();
-		int32_t col = frame % base->FrameConfiguration.X;
-		int32_t row = frame / base->FrameConfiguration.X;
+		Vector2i framePos = base->GetFrameTexturePosition(frame);
 		Vector4f texCoords = Vector4f(
 			float(base->FrameDimensions.X) / float(texSize.X),
-			float(base->FrameDimensions.X * col) / float(texSize.X),
+			float(framePos.X) / float(texSize.X),
 			float(base->FrameDimensions.Y) / float(texSize.Y),
-			float(base->FrameDimensions.Y * row) / float(texSize.Y)
+			float(framePos.Y) / float(texSize.Y)
 		);
 
 		texCoords.W += texCoords.Z;
 		texCoords.Z *= -1;
 		
-		currentCanvas->DrawTexture(*base->TextureDiffuse.get(), adjustedPos, z, size, texCoords, color, additiveBlending);
+		currentCanvas->DrawTexture(*base->TextureDiffuse.get(), adjustedPos, z, size, texCoords, color, additiveBlending, 0.0f, base->IsIndexed());
 	}
 
 	void MainMenu::DrawElement(const StringView& name, float x, float y, uint16_t z, Alignment align, const Colorf& color, const Vector2f& size, const Vector4f& texCoords)
@@ -389,7 +388,7 @@ namespace Jazz2::UI::Menu
 		GenericGraphicResource* base = it->second.Base;
 		Vector2f adjustedPos = Canvas::ApplyAlignment(align, Vector2f(x - currentCanvas->ViewSize.X * 0.5f, currentCanvas->ViewSize.Y * 0.5f - y), size);
 
-		currentCanvas->DrawTexture(*base->TextureDiffuse.get(), adjustedPos, z, size, texCoords, color, false);
+		currentCanvas->DrawTexture(*base->TextureDiffuse.get(), adjustedPos, z, size, base->RemapTexCoords(texCoords), color, false, 0.0f, base->IsIndexed());
 	}
 
 	void MainMenu::DrawSolid(float x, float y, uint16_t z, Alignment align, const Vector2f& size, const Colorf& color, bool additiveBlending)
@@ -429,7 +428,7 @@ namespace Jazz2::UI::Menu
 		auto it = _sounds->find(String::nullTerminatedView(identifier));
 		if (it != _sounds->end()) {
 			int32_t idx = (it->second.Buffers.size() > 1 ? Random().Next(0, (int32_t)it->second.Buffers.size()) : 0);
-			auto& player = _playingSounds.emplace_back(std::make_shared<AudioBufferPlayer>(it->second.Buffers[idx].get()));
+			auto& player = _playingSounds.emplace_back(std::make_shared<AudioBufferPlayer>(&it->second.Buffers[idx]->Buffer));
 			player->setPosition(Vector3f(0.0f, 0.0f, 100.0f));
 			player->setGain(gain * PreferencesCache::MasterVolume * PreferencesCache::SfxVolume);
 			player->setSourceRelative(true);
@@ -588,14 +587,16 @@ namespace Jazz2::UI::Menu
 					debris.Time = 160.0f;
 
 					int32_t curAnimFrame = it->second.FrameOffset + Random().Next(0, it->second.FrameCount);
-					int32_t col = curAnimFrame % resBase->FrameConfiguration.X;
-					int32_t row = curAnimFrame / resBase->FrameConfiguration.X;
+					Vector2i framePos = resBase->GetFrameTexturePosition(curAnimFrame);
 					debris.TexScaleX = (float(resBase->FrameDimensions.X) / float(texSize.X));
-					debris.TexBiasX = (float(resBase->FrameDimensions.X * col) / float(texSize.X));
+					debris.TexBiasX = (float(framePos.X) / float(texSize.X));
 					debris.TexScaleY = (float(resBase->FrameDimensions.Y) / float(texSize.Y));
-					debris.TexBiasY = (float(resBase->FrameDimensions.Y * row) / float(texSize.Y));
+					debris.TexBiasY = (float(framePos.Y) / float(texSize.Y));
 
 					debris.DiffuseTexture = resBase->TextureDiffuse.get();
+					if (resBase->IsIndexed()) {
+						debris.Flags |= TileMap::DebrisFlags::Indexed;
+					}
 
 					_debrisList.push_back(debris);
 				}
@@ -639,16 +640,10 @@ namespace Jazz2::UI::Menu
 	{
 		for (auto& debris : _debrisList) {
 			auto command = _canvasOverlay->RentRenderCommand();
-			if (command->material().setShaderProgramType(Material::ShaderProgramType::SPRITE)) {
-				command->material().reserveUniformsDataMemory();
+			if (ContentResolver::Get().ApplySpriteShader(command->material(), (debris.Flags & TileMap::DebrisFlags::Indexed) == TileMap::DebrisFlags::Indexed)) {
 				command->geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, 4);
 				// Required to reset render command properly
 				command->setTransformation(command->transformation());
-
-				GLUniformCache* textureUniform = command->material().uniform(Material::TextureUniformName);
-				if (textureUniform && textureUniform->intValue(0) != 0) {
-					textureUniform->setIntValue(0); // GL_TEXTURE0
-				}
 			}
 
 			command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
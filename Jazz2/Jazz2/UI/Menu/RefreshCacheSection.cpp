@@ -10,7 +10,7 @@
 namespace Jazz2::UI::Menu
 {
 	RefreshCacheSection::RefreshCacheSection()
-		: _animation(0.0f), _done(false)
+		: _animation(0.0f), _progress(0.0f), _done(false)
 	{
 	}
 
@@ -39,6 +39,9 @@ namespace Jazz2::UI::Menu
 		if (_animation < 1.0f) {
 			_animation = std::min(_animation + timeMult * 0.016f, 1.0f);
 		}
+		if (auto mainMenu = dynamic_cast<MainMenu*>(_root)) {
+			_progress = mainMenu->_root->GetRefreshCacheProgress();
+		}
 		if (_done) {
 			_root->PlaySfx("MenuSelect"_s, 0.5f);
 			_root->LeaveSection();
@@ -68,6 +71,11 @@ namespace Jazz2::UI::Menu
 
 		_root->DrawStringShadow(_("Newly added levels and episodes will be available soon."), charOffset, center.X, center.Y + 24.0f, IMenuContainer::FontLayer,
 			Alignment::Top, Font::DefaultColor, 0.8f, 0.7f, 1.1f, 1.1f, 0.4f, 0.9f);
+
+		char progressText[16];
+		formatString(progressText, sizeof(progressText), "%i%%", (int32_t)(_progress * 100.0f));
+		_root->DrawStringShadow(progressText, charOffset, center.X, center.Y + 60.0f, IMenuContainer::FontLayer,
+			Alignment::Center, Font::DefaultColor, 0.8f, 0.7f, 1.1f, 1.1f, 0.4f, 0.9f);
 	}
 
 	void RefreshCacheSection::OnTouchEvent(const nCine::TouchEvent& event, const Vector2i& viewSize)
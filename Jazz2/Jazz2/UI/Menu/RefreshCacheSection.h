@@ -22,6 +22,7 @@ namespace Jazz2::UI::Menu
 
 	private:
 		float _animation;
+		float _progress;
 		bool _done;
 #if defined(WITH_THREADS)
 		Thread _thread;
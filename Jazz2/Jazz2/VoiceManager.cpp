@@ -0,0 +1,296 @@
+﻿#include "VoiceManager.h"
+
+#include "ServiceLocator.h"
+#include "Base/FrameTimer.h"
+
+#include <cmath>
+
+namespace Jazz2
+{
+	VoiceManager::VoiceManager()
+		: _culledCount(0), _peakActiveCount(0), _peakVirtualCount(0), _isPaused(false)
+	{
+	}
+
+	std::shared_ptr<AudioBufferPlayer> VoiceManager::Play(const SoundResource* resource, AudioBuffer* buffer, const Vector3f& pos, bool sourceRelative, float gain, float pitch, float lowPass)
+	{
+		// Many instances of the same sound at once (e.g. coins collected in one frame) are indistinguishable anyway,
+		// looping sounds are held by their owners (e.g. each enemy has its own noise), so they are not limited
+		int32_t maxInstances = (resource->MaxInstances > 0 ? resource->MaxInstances : DefaultMaxInstances);
+		int32_t instanceCount = 0;
+		for (auto& voice : _voices) {
+			if (voice.Resource == resource && !voice.Player->isLooping()) {
+				instanceCount++;
+			}
+		}
+		if (instanceCount >= maxInstances) {
+			_culledCount++;
+			return nullptr;
+		}
+
+		std::shared_ptr<AudioBufferPlayer> player;
+		if (!_pool.empty()) {
+			player = std::move(_pool.back());
+			_pool.pop_back();
+			player->setAudioBuffer(buffer);
+			player->setLooping(false);
+		} else {
+			player = std::make_shared<AudioBufferPlayer>(buffer);
+		}
+		player->setPosition(pos);
+		player->setGain(gain);
+		player->setPitch(pitch);
+		player->setLowPass(lowPass);
+		player->setSourceRelative(sourceRelative);
+
+		Voice& voice = _voices.emplace_back();
+		voice.Player = player;
+		voice.Resource = resource;
+		voice.Elapsed = 0.0f;
+		voice.IsVirtual = true;
+
+		// Voice stays virtual if it's out of range or all sources are used by more important voices
+		if (IsAudible(voice) && (HasFreeSource() || TryStealSource(GetScore(voice)))) {
+			MakeActive(voice);
+		}
+
+		UpdatePeakCounts();
+		return player;
+	}
+
+	void VoiceManager::Update(float timeMult, const Vector2f& listenerPos)
+	{
+		_listenerPos = listenerPos;
+
+		if (_isPaused) {
+			return;
+		}
+
+		float timeElapsed = timeMult / FrameTimer::FramesPerSecond;
+
+		for (int32_t i = (int32_t)_voices.size() - 1; i >= 0; i--) {
+			Voice& voice = _voices[i];
+			if (!voice.IsVirtual) {
+				if (voice.Player->isStopped()) {
+					// Finished playing or stopped by the owner
+					RemoveVoice(i);
+				} else if (!IsAudible(voice)) {
+					// Moved out of range by the owner, so the source can be used by another voice
+					MakeVirtual(voice);
+				}
+				continue;
+			}
+
+			if (voice.Player->isPlaying()) {
+				// Restarted by the owner, it keeps the source only if the manager would assign one to it too
+				IAudioDevice& device = theServiceLocator().audioDevice();
+				if (IsAudible(voice) && device.numPlayers() + ReservedSources <= device.maxNumPlayers()) {
+					voice.Elapsed = 0.0f;
+					voice.IsVirtual = false;
+				} else {
+					MakeVirtual(voice);
+				}
+				continue;
+			}
+
+			voice.Elapsed += timeElapsed * voice.Player->pitch();
+
+			if (voice.Player->isLooping()) {
+				// Looping sounds are stopped and released by the owner, so the voice is held only here
+				if (voice.Player.use_count() <= 1) {
+					RemoveVoice(i);
+				}
+			} else if (voice.Elapsed >= voice.Player->duration()) {
+				// The sound would already end, so it's dropped without being heard
+				_culledCount++;
+				RemoveVoice(i);
+			}
+		}
+
+		// Assign sources to the most important virtual voices first
+		while (true) {
+			int32_t bestIndex = -1;
+			float bestScore = 0.0f;
+			for (int32_t i = 0; i < (int32_t)_voices.size(); i++) {
+				Voice& voice = _voices[i];
+				if (voice.IsVirtual && IsAudible(voice)) {
+					float score = GetScore(voice);
+					if (bestIndex < 0 || score > bestScore) {
+						bestIndex = i;
+						bestScore = score;
+					}
+				}
+			}
+
+			if (bestIndex < 0 || (!HasFreeSource() && !TryStealSource(bestScore - StealThreshold))) {
+				break;
+			}
+
+			Voice& voice = _voices[bestIndex];
+			MakeActive(voice);
+			if (voice.IsVirtual) {
+				// The source couldn't be acquired
+				break;
+			}
+		}
+
+		UpdatePeakCounts();
+	}
+
+	void VoiceManager::Pause()
+	{
+		_isPaused = true;
+
+		for (auto& voice : _voices) {
+			if (voice.Player->isPlaying()) {
+				voice.Player->pause();
+			}
+		}
+	}
+
+	void VoiceManager::Resume()
+	{
+		_isPaused = false;
+
+		for (auto& voice : _voices) {
+			if (voice.Player->isPaused()) {
+				voice.Player->play();
+			}
+		}
+	}
+
+	void VoiceManager::Clear()
+	{
+		for (auto& voice : _voices) {
+			voice.Player->stop();
+		}
+		_voices.clear();
+		_pool.clear();
+	}
+
+	int32_t VoiceManager::GetActiveCount() const
+	{
+		int32_t count = 0;
+		for (auto& voice : _voices) {
+			if (!voice.IsVirtual) {
+				count++;
+			}
+		}
+		return count;
+	}
+
+	int32_t VoiceManager::GetVirtualCount() const
+	{
+		return (int32_t)_voices.size() - GetActiveCount();
+	}
+
+	void VoiceManager::LogStatistics() const
+	{
+		LOGI("Voice manager used up to %i active and %i virtual voices, %i sounds were culled", _peakActiveCount, _peakVirtualCount, _culledCount);
+	}
+
+	float VoiceManager::GetScore(const Voice& voice) const
+	{
+		// Priority of the sound always takes precedence, audibility is used to order voices with the same priority
+		float audibility = voice.Player->gain();
+		if (!voice.Player->isSourceRelative()) {
+			Vector3f pos = voice.Player->position();
+			float distance = (Vector2f(pos.X, pos.Y) - _listenerPos).Length();
+			audibility *= std::max(1.0f - distance / MaxAudibleDistance, 0.0f);
+		}
+		return (float)voice.Resource->Priority + std::min(audibility, 1.0f);
+	}
+
+	bool VoiceManager::IsAudible(const Voice& voice) const
+	{
+		if (voice.Player->isSourceRelative()) {
+			return true;
+		}
+
+		Vector3f pos = voice.Player->position();
+		return ((Vector2f(pos.X, pos.Y) - _listenerPos).SqrLength() < MaxAudibleDistance * MaxAudibleDistance);
+	}
+
+	bool VoiceManager::HasFreeSource() const
+	{
+		IAudioDevice& device = theServiceLocator().audioDevice();
+		return (device.numPlayers() + ReservedSources < device.maxNumPlayers());
+	}
+
+	bool VoiceManager::TryStealSource(float score)
+	{
+		Voice* weakest = nullptr;
+		float weakestScore = score;
+		for (auto& voice : _voices) {
+			if (!voice.IsVirtual && voice.Player->isPlaying()) {
+				float voiceScore = GetScore(voice);
+				if (voiceScore < weakestScore) {
+					weakest = &voice;
+					weakestScore = voiceScore;
+				}
+			}
+		}
+
+		if (weakest == nullptr) {
+			return false;
+		}
+
+		MakeVirtual(*weakest);
+		return true;
+	}
+
+	void VoiceManager::MakeActive(Voice& voice)
+	{
+		// Continue from where the sound would be if it was playing all the time, the offset is applied before the source starts
+		float offset = voice.Elapsed;
+		float duration = voice.Player->duration();
+		if (voice.Player->isLooping() && duration > 0.0f) {
+			offset = std::fmod(offset, duration);
+		}
+
+		voice.Player->playFrom((int32_t)(offset * voice.Player->frequency()));
+		if (voice.Player->isPlaying()) {
+			voice.IsVirtual = false;
+		}
+	}
+
+	void VoiceManager::MakeVirtual(Voice& voice)
+	{
+		if (voice.Player->isPlaying() || voice.Player->isPaused()) {
+			int32_t frequency = voice.Player->frequency();
+			if (frequency > 0) {
+				voice.Elapsed = (float)voice.Player->sampleOffset() / frequency;
+			}
+			voice.Player->stop();
+		}
+
+		voice.IsVirtual = true;
+	}
+
+	void VoiceManager::RemoveVoice(int32_t index)
+	{
+		Voice& voice = _voices[index];
+		// Players still referenced by the owner can't be reused
+		if (voice.Player.use_count() == 1 && _pool.size() < MaxPooledPlayers) {
+			_pool.push_back(std::move(voice.Player));
+		}
+
+		int32_t lastIndex = (int32_t)_voices.size() - 1;
+		if (index != lastIndex) {
+			_voices[index] = std::move(_voices[lastIndex]);
+		}
+		_voices.pop_back();
+	}
+
+	void VoiceManager::UpdatePeakCounts()
+	{
+		int32_t activeCount = GetActiveCount();
+		int32_t virtualCount = (int32_t)_voices.size() - activeCount;
+		if (_peakActiveCount < activeCount) {
+			_peakActiveCount = activeCount;
+		}
+		if (_peakVirtualCount < virtualCount) {
+			_peakVirtualCount = virtualCount;
+		}
+	}
+}
@@ -0,0 +1,91 @@
+﻿#pragma once
+
+#include "../Common.h"
+#include "ContentResolver.h"
+
+#include "Audio/AudioBufferPlayer.h"
+#include "Audio/IAudioDevice.h"
+
+#include <memory>
+
+#include <Containers/SmallVector.h>
+
+using namespace Death::Containers;
+using namespace nCine;
+
+namespace Jazz2
+{
+	/** @brief Plays sound effects of a level with limited number of audio sources, sounds without a source are tracked as virtual voices */
+	class VoiceManager
+	{
+	public:
+		// Sources left for music and sounds which are not played through this class
+		static constexpr int32_t ReservedSources = 6;
+		// Used if the sound doesn't specify its own limit, looping sounds are not limited
+		static constexpr int32_t DefaultMaxInstances = 4;
+		static constexpr int32_t MaxPooledPlayers = 32;
+		// Positional sounds are silent beyond this distance because of the linear distance model
+		static constexpr float MaxAudibleDistance = IAudioDevice::MaxDistance / IAudioDevice::LengthToPhysical;
+		// Virtual voice must be this much more important to take a source from an active one, so voices don't swap every frame
+		static constexpr float StealThreshold = 0.5f;
+
+		VoiceManager();
+
+		VoiceManager(const VoiceManager&) = delete;
+		VoiceManager& operator=(const VoiceManager&) = delete;
+
+		/**
+			@brief Plays a sound, returns `nullptr` if too many instances of the same sound are already playing
+
+			The owner can stop, restart or make the returned player looping. A restarted virtual voice is adopted back
+			in the next @ref Update() if there is a source for it, otherwise it's virtualized again.
+		*/
+		std::shared_ptr<AudioBufferPlayer> Play(const SoundResource* resource, AudioBuffer* buffer, const Vector3f& pos, bool sourceRelative, float gain, float pitch, float lowPass);
+		/** @brief Releases finished voices and assigns free sources to the most important virtual voices */
+		void Update(float timeMult, const Vector2f& listenerPos);
+		/** @brief Pauses all active voices, virtual voices are not updated until resumed */
+		void Pause();
+		/** @brief Resumes all paused voices */
+		void Resume();
+		/** @brief Stops and releases all voices */
+		void Clear();
+
+		/** @brief Returns number of voices with an audio source */
+		int32_t GetActiveCount() const;
+		/** @brief Returns number of voices waiting for an audio source */
+		int32_t GetVirtualCount() const;
+		/** @brief Returns number of sounds which were rejected or expired without an audio source */
+		int32_t GetCulledCount() const {
+			return _culledCount;
+		}
+		/** @brief Logs voice counters */
+		void LogStatistics() const;
+
+	private:
+		struct Voice {
+			std::shared_ptr<AudioBufferPlayer> Player;
+			const SoundResource* Resource;
+			// Playback position in seconds, it's advanced only while the voice is virtual
+			float Elapsed;
+			bool IsVirtual;
+		};
+
+		SmallVector<Voice, 0> _voices;
+		SmallVector<std::shared_ptr<AudioBufferPlayer>, 0> _pool;
+		Vector2f _listenerPos;
+		int32_t _culledCount;
+		int32_t _peakActiveCount;
+		int32_t _peakVirtualCount;
+		bool _isPaused;
+
+		float GetScore(const Voice& voice) const;
+		bool IsAudible(const Voice& voice) const;
+		bool HasFreeSource() const;
+		/** @brief Virtualizes the least important active voice if its score is lower than the specified one */
+		bool TryStealSource(float score);
+		void MakeActive(Voice& voice);
+		void MakeVirtual(Voice& voice);
+		void RemoveVoice(int32_t index);
+		void UpdatePeakCounts();
+	};
+}
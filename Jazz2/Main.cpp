@@ -15,11 +15,16 @@
 #include "IAppEventHandler.h"
 #include "Graphics/BinaryShaderCache.h"
 #include "Graphics/RenderResources.h"
+#include "Base/FrameTimer.h"
+#include "Base/HashFunctions.h"
+#include "Base/Random.h"
 #include "Input/IInputEventHandler.h"
+#include "Threading/Atomic.h"
 #include "Threading/Thread.h"
 
 #include "Jazz2/IRootController.h"
 #include "Jazz2/ContentResolver.h"
+#include "Jazz2/InputRecording.h"
 #include "Jazz2/LevelHandler.h"
 #include "Jazz2/PreferencesCache.h"
 #include "Jazz2/UI/Cinematics.h"
@@ -27,6 +32,7 @@
 #include "Jazz2/UI/Menu/MainMenu.h"
 #include "Jazz2/UI/Menu/SimpleMessageSection.h"
 
+#include "Jazz2/Compatibility/ConversionTasks.h"
 #include "Jazz2/Compatibility/JJ2Anims.h"
 #include "Jazz2/Compatibility/JJ2Episode.h"
 #include "Jazz2/Compatibility/JJ2Level.h"
@@ -46,6 +52,8 @@
 #	include <cstdlib> // for `__argc` and `__argv`
 #endif
 
+#include <cfloat>
+
 #include <Cpu.h>
 #include <Environment.h>
 #include <IO/FileSystem.h>
@@ -65,6 +73,13 @@ enum class PendingState {
 	LevelChange
 };
 
+enum class InputRecordingState {
+	None,
+	Pending,
+	Active,
+	Finished
+};
+
 class GameEventHandler : public IAppEventHandler, public IInputEventHandler, public Jazz2::IRootController
 {
 public:
@@ -75,6 +90,7 @@ public:
 	void OnInit() override;
 	void OnFrameStart() override;
 	void OnPostUpdate() override;
+	void OnInterpolateFrame(float factor) override;
 	void OnResizeWindow(int width, int height) override;
 	void OnShutdown() override;
 	void OnSuspend() override;
@@ -101,16 +117,57 @@ public:
 	void RefreshCacheLevels() override { }
 #endif
 
+	float GetRefreshCacheProgress() const override {
+		return _refreshCacheProgress.load(Atomic32::MemoryModel::RELAXED) / 1000.0f;
+	}
+
 private:
 	Flags _flags;
+	// Progress of the currently running conversion in per-mille, it's updated from the thread which refreshes the cache
+	// and only displayed on the main thread, so no other data depend on it
+	mutable Atomic32 _refreshCacheProgress;
 	std::unique_ptr<Jazz2::IStateHandler> _currentHandler;
 	PendingState _pendingState;
 	std::unique_ptr<LevelInitialization> _pendingLevelChange;
 	char _newestVersion[20];
 
+	std::unique_ptr<InputRecording> _inputRecording;
+	InputRecordingState _inputRecordingState;
+	TimeStamp _benchmarkStartTime;
+	TimeStamp _benchmarkPhaseStartTime;
+	uint32_t _benchmarkUpdateCount;
+	// Accumulated time in seconds spent in OnBeginFrame(), scene update and OnEndFrame()
+	float _benchmarkPhaseTimes[3];
+	float _benchmarkUpdateTime;
+	float _benchmarkMinUpdateTime;
+	float _benchmarkMaxUpdateTime;
+
+	bool StartInputReplay();
+	void EndInputRecording();
+	bool IsBenchmarkRunning() const;
+
 #if !defined(DEATH_TARGET_EMSCRIPTEN)
+	struct SourceFileEntry {
+		int64_t Size;
+		uint64_t LastModified;
+		uint64_t Hash;
+		// Path of the converted file, relative to "Cache" directory
+		String TargetPath;
+		// Tilesets used by converted level
+		SmallVector<String, 0> Dependencies;
+	};
+
 	void RefreshCache();
 	void CheckUpdates();
+
+	void SetRefreshCacheProgress(float progress) {
+		_refreshCacheProgress.store((int32_t)(progress * 1000.0f), Atomic32::MemoryModel::RELAXED);
+	}
+
+	static bool LoadSourceManifest(const StringView& path, HashMap<String, SourceFileEntry>& entries);
+	static void SaveSourceManifest(const StringView& path, const HashMap<String, SourceFileEntry>& entries);
+	static bool IsSourceFileUpToDate(const StringView& path, const SourceFileEntry* cached, SourceFileEntry& current);
+	static uint64_t GetSourceFileHash(const StringView& path);
 #endif
 	static void SaveEpisodeEnd(const std::unique_ptr<LevelInitialization>& pendingLevelChange);
 	static void SaveEpisodeContinue(const std::unique_ptr<LevelInitialization>& pendingLevelChange);
@@ -128,9 +185,26 @@ void GameEventHandler::OnPreInit(AppConfiguration& config)
 		config.withVSync = false;
 		config.frameLimit = PreferencesCache::MaxFps;
 	}
+	if (PreferencesCache::UseFixedUpdateRate) {
+		config.fixedUpdateRate = (uint32_t)FrameTimer::FramesPerSecond;
+	}
+	if (PreferencesCache::UseInstancedSprites) {
+		config.withInstancedSprites = true;
+	}
+	if (PreferencesCache::ReplayAsBenchmark || PreferencesCache::BenchmarkImages) {
+		// Benchmark runs the simulation as fast as possible, so nothing is rendered and audio is disabled
+		config.withRendering = false;
+		config.withAudio = false;
+		config.withVSync = false;
+		config.frameLimit = 0;
+	}
 #if !defined(DEATH_TARGET_SWITCH)
 	config.resolution.Set(LevelHandler::DefaultWidth, LevelHandler::DefaultHeight);
 #endif
+#if defined(WITH_THREADS)
+	// Worker threads are used for resource preloading
+	config.withThreads = true;
+#endif
 
 #if !defined(DEATH_TARGET_EMSCRIPTEN)
 	auto& resolver = ContentResolver::Get();
@@ -141,7 +215,9 @@ void GameEventHandler::OnPreInit(AppConfiguration& config)
 void GameEventHandler::OnInit()
 {
 	_flags = Flags::None;
+	_refreshCacheProgress.store(0, Atomic32::MemoryModel::RELAXED);
 	_pendingState = PendingState::None;
+	_inputRecordingState = InputRecordingState::None;
 
 	std::memset(_newestVersion, 0, sizeof(_newestVersion));
 
@@ -170,8 +246,25 @@ void GameEventHandler::OnInit()
 	}
 #endif
 
+	if (PreferencesCache::BenchmarkImages) {
+		resolver.BenchmarkImages();
+		theApplication().quit();
+		return;
+	}
+
 	resolver.CompileShaders();
 
+#if defined(WITH_THREADS)
+	theApplication().renderingSettings().parallelVisitEnabled = PreferencesCache::UseParallelVisit;
+#endif
+
+	if (!PreferencesCache::ReplayInputPath.empty() && StartInputReplay()) {
+		Viewport::chain().clear();
+		Vector2i res = theApplication().resolution();
+		_currentHandler->OnInitializeViewport(res.X, res.Y);
+		return;
+	}
+
 #if defined(WITH_THREADS) && !defined(DEATH_TARGET_EMSCRIPTEN)
 	// If threading support is enabled, refresh cache during intro cinematics and don't allow skip until it's completed
 	Thread thread([](void* arg) {
@@ -243,6 +336,11 @@ void GameEventHandler::OnInit()
 void GameEventHandler::OnFrameStart()
 {
 	if (_pendingState != PendingState::None) {
+		if (_inputRecordingState == InputRecordingState::Active) {
+			// Input is recorded or replayed only for a single level
+			EndInputRecording();
+		}
+
 		switch (_pendingState) {
 			case PendingState::MainMenu:
 				_currentHandler = std::make_unique<Menu::MainMenu>(this, false);
@@ -253,6 +351,15 @@ void GameEventHandler::OnFrameStart()
 				UpdateRichPresence(nullptr);
 				break;
 			case PendingState::LevelChange:
+				if (_inputRecordingState == InputRecordingState::None && !PreferencesCache::RecordInputPath.empty()) {
+					_inputRecording = std::make_unique<InputRecording>();
+					_inputRecordingState = InputRecordingState::Pending;
+				}
+				if (_inputRecordingState == InputRecordingState::Pending) {
+					// Random generator has to be in the same state when the level is recorded and replayed
+					Random().Initialize(_inputRecording->Seed, InputRecording::SeedSequence);
+				}
+
 				if (_pendingLevelChange->LevelName.empty()) {
 					// Next level not specified, so show main menu
 					_currentHandler = std::make_unique<Menu::MainMenu>(this, false);
@@ -319,6 +426,31 @@ void GameEventHandler::OnFrameStart()
 							mainMenu->SwitchToSection<Menu::SimpleMessageSection>(Menu::SimpleMessageSection::Message::CannotLoadLevel);
 							UpdateRichPresence(nullptr);
 						}
+					} else if (_inputRecordingState == InputRecordingState::Pending) {
+						bool isReplay = !PreferencesCache::ReplayInputPath.empty();
+						if (!isReplay) {
+							_inputRecording->EpisodeName = _pendingLevelChange->EpisodeName;
+							_inputRecording->LevelName = _pendingLevelChange->LevelName;
+							_inputRecording->Difficulty = _pendingLevelChange->Difficulty;
+							_inputRecording->IsReforged = _pendingLevelChange->IsReforged;
+							_inputRecording->LastExitType = _pendingLevelChange->LastExitType;
+							_inputRecording->Player = _pendingLevelChange->PlayerCarryOvers[0];
+							LOGI("Recording input of level \"%s/%s\"", _inputRecording->EpisodeName.data(), _inputRecording->LevelName.data());
+						}
+						levelHandler->SetInputRecording(_inputRecording.get(), isReplay);
+						_inputRecordingState = InputRecordingState::Active;
+
+						// The level waits for all preloaded resources anyway when the input is recorded, so wait here already,
+						// otherwise the preloading time would be included in the first update of the benchmark
+						ContentResolver::Get().FinalizePreloadedResources();
+
+						_benchmarkStartTime = TimeStamp::now();
+						_benchmarkUpdateCount = 0;
+						_benchmarkPhaseTimes[0] = 0.0f;
+						_benchmarkPhaseTimes[1] = 0.0f;
+						_benchmarkPhaseTimes[2] = 0.0f;
+						_benchmarkMinUpdateTime = FLT_MAX;
+						_benchmarkMaxUpdateTime = 0.0f;
 					}
 				}
 
@@ -332,12 +464,43 @@ void GameEventHandler::OnFrameStart()
 		_currentHandler->OnInitializeViewport(res.X, res.Y);
 	}
 
-	_currentHandler->OnBeginFrame();
+	if (IsBenchmarkRunning()) {
+		TimeStamp startTime = TimeStamp::now();
+		_currentHandler->OnBeginFrame();
+		_benchmarkPhaseStartTime = TimeStamp::now();
+		_benchmarkUpdateTime = (_benchmarkPhaseStartTime - startTime).seconds();
+		_benchmarkPhaseTimes[0] += _benchmarkUpdateTime;
+	} else {
+		_currentHandler->OnBeginFrame();
+	}
 }
 
 void GameEventHandler::OnPostUpdate()
 {
-	_currentHandler->OnEndFrame();
+	if (IsBenchmarkRunning()) {
+		TimeStamp startTime = TimeStamp::now();
+		float sceneUpdateTime = (startTime - _benchmarkPhaseStartTime).seconds();
+		_currentHandler->OnEndFrame();
+		float endFrameTime = startTime.secondsSince();
+
+		_benchmarkPhaseTimes[1] += sceneUpdateTime;
+		_benchmarkPhaseTimes[2] += endFrameTime;
+		_benchmarkUpdateTime += sceneUpdateTime + endFrameTime;
+		_benchmarkMinUpdateTime = std::min(_benchmarkMinUpdateTime, _benchmarkUpdateTime);
+		_benchmarkMaxUpdateTime = std::max(_benchmarkMaxUpdateTime, _benchmarkUpdateTime);
+		_benchmarkUpdateCount++;
+	} else {
+		_currentHandler->OnEndFrame();
+	}
+
+	if (_inputRecordingState == InputRecordingState::Active && !PreferencesCache::ReplayInputPath.empty() && _inputRecording->IsAtEnd()) {
+		EndInputRecording();
+	}
+}
+
+void GameEventHandler::OnInterpolateFrame(float factor)
+{
+	_currentHandler->OnInterpolateFrame(factor);
 }
 
 void GameEventHandler::OnResizeWindow(int width, int height)
@@ -356,6 +519,10 @@ void GameEventHandler::OnResizeWindow(int width, int height)
 
 void GameEventHandler::OnShutdown()
 {
+	if (_inputRecordingState == InputRecordingState::Active) {
+		EndInputRecording();
+	}
+
 	_currentHandler = nullptr;
 
 	ContentResolver::Get().Release();
@@ -425,6 +592,61 @@ void GameEventHandler::ChangeLevel(LevelInitialization&& levelInit)
 	_pendingState = PendingState::LevelChange;
 }
 
+bool GameEventHandler::StartInputReplay()
+{
+	_inputRecording = std::make_unique<InputRecording>();
+	if (!_inputRecording->LoadFromFile(PreferencesCache::ReplayInputPath)) {
+		_inputRecording = nullptr;
+		if (PreferencesCache::ReplayAsBenchmark) {
+			theApplication().quit();
+		}
+		return false;
+	}
+
+#if !defined(DEATH_TARGET_EMSCRIPTEN)
+	RefreshCache();
+#else
+	_flags |= Flags::IsVerified | Flags::IsPlayable;
+#endif
+
+	LOGI("Replaying %u frames of level \"%s/%s\"", _inputRecording->GetFrameCount(), _inputRecording->EpisodeName.data(), _inputRecording->LevelName.data());
+
+	// Main menu is shown only until the level is loaded in the next frame
+	_currentHandler = std::make_unique<Menu::MainMenu>(this, false);
+	_inputRecordingState = InputRecordingState::Pending;
+	ChangeLevel(_inputRecording->CreateLevelInitialization());
+	return true;
+}
+
+void GameEventHandler::EndInputRecording()
+{
+	_inputRecordingState = InputRecordingState::Finished;
+
+	if (PreferencesCache::ReplayInputPath.empty()) {
+		_inputRecording->SaveToFile(PreferencesCache::RecordInputPath);
+		return;
+	}
+
+	if (PreferencesCache::ReplayAsBenchmark) {
+		float totalTime = _benchmarkStartTime.secondsSince();
+		if (_benchmarkUpdateCount > 0) {
+			float updateCount = (float)_benchmarkUpdateCount;
+			LOGI("Benchmark finished: %u updates in %.2f s, %.3f ms per update (min. %.3f ms, max. %.3f ms)", _benchmarkUpdateCount, totalTime,
+				(_benchmarkPhaseTimes[0] + _benchmarkPhaseTimes[1] + _benchmarkPhaseTimes[2]) * 1000.0f / updateCount, _benchmarkMinUpdateTime * 1000.0f, _benchmarkMaxUpdateTime * 1000.0f);
+			LOGI("Benchmark per-update average: OnBeginFrame %.3f ms, scene update %.3f ms, OnEndFrame %.3f ms",
+				_benchmarkPhaseTimes[0] * 1000.0f / updateCount, _benchmarkPhaseTimes[1] * 1000.0f / updateCount, _benchmarkPhaseTimes[2] * 1000.0f / updateCount);
+		} else {
+			LOGW("Benchmark finished without any update");
+		}
+		theApplication().quit();
+	}
+}
+
+bool GameEventHandler::IsBenchmarkRunning() const
+{
+	return (PreferencesCache::ReplayAsBenchmark && _inputRecordingState == InputRecordingState::Active);
+}
+
 #if !defined(DEATH_TARGET_EMSCRIPTEN)
 void GameEventHandler::RefreshCache()
 {
@@ -435,6 +657,7 @@ void GameEventHandler::RefreshCache()
 	}
 
 	auto& resolver = ContentResolver::Get();
+	bool animsUpToDate = false;
 
 	// Check cache state
 	{
@@ -468,7 +691,9 @@ void GameEventHandler::RefreshCache()
 			goto RecreateCache;
 		}
 
-		// If some events were added, recreate cache
+		animsUpToDate = true;
+
+		// If some events were added, recreate cache (levels only)
 		uint16_t eventTypeCount = s->ReadValue<uint16_t>();
 		if (eventTypeCount != (uint16_t)EventType::Count) {
 			goto RecreateCache;
@@ -492,12 +717,20 @@ RecreateCache:
 		}
 	}
 
-	String animationsPath = fs::CombinePath(resolver.GetCachePath(), "Animations"_s);
-	fs::RemoveDirectoryRecursive(animationsPath);
-	if (!Compatibility::JJ2Anims::Convert(animsPath, animationsPath, false)) {
-		LOGE("Provided Jazz Jackrabbit 2 version is not supported. Make sure supported Jazz Jackrabbit 2 version is present in \"%s\" directory.", resolver.GetSourcePath().data());
-		_flags |= Flags::IsVerified;
-		return;
+	if (!animsUpToDate) {
+		String animationsPath = fs::CombinePath(resolver.GetCachePath(), "Animations"_s);
+		fs::RemoveDirectoryRecursive(animationsPath);
+		SetRefreshCacheProgress(0.0f);
+		bool success = Compatibility::JJ2Anims::Convert(animsPath, animationsPath, false, [this](float progress) {
+			SetRefreshCacheProgress(progress);
+		});
+		if (!success) {
+			LOGE("Provided Jazz Jackrabbit 2 version is not supported. Make sure supported Jazz Jackrabbit 2 version is present in \"%s\" directory.", resolver.GetSourcePath().data());
+			_flags |= Flags::IsVerified;
+			return;
+		}
+	} else {
+		LOGI("Animations are already up-to-date");
 	}
 
 	RefreshCacheLevels();
@@ -665,11 +898,38 @@ void GameEventHandler::RefreshCacheLevels()
 		}
 	};
 
+	struct ConversionJob {
+		String SourcePath;
+		String Key;
+		SourceFileEntry Entry;
+		bool Succeeded;
+	};
+
+	// Only changed source files are converted again, the manifest is dropped if the cache format changed
+	String manifestPath = fs::CombinePath(resolver.GetCachePath(), "Source.index"_s);
 	String episodesPath = fs::CombinePath(resolver.GetCachePath(), "Episodes"_s);
-	fs::RemoveDirectoryRecursive(episodesPath);
+	String tilesetsPath = fs::CombinePath(resolver.GetCachePath(), "Tilesets"_s);
+
+	HashMap<String, SourceFileEntry> prevManifest;
+	HashMap<String, SourceFileEntry> manifest;
+	if (!LoadSourceManifest(manifestPath, prevManifest)) {
+		prevManifest.clear();
+		fs::RemoveDirectoryRecursive(episodesPath);
+		fs::RemoveDirectoryRecursive(tilesetsPath);
+	}
 	fs::CreateDirectories(episodesPath);
+	fs::CreateDirectories(tilesetsPath);
+
+	auto FindPrevEntry = [&prevManifest, &resolver](const String& key) -> const SourceFileEntry* {
+		auto it = prevManifest.find(key);
+		if (it == prevManifest.end() || !fs::IsReadableFile(fs::CombinePath(resolver.GetCachePath(), it->second.TargetPath))) {
+			return nullptr;
+		}
+		return &it->second;
+	};
 
 	HashMap<String, bool> usedTilesets;
+	SmallVector<ConversionJob, 0> jobs;
 
 	fs::Directory dir(fs::FindPathCaseInsensitive(resolver.GetSourcePath()), fs::EnumerationOptions::SkipDirectories);
 	while (true) {
@@ -679,53 +939,23 @@ void GameEventHandler::RefreshCacheLevels()
 		}
 
 		auto extension = fs::GetExtension(item);
-		if (extension == "j2e"_s || extension == "j2pe"_s) {
-			// Episode
-			Compatibility::JJ2Episode episode;
-			if (episode.Open(item)) {
-				if (episode.Name == "home"_s || (hasChristmasChronicles && episode.Name == "xmas98"_s)) {
-					continue;
+		if (extension == "j2e"_s || extension == "j2pe"_s || (extension == "j2l"_s && fs::GetFileName(item).find("-MLLE-Data-"_s) == nullptr)) {
+			String key = fs::GetFileName(item);
+			SourceFileEntry current { };
+			const SourceFileEntry* prev = FindPrevEntry(key);
+			if (IsSourceFileUpToDate(item, prev, current)) {
+				for (auto& tileset : prev->Dependencies) {
+					usedTilesets.emplace(tileset, true);
 				}
-
-				String fullPath = fs::CombinePath(episodesPath, (episode.Name == "xmas98"_s ? "xmas99"_s : StringView(episode.Name)) + ".j2e"_s);
-				episode.Convert(fullPath, LevelTokenConversion, EpisodeNameConversion, EpisodePrevNext);
+				manifest.emplace(std::move(key), *prev).first->second.LastModified = current.LastModified;
+				continue;
 			}
-		} else if (extension == "j2l"_s) {
-			// Level
-			String levelName = fs::GetFileName(item);
-			if (levelName.find("-MLLE-Data-"_s) == nullptr) {
-				Compatibility::JJ2Level level;
-				if (level.Open(item, false)) {
-					String fullPath;
-					auto it = knownLevels.find(level.LevelName);
-					if (it != knownLevels.end()) {
-						if (it->second.second().empty()) {
-							fullPath = fs::CombinePath({ episodesPath, it->second.first(), level.LevelName + ".j2l"_s });
-						} else {
-							fullPath = fs::CombinePath({ episodesPath, it->second.first(), it->second.second() + "_"_s + level.LevelName + ".j2l"_s });
-						}
-					} else {
-						fullPath = fs::CombinePath({ episodesPath, "unknown"_s, level.LevelName + ".j2l"_s });
-					}
-
-					fs::CreateDirectories(fs::GetDirectoryName(fullPath));
-					level.Convert(fullPath, eventConverter, LevelTokenConversion);
-
-					usedTilesets.emplace(level.Tileset, true);
-					for (auto& extraTileset : level.ExtraTilesets) {
-						usedTilesets.emplace(extraTileset.Name, true);
-					}
 
-					// Also copy level script file if exists
-					StringView foundDot = item.findLastOr('.', item.end());
-					String scriptPath = item.prefix(foundDot.begin()) + ".j2as"_s;
-					auto adjustedPath = fs::FindPathCaseInsensitive(scriptPath);
-					if (fs::IsReadableFile(adjustedPath)) {
-						foundDot = fullPath.findLastOr('.', fullPath.end());
-						fs::Copy(adjustedPath, fullPath.prefix(foundDot.begin()) + ".j2as"_s);
-					}
-				}
-			}
+			auto& job = jobs.emplace_back();
+			job.SourcePath = item;
+			job.Key = std::move(key);
+			job.Entry = std::move(current);
+			job.Succeeded = false;
 		}
 #if defined(DEATH_DEBUG)
 		/*else if (extension == "j2s"_s) {
@@ -740,26 +970,293 @@ void GameEventHandler::RefreshCacheLevels()
 #endif
 	}
 
-	// Convert only used tilesets
-	String tilesetsPath = fs::CombinePath(resolver.GetCachePath(), "Tilesets"_s);
-	fs::RemoveDirectoryRecursive(tilesetsPath);
-	fs::CreateDirectories(tilesetsPath);
+	LOGI("Converting %i changed episodes and levels...", (int32_t)jobs.size());
+	// Levels and tilesets are converted in two batches, each one is reported as half of the progress
+	SetRefreshCacheProgress(0.0f);
 
+	{
+		Compatibility::ConversionTasks tasks;
+		for (int32_t i = 0; i < (int32_t)jobs.size(); i++) {
+			tasks.Enqueue([&, i]() {
+				auto& job = jobs[i];
+
+				if (job.Entry.Hash == 0) {
+					job.Entry.Hash = GetSourceFileHash(job.SourcePath);
+				}
+
+				auto extension = fs::GetExtension(job.SourcePath);
+				if (extension == "j2e"_s || extension == "j2pe"_s) {
+					// Episode
+					Compatibility::JJ2Episode episode;
+					if (episode.Open(job.SourcePath)) {
+						if (episode.Name == "home"_s || (hasChristmasChronicles && episode.Name == "xmas98"_s)) {
+							return;
+						}
+
+						job.Entry.TargetPath = fs::CombinePath("Episodes"_s, (episode.Name == "xmas98"_s ? "xmas99"_s : StringView(episode.Name)) + ".j2e"_s);
+						episode.Convert(fs::CombinePath(resolver.GetCachePath(), job.Entry.TargetPath), LevelTokenConversion, EpisodeNameConversion, EpisodePrevNext);
+						job.Succeeded = true;
+					}
+				} else {
+					// Level
+					Compatibility::JJ2Level level;
+					if (level.Open(job.SourcePath, false)) {
+						auto it = knownLevels.find(level.LevelName);
+						if (it != knownLevels.end()) {
+							if (it->second.second().empty()) {
+								job.Entry.TargetPath = fs::CombinePath({ "Episodes"_s, it->second.first(), level.LevelName + ".j2l"_s });
+							} else {
+								job.Entry.TargetPath = fs::CombinePath({ "Episodes"_s, it->second.first(), it->second.second() + "_"_s + level.LevelName + ".j2l"_s });
+							}
+						} else {
+							job.Entry.TargetPath = fs::CombinePath({ "Episodes"_s, "unknown"_s, level.LevelName + ".j2l"_s });
+						}
+
+						String fullPath = fs::CombinePath(resolver.GetCachePath(), job.Entry.TargetPath);
+						fs::CreateDirectories(fs::GetDirectoryName(fullPath));
+						level.Convert(fullPath, eventConverter, LevelTokenConversion);
+
+						job.Entry.Dependencies.push_back(level.Tileset);
+						for (auto& extraTileset : level.ExtraTilesets) {
+							job.Entry.Dependencies.push_back(extraTileset.Name);
+						}
+						job.Succeeded = true;
+					}
+				}
+			});
+		}
+		tasks.WaitForCompletion([this](float progress) {
+			SetRefreshCacheProgress(progress * 0.5f);
+		});
+	}
+
+	for (auto& job : jobs) {
+		if (job.Succeeded) {
+			for (auto& tileset : job.Entry.Dependencies) {
+				usedTilesets.emplace(tileset, true);
+			}
+			manifest.emplace(std::move(job.Key), std::move(job.Entry));
+		}
+	}
+
+	// Level scripts are cheap to copy, so they are always refreshed
+	for (auto& pair : manifest) {
+		StringView sourceName = pair.first;
+		if (fs::GetExtension(sourceName) != "j2l"_s) {
+			continue;
+		}
+
+		StringView foundDot = sourceName.findLastOr('.', sourceName.end());
+		auto scriptPath = fs::FindPathCaseInsensitive(fs::CombinePath(resolver.GetSourcePath(), sourceName.prefix(foundDot.begin()) + ".j2as"_s));
+		if (fs::IsReadableFile(scriptPath)) {
+			String fullPath = fs::CombinePath(resolver.GetCachePath(), pair.second.TargetPath);
+			foundDot = fullPath.findLastOr('.', fullPath.end());
+			fs::Copy(scriptPath, fullPath.prefix(foundDot.begin()) + ".j2as"_s);
+		}
+	}
+
+	// Convert only used tilesets
+	jobs.clear();
 	for (auto& pair : usedTilesets) {
 		String tilesetPath = fs::CombinePath(resolver.GetSourcePath(), pair.first + ".j2t"_s);
 		auto adjustedPath = fs::FindPathCaseInsensitive(tilesetPath);
-		if (fs::IsReadableFile(adjustedPath)) {
-			Compatibility::JJ2Tileset tileset;
-			if (tileset.Open(adjustedPath, false)) {
-				tileset.Convert(fs::CombinePath({ tilesetsPath, pair.first + ".j2t"_s }));
+		if (!fs::IsReadableFile(adjustedPath)) {
+			continue;
+		}
+
+		String key = fs::GetFileName(adjustedPath);
+		if (manifest.contains(key)) {
+			// Multiple names can point to the same file on case-insensitive file systems
+			continue;
+		}
+
+		SourceFileEntry current { };
+		current.TargetPath = fs::CombinePath("Tilesets"_s, pair.first + ".j2t"_s);
+		const SourceFileEntry* prev = FindPrevEntry(key);
+		if (prev != nullptr && prev->TargetPath == current.TargetPath && IsSourceFileUpToDate(adjustedPath, prev, current)) {
+			manifest.emplace(std::move(key), std::move(current));
+			continue;
+		}
+
+		auto& job = jobs.emplace_back();
+		job.SourcePath = std::move(adjustedPath);
+		job.Key = std::move(key);
+		job.Entry = std::move(current);
+		job.Succeeded = false;
+	}
+
+	LOGI("Converting %i changed tilesets...", (int32_t)jobs.size());
+
+	{
+		Compatibility::ConversionTasks tasks;
+		for (int32_t i = 0; i < (int32_t)jobs.size(); i++) {
+			tasks.Enqueue([&, i]() {
+				auto& job = jobs[i];
+
+				if (job.Entry.Hash == 0) {
+					job.Entry.Hash = GetSourceFileHash(job.SourcePath);
+				}
+
+				Compatibility::JJ2Tileset tileset;
+				if (tileset.Open(job.SourcePath, false)) {
+					tileset.Convert(fs::CombinePath(resolver.GetCachePath(), job.Entry.TargetPath));
+					job.Succeeded = true;
+				}
+			});
+		}
+		tasks.WaitForCompletion([this](float progress) {
+			SetRefreshCacheProgress(0.5f + progress * 0.5f);
+		});
+	}
+
+	for (auto& job : jobs) {
+		if (job.Succeeded) {
+			manifest.emplace(std::move(job.Key), std::move(job.Entry));
+		}
+	}
+
+	// Remove converted files whose source files were removed or are not used anymore
+	HashMap<String, bool> targetPaths;
+	for (auto& pair : manifest) {
+		targetPaths.emplace(pair.second.TargetPath, true);
+	}
+	for (auto& pair : prevManifest) {
+		if (!targetPaths.contains(pair.second.TargetPath)) {
+			String fullPath = fs::CombinePath(resolver.GetCachePath(), pair.second.TargetPath);
+			fs::RemoveFile(fullPath);
+			if (fs::GetExtension(fullPath) == "j2l"_s) {
+				StringView foundDot = fullPath.findLastOr('.', fullPath.end());
+				fs::RemoveFile(fullPath.prefix(foundDot.begin()) + ".j2as"_s);
 			}
 		}
 	}
-	
+
+	SaveSourceManifest(manifestPath, manifest);
+
 	LOGI("Pruning binary shader cache...");
 	RenderResources::binaryShaderCache().prune();
 }
 
+bool GameEventHandler::LoadSourceManifest(const StringView& path, HashMap<String, SourceFileEntry>& entries)
+{
+	auto s = fs::Open(path, FileAccessMode::Read);
+	if (s->GetSize() < 17) {
+		return false;
+	}
+
+	uint64_t signature = s->ReadValue<uint64_t>();
+	uint8_t fileType = s->ReadValue<uint8_t>();
+	uint16_t version = s->ReadValue<uint16_t>();
+	uint16_t eventTypeCount = s->ReadValue<uint16_t>();
+	if (signature != 0x2095A59FF0BFBBEF || fileType != ContentResolver::SourceIndexFile ||
+		version != Compatibility::JJ2Anims::CacheVersion || eventTypeCount != (uint16_t)EventType::Count) {
+		return false;
+	}
+
+	auto ReadString = [&s]() -> String {
+		uint16_t length = s->ReadValue<uint16_t>();
+		String value(NoInit, length);
+		s->Read(value.data(), length);
+		return value;
+	};
+
+	uint32_t count = s->ReadValue<uint32_t>();
+	for (uint32_t i = 0; i < count; i++) {
+		String key = ReadString();
+		SourceFileEntry entry;
+		entry.Size = s->ReadValue<int64_t>();
+		entry.LastModified = s->ReadValue<uint64_t>();
+		entry.Hash = s->ReadValue<uint64_t>();
+		entry.TargetPath = ReadString();
+		uint8_t dependencyCount = s->ReadValue<uint8_t>();
+		for (uint32_t j = 0; j < dependencyCount; j++) {
+			entry.Dependencies.push_back(ReadString());
+		}
+
+		if (s->GetPosition() > s->GetSize()) {
+			LOGW("Source manifest is corrupted");
+			return false;
+		}
+
+		entries.emplace(std::move(key), std::move(entry));
+	}
+
+	return true;
+}
+
+void GameEventHandler::SaveSourceManifest(const StringView& path, const HashMap<String, SourceFileEntry>& entries)
+{
+	auto so = fs::Open(path, FileAccessMode::Write);
+	if (!so->IsValid()) {
+		LOGW("Cannot save source manifest to \"%s\"", String::nullTerminatedView(path).data());
+		return;
+	}
+
+	auto WriteString = [&so](const StringView& value) {
+		so->WriteValue<uint16_t>((uint16_t)value.size());
+		so->Write(value.data(), (int32_t)value.size());
+	};
+
+	so->WriteValue<uint64_t>(0x2095A59FF0BFBBEF);	// Signature
+	so->WriteValue<uint8_t>(ContentResolver::SourceIndexFile);
+	so->WriteValue<uint16_t>(Compatibility::JJ2Anims::CacheVersion);
+	so->WriteValue<uint16_t>((uint16_t)EventType::Count);
+
+	so->WriteValue<uint32_t>((uint32_t)entries.size());
+	for (auto& pair : entries) {
+		WriteString(pair.first);
+		so->WriteValue<int64_t>(pair.second.Size);
+		so->WriteValue<uint64_t>(pair.second.LastModified);
+		so->WriteValue<uint64_t>(pair.second.Hash);
+		WriteString(pair.second.TargetPath);
+		so->WriteValue<uint8_t>((uint8_t)pair.second.Dependencies.size());
+		for (auto& dependency : pair.second.Dependencies) {
+			WriteString(dependency);
+		}
+	}
+}
+
+bool GameEventHandler::IsSourceFileUpToDate(const StringView& path, const SourceFileEntry* cached, SourceFileEntry& current)
+{
+	current.Size = fs::GetFileSize(path);
+	current.LastModified = fs::GetLastModificationTime(path).Ticks;
+	current.Hash = 0;
+
+	if (cached == nullptr || cached->Size != current.Size) {
+		return false;
+	}
+
+	if (cached->LastModified == current.LastModified) {
+		current.Hash = cached->Hash;
+		return true;
+	}
+
+	// Modification time changed (e.g. the file was copied again), so compare the content too
+	current.Hash = GetSourceFileHash(path);
+	return (current.Hash == cached->Hash);
+}
+
+uint64_t GameEventHandler::GetSourceFileHash(const StringView& path)
+{
+	auto s = fs::Open(path, FileAccessMode::Read);
+	if (!s->IsValid()) {
+		return 0;
+	}
+
+	uint8_t buffer[16384];
+	uint64_t hash = 0x01000193811C9DC5;
+	while (true) {
+		int32_t bytesRead = s->Read(buffer, sizeof(buffer));
+		if (bytesRead <= 0) {
+			break;
+		}
+		hash = fasthash64(buffer, bytesRead, hash);
+	}
+
+	// Zero is reserved for "not computed yet"
+	return (hash != 0 ? hash : 1);
+}
+
 void GameEventHandler::CheckUpdates()
 {
 #if !defined(DEATH_DEBUG)
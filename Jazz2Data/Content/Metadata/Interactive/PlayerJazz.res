@@ -329,13 +329,15 @@
 			"Path": "Common/player_shield.aura"
 		},
 		"ShieldFire": {
-			"Path": "Common/shield_fire.aura"
+			"Path": "Common/shield_fire.aura",
+			"Flags": 4
 		},
 		"ShieldWater": {
 			"Path": "Common/shield_water.aura"
 		},
 		"ShieldLightning": {
-			"Path": "Common/shield_lightning.aura"
+			"Path": "Common/shield_lightning.aura",
+			"Flags": 4
 		}
 	},
 
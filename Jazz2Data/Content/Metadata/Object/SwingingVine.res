@@ -4,6 +4,7 @@
 	"Animations": {
 		"Vine": {
 			"Path": "Object/vine.aura",
+			"Flags": 4,
 			"States": [ 0 ]
 		}
 	}
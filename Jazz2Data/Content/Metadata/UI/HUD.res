@@ -119,7 +119,8 @@
 		},
 		
 		"WeaponWheel": {
-			"Path": "UI/weapon_wheel.aura"
+			"Path": "UI/weapon_wheel.aura",
+			"Flags": 4
 		},
 		"WeaponWheelInner": {
 			"Path": "UI/weapon_wheel_inner.aura"
@@ -18,6 +18,7 @@ namespace nCine
 		resizable(true),
 		windowScaling(true),
 		frameLimit(0),
+		fixedUpdateRate(0),
 		useBufferMapping(false),
 #if defined(WITH_FIXED_BATCH_SIZE) && WITH_FIXED_BATCH_SIZE > 0
 		fixedBatchSize(WITH_FIXED_BATCH_SIZE),
@@ -28,6 +29,7 @@ namespace nCine
 #else
 		fixedBatchSize(0),
 #endif
+		withInstancedSprites(false),
 #if defined(WITH_IMGUI) || defined(WITH_NUKLEAR)
 		vboSize(512 * 1024),
 		iboSize(128 * 1024),
@@ -40,6 +42,7 @@ namespace nCine
 		withAudio(true),
 		withThreads(false),
 		withScenegraph(true),
+		withRendering(true),
 		withVSync(true),
 		withGlDebugContext(false),
 
@@ -37,6 +37,10 @@ namespace nCine
 		bool windowScaling;
 		/// The maximum number of frames to render per second or 0 for no limit
 		unsigned int frameLimit;
+		/// The number of fixed logic updates per second or 0 to update the scenegraph once per rendered frame
+		/*! When enabled, nodes are updated with a constant time multiplier possibly several times per frame,
+		 *  and `IAppEventHandler::OnInterpolateFrame()` is called before every render to smooth the motion */
+		unsigned int fixedUpdateRate;
 
 		/// The window title
 		String windowTitle;
@@ -49,6 +53,9 @@ namespace nCine
 		/*! \note Increasing this value too much might negatively affect batching shaders compilation time.
 		A value of zero restores the default behavior of non fixed size for batches. */
 		unsigned int fixedBatchSize;
+		/// The flag is `true` if batches of sprites should be drawn with instanced rendering from a per-frame instance buffer
+		/*! \note Only shaders with a registered instanced variant are affected, the others still use uniform blocks for batching */
+		bool withInstancedSprites;
 		/// The path for the binary shaders cache (or empty to disable binary shader cache)
 		/*! \note Even if the path is set the functionality might still not be supported by the OpenGL context */
 		String shaderCachePath;
@@ -68,6 +75,10 @@ namespace nCine
 		bool withThreads;
 		/// The flag is `true` if the scenegraph based rendering is enabled
 		bool withScenegraph;
+		/// The flag is `true` if the scenegraph is visited and drawn, otherwise it's only updated
+		/*! Combined with fixed update rate, exactly one update is performed per frame regardless of the elapsed time,
+		 *  so the simulation runs as fast as possible (e.g., for benchmarks) */
+		bool withRendering;
 		/// The flag is `true` if the vertical synchronization is enabled
 		bool withVSync;
 		/// The flag is `true` if the OpenGL debug context is enabled
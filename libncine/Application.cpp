@@ -30,6 +30,8 @@ extern "C"
 #include "tracy.h"
 #include "tracy_opengl.h"
 
+#include <algorithm>
+
 #include <Containers/StringView.h>
 #include <IO/FileSystem.h>
 
@@ -331,7 +333,8 @@ void DEATH_LOGGING(LogLevel level, const char* fmt, ...)
 namespace nCine
 {
 	Application::Application()
-		: isSuspended_(false), autoSuspension_(false), hasFocus_(true), shouldQuit_(false)
+		: isSuspended_(false), autoSuspension_(false), hasFocus_(true), shouldQuit_(false), numUpdates_(0),
+			fixedUpdateAccumulator_(0.0f), interpolationFactor_(1.0f)
 	{
 	}
 
@@ -354,6 +357,9 @@ namespace nCine
 
 	float Application::timeMult() const
 	{
+		if (appCfg_.fixedUpdateRate > 0) {
+			return FrameTimer::FramesPerSecond / static_cast<float>(appCfg_.fixedUpdateRate);
+		}
 		return frameTimer_->timeMult();
 	}
 
@@ -472,39 +478,28 @@ namespace nCine
 		LuaStatistics::update();
 #endif
 
-		{
-			ZoneScopedN("OnFrameStart");
-#if defined(NCINE_PROFILING)
-			profileStartTime_ = TimeStamp::now();
-#endif
-			appEventHandler_->OnFrameStart();
-#if defined(NCINE_PROFILING)
-			timings_[(int)Timings::FrameStart] = profileStartTime_.secondsSince();
-#endif
+		if (appCfg_.fixedUpdateRate > 0 && !appCfg_.withRendering) {
+			// Nothing is rendered, so the simulation doesn't need to be synchronized with the real time
+			update();
+		} else if (appCfg_.fixedUpdateRate > 0) {
+			// Consume elapsed time in fixed updates, the remainder is used to interpolate the rendered frame
+			const float updateInterval = 1.0f / static_cast<float>(appCfg_.fixedUpdateRate);
+			// Limit the number of updates after a long frame, so the simulation cannot fall behind indefinitely
+			fixedUpdateAccumulator_ += std::min(frameTimer_->lastFrameInterval(), updateInterval * MaxFixedUpdatesPerFrame);
+			while (fixedUpdateAccumulator_ >= updateInterval) {
+				fixedUpdateAccumulator_ -= updateInterval;
+				update();
+			}
+			interpolationFactor_ = fixedUpdateAccumulator_ / updateInterval;
+		} else {
+			update();
 		}
 
-		if (appCfg_.withScenegraph) {
+		if (appCfg_.withScenegraph && appCfg_.withRendering) {
 			ZoneScopedN("SceneGraph");
-			{
-				ZoneScopedN("Update");
-#if defined(NCINE_PROFILING)
-				profileStartTime_ = TimeStamp::now();
-#endif
-				screenViewport_->update();
-#if defined(NCINE_PROFILING)
-				timings_[(int)Timings::Update] = profileStartTime_.secondsSince();
-#endif
-			}
-
-			{
-				ZoneScopedN("OnPostUpdate");
-#if defined(NCINE_PROFILING)
-				profileStartTime_ = TimeStamp::now();
-#endif
-				appEventHandler_->OnPostUpdate();
-#if defined(NCINE_PROFILING)
-				timings_[(int)Timings::PostUpdate] = profileStartTime_.secondsSince();
-#endif
+			if (appCfg_.fixedUpdateRate > 0) {
+				ZoneScopedN("OnInterpolateFrame");
+				appEventHandler_->OnInterpolateFrame(interpolationFactor_);
 			}
 
 			{
@@ -546,7 +541,9 @@ namespace nCine
 #endif
 		}
 
-		gfxDevice_->update();
+		if (appCfg_.withRendering) {
+			gfxDevice_->update();
+		}
 		FrameMark;
 		TracyGpuCollect;
 
@@ -572,6 +569,47 @@ namespace nCine
 		}
 	}
 
+	void Application::update()
+	{
+		numUpdates_++;
+
+		{
+			ZoneScopedN("OnFrameStart");
+#if defined(NCINE_PROFILING)
+			profileStartTime_ = TimeStamp::now();
+#endif
+			appEventHandler_->OnFrameStart();
+#if defined(NCINE_PROFILING)
+			timings_[(int)Timings::FrameStart] = profileStartTime_.secondsSince();
+#endif
+		}
+
+		if (appCfg_.withScenegraph) {
+			ZoneScopedN("SceneGraph");
+			{
+				ZoneScopedN("Update");
+#if defined(NCINE_PROFILING)
+				profileStartTime_ = TimeStamp::now();
+#endif
+				screenViewport_->update();
+#if defined(NCINE_PROFILING)
+				timings_[(int)Timings::Update] = profileStartTime_.secondsSince();
+#endif
+			}
+
+			{
+				ZoneScopedN("OnPostUpdate");
+#if defined(NCINE_PROFILING)
+				profileStartTime_ = TimeStamp::now();
+#endif
+				appEventHandler_->OnPostUpdate();
+#if defined(NCINE_PROFILING)
+				timings_[(int)Timings::PostUpdate] = profileStartTime_.secondsSince();
+#endif
+			}
+		}
+	}
+
 	void Application::shutdownCommon()
 	{
 		ZoneScoped;
@@ -27,7 +27,7 @@ namespace nCine
 		struct RenderingSettings
 		{
 			RenderingSettings()
-				: batchingEnabled(true), batchingWithIndices(false), cullingEnabled(true), minBatchSize(4), maxBatchSize(585) { }
+				: batchingEnabled(true), batchingWithIndices(false), cullingEnabled(true), parallelVisitEnabled(false), minBatchSize(4), maxBatchSize(585) { }
 
 			/// True if batching is enabled
 			bool batchingEnabled;
@@ -35,6 +35,11 @@ namespace nCine
 			bool batchingWithIndices;
 			/// True if node culling is enabled
 			bool cullingEnabled;
+			/// True if viewports in the chain are visited in parallel on the thread pool
+			/*! \note Viewports must not share nodes, and nodes must not modify state outside of their own viewport while visited.
+			 *  Worker threads have no GL context, so nodes must not create, resize or destroy GL objects (textures, buffers,
+			 *  custom VBOs of geometries) in `OnDraw()`, this has to be done in `OnUpdate()` or outside of the visit instead. */
+			bool parallelVisitEnabled;
 			/// Minimum size for a batch to be collected
 			unsigned int minBatchSize;
 			/// Maximum size for a batch before a forced split
@@ -91,8 +96,17 @@ namespace nCine
 		unsigned long int numFrames() const;
 		/// Returns the average FPS during the update interval
 		float averageFps() const;
+		/// Returns the total number of scenegraph updates, it differs from the number of frames only with fixed update rate
+		inline unsigned long int numUpdates() const {
+			return numUpdates_;
+		}
 		/// Returns a factor that represents how long the last frame took relative to the desired frame time
+		/*! With fixed update rate, the factor is constant and represents the duration of one update instead */
 		float timeMult() const;
+		/// Returns the fraction of a fixed update that elapsed since the last one, or 1 if fixed update rate is disabled
+		inline float interpolationFactor() const {
+			return interpolationFactor_;
+		}
 
 		/// Returns the drawable screen width as an integer number
 		inline int width() const { return gfxDevice_->drawableWidth(); }
@@ -149,6 +163,10 @@ namespace nCine
 		bool shouldQuit_;
 		AppConfiguration appCfg_;
 		RenderingSettings renderingSettings_;
+		unsigned long int numUpdates_;
+		/// Time in seconds not yet consumed by fixed updates
+		float fixedUpdateAccumulator_;
+		float interpolationFactor_;
 #if defined(NCINE_PROFILING)
 		float timings_[(int)Timings::Count];
 #endif
@@ -171,6 +189,8 @@ namespace nCine
 		void initCommon();
 		/// A single step of the game loop made to render a frame
 		void step();
+		/// Updates the scenegraph once, it can be called several times per frame with fixed update rate
+		void update();
 		/// Must be called before exiting to shut down the application
 		void shutdownCommon();
 
@@ -185,6 +205,9 @@ namespace nCine
 		virtual void setFocus(bool hasFocus);
 
 	private:
+		/// Maximum number of fixed updates in a single frame, the remaining time is dropped
+		static constexpr float MaxFixedUpdatesPerFrame = 4.0f;
+
 		/// Deleted copy constructor
 		Application(const Application&) = delete;
 		/// Deleted assignment operator
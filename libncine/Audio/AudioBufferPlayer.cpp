@@ -65,6 +65,11 @@ namespace nCine
 	}
 
 	void AudioBufferPlayer::play()
+	{
+		playFrom(0);
+	}
+
+	void AudioBufferPlayer::playFrom(int sampleOffset)
 	{
 		IAudioDevice& device = theServiceLocator().audioDevice();
 
@@ -95,6 +100,9 @@ namespace nCine
 				alSource3f(sourceId_, AL_POSITION, position_.X * IAudioDevice::LengthToPhysical, position_.Y * -IAudioDevice::LengthToPhysical, position_.Z * -IAudioDevice::LengthToPhysical);
 				alSourcef(sourceId_, AL_REFERENCE_DISTANCE, IAudioDevice::ReferenceDistance);
 				alSourcef(sourceId_, AL_MAX_DISTANCE, IAudioDevice::MaxDistance);
+				if (sampleOffset > 0) {
+					alSourcei(sourceId_, AL_SAMPLE_OFFSET, sampleOffset);
+				}
 
 				alSourcePlay(sourceId_);
 				state_ = PlayerState::Playing;
@@ -40,6 +40,8 @@ namespace nCine
 		void setAudioBuffer(AudioBuffer* audioBuffer);
 
 		void play() override;
+		/// Starts playing from the specified sample offset, a paused player is resumed from its current position instead
+		void playFrom(int sampleOffset);
 		void pause() override;
 		void stop() override;
 
@@ -8,16 +8,24 @@
 
 namespace nCine
 {
+#if defined(WITH_THREADS)
+	SmallVector<AudioStream::DecodedRing*, 0> AudioStream::rings_;
+	Mutex AudioStream::ringsMutex_;
+	CondVariable AudioStream::ringsCV_;
+	Thread AudioStream::streamingThread_;
+	bool AudioStream::shouldWakeUp_ = false;
+	bool AudioStream::shouldQuit_ = false;
+#endif
+
 	/*! Private constructor called only by `AudioStreamPlayer`. */
 	AudioStream::AudioStream()
 		: nextAvailableBufferIndex_(0), currentBufferId_(0), bytesPerSample_(0), numChannels_(0), isLooping_(false),
-			frequency_(0), numSamples_(0), duration_(0.0f), buffersIds_(NumBuffers)
+			frequency_(0), numSamples_(0), duration_(0.0f), buffersIds_(NumBuffers), numDecodedBuffers_(DefaultNumDecodedBuffers)
 	{
 		alGetError();
 		alGenBuffers(NumBuffers, buffersIds_.data());
 		const ALenum error = alGetError();
 		ASSERT_MSG(error == AL_NO_ERROR, "alGenBuffers failed: 0x%x", error);
-		memBuffer_ = std::make_unique<char[]>(BufferSize);
 	}
 
 	/*! Private constructor called only by `AudioStreamPlayer`. */
@@ -42,6 +50,12 @@ namespace nCine
 
 	AudioStream::~AudioStream()
 	{
+#if defined(WITH_THREADS)
+		if (ring_ != nullptr && ring_->reader != nullptr) {
+			unregisterRing(ring_.get());
+		}
+#endif
+
 		// Don't delete buffers if this is a moved out object
 		if (buffersIds_.size() == NumBuffers) {
 			alDeleteBuffers(NumBuffers, buffersIds_.data());
@@ -50,7 +64,39 @@ namespace nCine
 
 	AudioStream::AudioStream(AudioStream&&) = default;
 
-	AudioStream& AudioStream::operator=(AudioStream&&) = default;
+	AudioStream& AudioStream::operator=(AudioStream&& other)
+	{
+		if (this == &other) {
+			return *this;
+		}
+
+#if defined(WITH_THREADS)
+		// The current ring is destroyed by the assignment, so it must not be left in the streaming thread
+		if (ring_ != nullptr && ring_->reader != nullptr) {
+			unregisterRing(ring_.get());
+		}
+#endif
+		if (buffersIds_.size() == NumBuffers) {
+			alDeleteBuffers(NumBuffers, buffersIds_.data());
+		}
+
+		// The moved ring is allocated separately and keeps its address, so it stays registered
+		buffersIds_ = std::move(other.buffersIds_);
+		other.buffersIds_.clear();
+		nextAvailableBufferIndex_ = other.nextAvailableBufferIndex_;
+		ring_ = std::move(other.ring_);
+		numDecodedBuffers_ = other.numDecodedBuffers_;
+		currentBufferId_ = other.currentBufferId_;
+		bytesPerSample_ = other.bytesPerSample_;
+		numChannels_ = other.numChannels_;
+		frequency_ = other.frequency_;
+		numSamples_ = other.numSamples_;
+		duration_ = other.duration_;
+		isLooping_ = other.isLooping_;
+		format_ = other.format_;
+		audioReader_ = std::move(other.audioReader_);
+		return *this;
+	}
 
 	unsigned long int AudioStream::numStreamSamples() const
 	{
@@ -60,15 +106,15 @@ namespace nCine
 		return 0UL;
 	}
 
-	/*! \return A flag indicating whether the stream has been entirely decoded and played or not. */
-	bool AudioStream::enqueue(unsigned int source, bool looping)
+	/*! Only already decoded buffers are queued, decoding itself is done by the streaming thread if available.
+	 *  \return A flag indicating whether the stream has been entirely decoded and played or not. */
+	bool AudioStream::enqueue(unsigned int source)
 	{
 		if (audioReader_ == nullptr) {
 			return false;
 		}
-		
-		// Set to false when the queue is empty and there is no more data to decode
-		bool shouldKeepPlaying = true;
+
+		DecodedRing& ring = *ring_;
 
 		ALint numProcessedBuffers;
 		alGetSourcei(source, AL_BUFFERS_PROCESSED, &numProcessedBuffers);
@@ -82,33 +128,41 @@ namespace nCine
 			numProcessedBuffers--;
 		}
 
+		// The flag must be read before the ring, so the last decoded buffers are not missed
+		const bool isFinished = (ring.isFinished.load(Atomic32::MemoryModel::ACQUIRE) != 0);
+
 		// Queueing
-		if (nextAvailableBufferIndex_ < NumBuffers) {
-			currentBufferId_ = buffersIds_[nextAvailableBufferIndex_];
+		bool hasConsumed = false;
+		while (nextAvailableBufferIndex_ < NumBuffers) {
+#if !defined(WITH_THREADS)
+			// Without the streaming thread, only buffers that can be queued immediately are decoded
+			decodeNext(ring);
+#endif
+			const int32_t readIndex = ring.readIndex.load(Atomic32::MemoryModel::RELAXED);
+			if (readIndex == ring.writeIndex.load(Atomic32::MemoryModel::ACQUIRE)) {
+				break;
+			}
 
-			unsigned long bytes = audioReader_->read(memBuffer_.get(), BufferSize);
+			const int index = readIndex % ring.numBuffers;
+			currentBufferId_ = buffersIds_[nextAvailableBufferIndex_];
+			// On iOS `alBufferDataStatic()` could be used instead
+			alBufferData(currentBufferId_, format_, ring.data.get() + index * BufferSize, ring.bytes[index], frequency_);
+			alSourceQueueBuffers(source, 1, &currentBufferId_);
+			nextAvailableBufferIndex_++;
 
-			// EOF reached
-			if (bytes < BufferSize) {
-				if (looping) {
-					audioReader_->rewind();
-					const unsigned long moreBytes = audioReader_->read(memBuffer_.get() + bytes, BufferSize - bytes);
-					bytes += moreBytes;
-				}
-			}
+			ring.readIndex.store(readIndex + 1, Atomic32::MemoryModel::RELEASE);
+			hasConsumed = true;
+		}
 
-			// If it is still decoding data then enqueue
-			if (bytes > 0) {
-				// On iOS `alBufferDataStatic()` could be used instead
-				alBufferData(currentBufferId_, format_, memBuffer_.get(), bytes, frequency_);
-				alSourceQueueBuffers(source, 1, &currentBufferId_);
-				nextAvailableBufferIndex_++;
-			}
-			// If there is no more data left to decode and the queue is empty
-			else if (nextAvailableBufferIndex_ == 0) {
-				shouldKeepPlaying = false;
-				stop(source);
-			}
+		if (hasConsumed) {
+#if defined(WITH_THREADS)
+			wakeUpStreamingThread();
+#endif
+		} else if (nextAvailableBufferIndex_ == 0 && isFinished &&
+				   ring.readIndex.load(Atomic32::MemoryModel::RELAXED) == ring.writeIndex.load(Atomic32::MemoryModel::ACQUIRE)) {
+			// There is no more data left to decode and the queue is empty
+			stop(source);
+			return false;
 		}
 
 		ALenum state;
@@ -124,7 +178,7 @@ namespace nCine
 			}
 		}
 
-		return shouldKeepPlaying;
+		return true;
 	}
 
 	void AudioStream::stop(unsigned int source)
@@ -144,7 +198,7 @@ namespace nCine
 			numProcessedBuffers--;
 		}
 
-		audioReader_->rewind();
+		resetRing();
 		currentBufferId_ = 0;
 	}
 
@@ -153,7 +207,42 @@ namespace nCine
 		isLooping_ = isLooping;
 
 		if (audioReader_ != nullptr) {
+#if defined(WITH_THREADS)
+			ring_->decodeMutex.Lock();
+#endif
+			ring_->isLooping = isLooping_;
 			audioReader_->setLooping(isLooping_);
+#if defined(WITH_THREADS)
+			ring_->decodeMutex.Unlock();
+#endif
+		}
+	}
+
+	/*! The stream should be stopped, because all decoded buffers are discarded. */
+	void AudioStream::setNumDecodedBuffers(int numBuffers)
+	{
+		if (numBuffers < 2) {
+			numBuffers = 2;
+		} else if (numBuffers > MaxNumDecodedBuffers) {
+			numBuffers = MaxNumDecodedBuffers;
+		}
+
+		if (numDecodedBuffers_ == numBuffers) {
+			return;
+		}
+		numDecodedBuffers_ = numBuffers;
+
+		if (ring_ != nullptr) {
+#if defined(WITH_THREADS)
+			ring_->decodeMutex.Lock();
+#endif
+			ring_->data = std::make_unique<char[]>(numDecodedBuffers_ * BufferSize);
+			ring_->bytes = std::make_unique<unsigned long int[]>(numDecodedBuffers_);
+			ring_->numBuffers = numDecodedBuffers_;
+#if defined(WITH_THREADS)
+			ring_->decodeMutex.Unlock();
+#endif
+			resetRing();
 		}
 	}
 
@@ -200,7 +289,165 @@ namespace nCine
 			duration_ = -1.0;
 		}
 
+		if (ring_ == nullptr) {
+			ring_ = std::make_unique<DecodedRing>();
+			ring_->data = std::make_unique<char[]>(numDecodedBuffers_ * BufferSize);
+			ring_->bytes = std::make_unique<unsigned long int[]>(numDecodedBuffers_);
+			ring_->numBuffers = numDecodedBuffers_;
+		}
+#if defined(WITH_THREADS)
+		else if (ring_->reader != nullptr) {
+			unregisterRing(ring_.get());
+		}
+#endif
+
 		audioReader_ = audioLoader.createReader();
 		audioReader_->setLooping(isLooping_);
+
+		ring_->reader = audioReader_.get();
+		ring_->isLooping = isLooping_;
+		ring_->readIndex.store(0, Atomic32::MemoryModel::RELAXED);
+		ring_->writeIndex.store(0, Atomic32::MemoryModel::RELAXED);
+		ring_->isFinished.store(0, Atomic32::MemoryModel::RELAXED);
+#if defined(WITH_THREADS)
+		// Buffers are decoded in advance, so the playback can start immediately
+		registerRing(ring_.get());
+#endif
+	}
+
+	void AudioStream::resetRing()
+	{
+		if (ring_ == nullptr || ring_->reader == nullptr) {
+			return;
+		}
+
+#if defined(WITH_THREADS)
+		ring_->decodeMutex.Lock();
+#endif
+		ring_->reader->rewind();
+		ring_->readIndex.store(0, Atomic32::MemoryModel::RELAXED);
+		ring_->writeIndex.store(0, Atomic32::MemoryModel::RELAXED);
+		ring_->isFinished.store(0, Atomic32::MemoryModel::RELAXED);
+#if defined(WITH_THREADS)
+		ring_->decodeMutex.Unlock();
+		wakeUpStreamingThread();
+#endif
+	}
+
+	bool AudioStream::decodeNext(DecodedRing& ring)
+	{
+		if (!ring.isLooping && ring.isFinished.load(Atomic32::MemoryModel::RELAXED) != 0) {
+			return false;
+		}
+
+		const int32_t writeIndex = ring.writeIndex.load(Atomic32::MemoryModel::RELAXED);
+		if (writeIndex - ring.readIndex.load(Atomic32::MemoryModel::ACQUIRE) >= ring.numBuffers) {
+			return false;
+		}
+
+		const int index = writeIndex % ring.numBuffers;
+		char* buffer = ring.data.get() + index * BufferSize;
+		unsigned long int bytes = ring.reader->read(buffer, BufferSize);
+
+		// EOF reached
+		if (bytes < BufferSize && ring.isLooping) {
+			ring.reader->rewind();
+			bytes += ring.reader->read(buffer + bytes, BufferSize - bytes);
+		}
+
+		if (bytes == 0) {
+			ring.isFinished.store(1, Atomic32::MemoryModel::RELEASE);
+			return false;
+		}
+
+		ring.bytes[index] = bytes;
+		ring.writeIndex.store(writeIndex + 1, Atomic32::MemoryModel::RELEASE);
+		// Looping could be enabled after the end was reached
+		ring.isFinished.store(0, Atomic32::MemoryModel::RELAXED);
+		return true;
+	}
+
+#if defined(WITH_THREADS)
+	void AudioStream::registerRing(DecodedRing* ring)
+	{
+		ringsMutex_.Lock();
+		rings_.push_back(ring);
+		if (rings_.size() == 1) {
+			shouldQuit_ = false;
+			streamingThread_.Run(streamingThreadFunction, nullptr);
+		}
+		shouldWakeUp_ = true;
+		ringsCV_.Signal();
+		ringsMutex_.Unlock();
+	}
+
+	void AudioStream::unregisterRing(DecodedRing* ring)
+	{
+		ringsMutex_.Lock();
+		for (std::size_t i = 0; i < rings_.size(); i++) {
+			if (rings_[i] == ring) {
+				rings_.erase(rings_.begin() + i);
+				break;
+			}
+		}
+		const bool isLast = rings_.empty();
+		if (isLast) {
+			shouldQuit_ = true;
+			ringsCV_.Signal();
+		}
+		ringsMutex_.Unlock();
+
+		// The streaming thread locks the ring before it releases the list, so it can't be used after this point
+		ring->decodeMutex.Lock();
+		ring->decodeMutex.Unlock();
+
+		if (isLast) {
+			streamingThread_.Join();
+		}
+	}
+
+	void AudioStream::wakeUpStreamingThread()
+	{
+		// The list is locked only briefly by the streaming thread, so it doesn't block the caller during decoding
+		ringsMutex_.Lock();
+		shouldWakeUp_ = true;
+		ringsCV_.Signal();
+		ringsMutex_.Unlock();
+	}
+
+	void AudioStream::streamingThreadFunction(void* /*arg*/)
+	{
+#if !defined(DEATH_TARGET_EMSCRIPTEN) && !defined(DEATH_TARGET_SWITCH)
+		Thread::SetSelfName("Audio streaming");
+#endif
+
+		ringsMutex_.Lock();
+		while (true) {
+			while (!shouldWakeUp_ && !shouldQuit_) {
+				ringsCV_.Wait(ringsMutex_);
+			}
+			if (shouldQuit_) {
+				break;
+			}
+			shouldWakeUp_ = false;
+
+			// Fill all rings, one buffer from each stream at a time, until there is no free space left
+			bool hasDecoded;
+			do {
+				hasDecoded = false;
+				for (std::size_t i = 0; i < rings_.size() && !shouldQuit_; i++) {
+					DecodedRing* ring = rings_[i];
+					ring->decodeMutex.Lock();
+					ringsMutex_.Unlock();
+
+					hasDecoded |= decodeNext(*ring);
+
+					ring->decodeMutex.Unlock();
+					ringsMutex_.Lock();
+				}
+			} while (hasDecoded && !shouldQuit_);
+		}
+		ringsMutex_.Unlock();
 	}
+#endif
 }
@@ -1,5 +1,11 @@
 #pragma once
 
+#include "../Threading/Atomic.h"
+#if defined(WITH_THREADS)
+#	include "../Threading/Thread.h"
+#	include "../Threading/ThreadSync.h"
+#endif
+
 #include <memory>
 
 #include <Containers/SmallVector.h>
@@ -58,7 +64,7 @@ namespace nCine
 		}
 
 		/// Enqueues new buffers and unqueues processed ones
-		bool enqueue(unsigned int source, bool looping);
+		bool enqueue(unsigned int source);
 		/// Unqueues any left buffer and rewinds the loader
 		void stop(unsigned int source);
 
@@ -69,6 +75,18 @@ namespace nCine
 		/// Sets stream looping property
 		void setLooping(bool isLooping);
 
+		/// Returns the number of decoded buffers waiting to be queued
+		inline int numDecodedBuffers() const {
+			return numDecodedBuffers_;
+		}
+		/// Sets the number of decoded buffers, the stream is rewound
+		void setNumDecodedBuffers(int numBuffers);
+
+		/// Default number of decoded buffers for each stream
+		static const int DefaultNumDecodedBuffers = 8;
+		/// Maximum number of decoded buffers for each stream
+		static const int MaxNumDecodedBuffers = 64;
+
 	private:
 		/// Number of buffers for streaming
 		static const int NumBuffers = 3;
@@ -79,8 +97,35 @@ namespace nCine
 
 		/// Size in bytes of each streaming buffer
 		static const int BufferSize = 16 * 1024;
-		/// Memory buffer to feed OpenAL ones
-		std::unique_ptr<char[]> memBuffer_;
+		/// Single-producer/single-consumer ring of decoded buffers, filled by the streaming thread and consumed by `enqueue()`
+		struct DecodedRing
+		{
+			DecodedRing()
+				: reader(nullptr), numBuffers(0), isLooping(false) {}
+
+			/// Memory for all decoded buffers, each one is `BufferSize` bytes long
+			std::unique_ptr<char[]> data;
+			/// Number of valid bytes in each decoded buffer
+			std::unique_ptr<unsigned long int[]> bytes;
+			IAudioReader* reader;
+			int numBuffers;
+			bool isLooping;
+			/// Total number of buffers consumed, written only by the consumer
+			Atomic32 readIndex;
+			/// Total number of buffers decoded, written only by the producer
+			Atomic32 writeIndex;
+			/// Set by the producer when there is no more data to decode
+			Atomic32 isFinished;
+#if defined(WITH_THREADS)
+			/// Held by the streaming thread while decoding, so the reader can be rewound safely
+			Mutex decodeMutex;
+#endif
+		};
+
+		/// Allocated separately, so it's not affected by moving the stream
+		std::unique_ptr<DecodedRing> ring_;
+		/// Number of decoded buffers of the ring
+		int numDecodedBuffers_;
 
 		/// OpenAL id of the currently playing buffer, or 0 if not
 		unsigned int currentBufferId_;
@@ -113,13 +158,36 @@ namespace nCine
 
 		/// Default move constructor
 		AudioStream(AudioStream&&);
-		/// Default move assignment operator
+		/// Move assignment operator, the current ring is removed from the streaming thread first
 		AudioStream& operator=(AudioStream&&);
 
 		bool loadFromMemory(const unsigned char* bufferPtr, unsigned long int bufferSize);
 		bool loadFromFile(const StringView& filename);
 
 		void createReader(IAudioLoader& audioLoader);
+		/// Clears decoded buffers and rewinds the reader
+		void resetRing();
+
+		/// Decodes the next buffer if there is a free one in the ring, returns `false` if nothing was decoded
+		static bool decodeNext(DecodedRing& ring);
+
+#if defined(WITH_THREADS)
+		/// Rings filled by the streaming thread
+		static SmallVector<DecodedRing*, 0> rings_;
+		static Mutex ringsMutex_;
+		static CondVariable ringsCV_;
+		static Thread streamingThread_;
+		static bool shouldWakeUp_;
+		static bool shouldQuit_;
+
+		/// Adds the ring to the streaming thread, the thread is started with the first one
+		static void registerRing(DecodedRing* ring);
+		/// Removes the ring from the streaming thread, the thread is stopped with the last one
+		static void unregisterRing(DecodedRing* ring);
+		/// Wakes up the streaming thread to fill free buffers
+		static void wakeUpStreamingThread();
+		static void streamingThreadFunction(void* arg);
+#endif
 
 		/// Deleted copy constructor
 		AudioStream(const AudioStream&) = delete;
@@ -126,10 +126,19 @@ namespace nCine
 		audioStream_.setLooping(isLooping);
 	}
 
+	void AudioStreamPlayer::setNumDecodedBuffers(int numBuffers)
+	{
+		if (state_ != PlayerState::Initial && state_ != PlayerState::Stopped) {
+			stop();
+		}
+
+		audioStream_.setNumDecodedBuffers(numBuffers);
+	}
+
 	void AudioStreamPlayer::updateState()
 	{
 		if (state_ == PlayerState::Playing) {
-			const bool shouldStillPlay = audioStream_.enqueue(sourceId_, isLooping_);
+			const bool shouldStillPlay = audioStream_.enqueue(sourceId_);
 			if (!shouldStillPlay) {
 				// Detach the buffer from source
 				alSourcei(sourceId_, AL_BUFFER, 0);
@@ -56,6 +56,12 @@ namespace nCine
 		inline int streamBufferSize() const {
 			return audioStream_.streamBufferSize();
 		}
+		/// Returns the number of buffers decoded in advance
+		inline int numDecodedBuffers() const {
+			return audioStream_.numDecodedBuffers();
+		}
+		/// Sets the number of buffers decoded in advance, the player is stopped if it's playing
+		void setNumDecodedBuffers(int numBuffers);
 
 		void play() override;
 		void pause() override;
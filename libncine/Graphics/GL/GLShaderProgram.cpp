@@ -230,6 +230,7 @@ namespace nCine
 
 			RenderResources::removeCameraUniformData(this);
 			RenderResources::unregisterBatchedShader(this);
+			RenderResources::unregisterInstancedShader(this);
 
 			glHandle_ = glCreateProgram();
 		}
@@ -7,7 +7,7 @@
 namespace nCine
 {
 	GLVertexFormat::Attribute::Attribute()
-		: enabled_(false), vbo_(nullptr), index_(0), size_(-1), type_(GL_FLOAT), stride_(0), pointer_(nullptr), baseOffset_(0)
+		: enabled_(false), vbo_(nullptr), index_(0), size_(-1), type_(GL_FLOAT), stride_(0), pointer_(nullptr), baseOffset_(0), divisor_(0)
 	{
 	}
 
@@ -27,7 +27,8 @@ namespace nCine
 					other.normalized_ == normalized_ &&
 					other.stride_ == stride_ &&
 					other.pointer_ == pointer_ &&
-					other.baseOffset_ == baseOffset_));
+					other.baseOffset_ == baseOffset_ &&
+					other.divisor_ == divisor_));
 	}
 
 	bool GLVertexFormat::Attribute::operator!=(const Attribute& other) const
@@ -46,6 +47,7 @@ namespace nCine
 		stride_ = 0;
 		pointer_ = nullptr;
 		baseOffset_ = 0;
+		divisor_ = 0;
 	}
 
 	void GLVertexFormat::Attribute::setVboParameters(GLsizei stride, const GLvoid* pointer)
@@ -74,7 +76,10 @@ namespace nCine
 				const GLubyte* initialPointer = reinterpret_cast<const GLubyte*>(attributes_[i].pointer_);
 				const GLvoid* pointer = reinterpret_cast<const GLvoid*>(initialPointer + attributes_[i].baseOffset_);
 #else
-				const GLvoid* pointer = attributes_[i].pointer_;
+				// The base vertex of a draw call doesn't apply to per-instance attributes, so their pointer is always offset
+				const GLvoid* pointer = (attributes_[i].divisor_ > 0
+					? reinterpret_cast<const GLvoid*>(reinterpret_cast<const GLubyte*>(attributes_[i].pointer_) + attributes_[i].baseOffset_)
+					: attributes_[i].pointer_);
 #endif
 
 				switch (attributes_[i].type_) {
@@ -94,6 +99,9 @@ namespace nCine
 						glVertexAttribPointer(attributes_[i].index_, attributes_[i].size_, attributes_[i].type_, attributes_[i].normalized_, attributes_[i].stride_, pointer);
 						break;
 				}
+
+				// Always specified, as vertex array objects are reused for different formats
+				glVertexAttribDivisor(attributes_[i].index_, attributes_[i].divisor_);
 			}
 		}
 
@@ -54,6 +54,9 @@ namespace nCine
 			inline unsigned int baseOffset() const {
 				return baseOffset_;
 			}
+			inline GLuint divisor() const {
+				return divisor_;
+			}
 
 			void setVboParameters(GLsizei stride, const GLvoid* pointer);
 			inline void setVbo(const GLBufferObject* vbo) {
@@ -62,6 +65,9 @@ namespace nCine
 			inline void setBaseOffset(unsigned int baseOffset) {
 				baseOffset_ = baseOffset;
 			}
+			inline void setDivisor(GLuint divisor) {
+				divisor_ = divisor;
+			}
 
 			inline void setSize(GLint size) {
 				size_ = size;
@@ -84,6 +90,8 @@ namespace nCine
 			const GLvoid* pointer_;
 			/// Used to simulate missing `glDrawElementsBaseVertex()` on OpenGL ES 3.0
 			unsigned int baseOffset_;
+			/// Number of instances that share the same value, zero for per-vertex attributes
+			GLuint divisor_;
 
 			friend class GLVertexFormat;
 		};
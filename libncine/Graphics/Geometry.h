@@ -50,6 +50,15 @@ namespace nCine
 		inline void setNumElementsPerVertex(unsigned int numElements) {
 			numElementsPerVertex_ = numElements;
 		}
+		/// Returns `true` if vertex data contains per-instance attributes
+		inline bool hasPerInstanceVertices() const {
+			return perInstanceVertices_;
+		}
+		/// Sets whether vertex data contains per-instance attributes
+		/*! \note The VBO offset is then applied to attribute pointers instead of to the first vertex of the draw call */
+		inline void setPerInstanceVertices(bool perInstanceVertices) {
+			perInstanceVertices_ = perInstanceVertices;
+		}
 		/// Creates a custom VBO that is unique to this `Geometry` object
 		void createCustomVbo(unsigned int numFloats, GLenum usage);
 		/// Retrieves a pointer that can be used to write vertex data from a custom VBO owned by this object
@@ -127,6 +136,7 @@ namespace nCine
 
 		bool hasDirtyVertices_;
 		bool hasDirtyIndices_;
+		bool perInstanceVertices_;
 
 		void bind();
 		void draw(GLsizei numInstances);
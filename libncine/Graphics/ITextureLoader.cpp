@@ -69,7 +69,7 @@ namespace nCine
 	{
 		LOGD("Loading from file \"%s\"", filename.data());
 		// Creating a handle from IFile static method to detect assets file
-		return createLoader(fs::Open(filename, FileAccessMode::Read), filename);
+		return createLoader(fs::Open(filename, FileAccessMode::Read | FileAccessMode::MemoryMapped), filename);
 	}
 
 	std::unique_ptr<ITextureLoader> ITextureLoader::createLoader(std::unique_ptr<Stream> fileHandle, const StringView& filename)
@@ -16,7 +16,8 @@ namespace nCine
 
 	Material::Material(GLShaderProgram* program, GLTexture* texture)
 		: isBlendingEnabled_(false), srcBlendingFactor_(GL_SRC_ALPHA), destBlendingFactor_(GL_ONE_MINUS_SRC_ALPHA),
-			shaderProgramType_(ShaderProgramType::CUSTOM), shaderProgram_(program), uniformsHostBufferSize_(0)
+			shaderProgramType_(ShaderProgramType::CUSTOM), shaderProgram_(program), sortKey_(0),
+			sortKeyDirty_(true), uniformsHostBufferSize_(0)
 	{
 		for (unsigned int i = 0; i < GLTexture::MaxTextureUnits; i++) {
 			textures_[i] = nullptr;
@@ -32,6 +33,7 @@ namespace nCine
 	{
 		srcBlendingFactor_ = srcBlendingFactor;
 		destBlendingFactor_ = destBlendingFactor;
+		sortKeyDirty_ = true;
 	}
 
 	bool Material::setShaderProgramType(ShaderProgramType shaderProgramType)
@@ -54,6 +56,8 @@ namespace nCine
 
 		shaderProgramType_ = ShaderProgramType::CUSTOM;
 		shaderProgram_ = program;
+		// The handle of the program could also have changed if it has been linked again
+		sortKeyDirty_ = true;
 		// The camera uniforms are handled separately as they have a different update frequency
 		shaderUniforms_.setProgram(shaderProgram_, nullptr, ProjectionViewMatrixExcludeString);
 		shaderUniformBlocks_.setProgram(shaderProgram_);
@@ -116,7 +120,10 @@ namespace nCine
 	{
 		bool result = false;
 		if (unit < GLTexture::MaxTextureUnits) {
-			textures_[unit] = texture;
+			if (textures_[unit] != texture) {
+				textures_[unit] = texture;
+				sortKeyDirty_ = true;
+			}
 			result = true;
 		}
 		return result;
@@ -183,9 +190,14 @@ namespace nCine
 
 	uint32_t Material::sortKey()
 	{
+		if (!sortKeyDirty_) {
+			return sortKey_;
+		}
+
 		constexpr uint32_t Seed = 1697381921;
 		// Align to 64 bits for `fasthash64()` to properly work on Emscripten without alignment faults
-		static SortHashData hashData alignas(8);
+		// Not static, because render commands can be added to queues of different viewports in parallel
+		SortHashData hashData alignas(8);
 
 		for (unsigned int i = 0; i < GLTexture::MaxTextureUnits; i++) {
 			hashData.textures[i] = (textures_[i] != nullptr) ? textures_[i]->glHandle() : 0;
@@ -194,6 +206,8 @@ namespace nCine
 		hashData.srcBlendingFactor = glBlendingFactorToInt(srcBlendingFactor_);
 		hashData.destBlendingFactor = glBlendingFactorToInt(destBlendingFactor_);
 
-		return fasthash32(reinterpret_cast<const void*>(&hashData), sizeof(SortHashData), Seed);
+		sortKey_ = fasthash32(reinterpret_cast<const void*>(&hashData), sizeof(SortHashData), Seed);
+		sortKeyDirty_ = false;
+		return sortKey_;
 	}
 }
@@ -52,6 +52,8 @@ namespace nCine
 			//BATCHED_TEXTNODES_ALPHA,
 			/// Shader program for a batch of TextNode classes with grayscale font texture
 			//BATCHED_TEXTNODES_RED,
+			/// Shader program for Sprite classes drawn with instanced rendering
+			INSTANCED_SPRITES,
 			/// A custom shader program
 			CUSTOM
 		};
@@ -78,6 +80,11 @@ namespace nCine
 		static constexpr char MeshIndexAttributeName[] = "aMeshIndex";
 		static constexpr char ColorAttributeName[] = "aColor";
 
+		// Per-instance attribute names for instanced shaders, the model matrix is split into four columns
+		static constexpr char ModelMatrixColumnAttributeNames[4][14] = { "aModelMatrix0", "aModelMatrix1", "aModelMatrix2", "aModelMatrix3" };
+		static constexpr char TexRectAttributeName[] = "aTexRect";
+		static constexpr char SpriteSizeAttributeName[] = "aSpriteSize";
+
 		/// Default constructor
 		Material();
 		Material(GLShaderProgram* program, GLTexture* texture);
@@ -163,6 +170,10 @@ namespace nCine
 		GLShaderUniformBlocks shaderUniformBlocks_;
 		const GLTexture* textures_[GLTexture::MaxTextureUnits];
 
+		/// Cached sort key, it's recalculated only after a setter has invalidated it
+		uint32_t sortKey_;
+		bool sortKeyDirty_;
+
 		/// The size of the memory buffer containing uniform values
 		unsigned int uniformsHostBufferSize_;
 		/// Memory buffer with uniform values to be sent to the GPU
@@ -179,6 +190,7 @@ namespace nCine
 		}
 		/// Wrapper around `GLShaderProgram::defineVertexFormat()`
 		void defineVertexFormat(const GLBufferObject* vbo, const GLBufferObject* ibo, unsigned int vboOffset);
+		/// Returns the cached sort key, calculating it again only if the material has changed
 		uint32_t sortKey();
 
 		friend class RenderCommand;
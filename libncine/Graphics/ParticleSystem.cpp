@@ -223,7 +223,7 @@ namespace nCine
 			}
 		}
 
-		lastFrameUpdated_ = theApplication().numFrames();
+		lastFrameUpdated_ = theApplication().numUpdates();
 
 #if defined(WITH_TRACY)
 		// TODO: Tracy
@@ -38,6 +38,8 @@ namespace nCine
 		ASSERT(minBatchSize > 1);
 		ASSERT(maxBatchSize >= minBatchSize);
 
+		const bool withInstancedSprites = theApplication().appConfiguration().withInstancedSprites;
+
 		unsigned int lastSplit = 0;
 
 		for (unsigned int i = 1; i < srcQueue.size(); i++) {
@@ -56,8 +58,19 @@ namespace nCine
 
 			// Split point if last command or split condition
 			if (i == srcQueue.size() - 1 || shouldSplit) {
+				const GLShaderProgram* instancedShader = (withInstancedSprites ? RenderResources::instancedShader(prevCommand->material().shaderProgram()) : nullptr);
 				const GLShaderProgram* batchedShader = RenderResources::batchedShader(prevCommand->material().shaderProgram());
-				if (batchedShader && (endSplit - lastSplit) >= minBatchSize) {
+				if (instancedShader && (endSplit - lastSplit) >= minBatchSize) {
+					// Instanced draw calls are limited only by the size of the per-instance vertex buffer
+					while (lastSplit < endSplit) {
+						SmallVectorImpl<RenderCommand*>::const_iterator start = srcQueue.begin() + lastSplit;
+						SmallVectorImpl<RenderCommand*>::const_iterator end = srcQueue.begin() + endSplit;
+
+						RenderCommand* instancedCommand = collectInstances(start, end, start);
+						destQueue.push_back(instancedCommand);
+						lastSplit = start - srcQueue.begin();
+					}
+				} else if (batchedShader && (endSplit - lastSplit) >= minBatchSize) {
 					// Split point for the maximum batch size
 					while (lastSplit < endSplit) {
 						unsigned int currentMaxBatchSize = maxBatchSize;
@@ -372,6 +385,104 @@ namespace nCine
 		return batchCommand;
 	}
 
+	RenderCommand* RenderBatcher::collectInstances(
+		SmallVectorImpl<RenderCommand*>::const_iterator start,
+		SmallVectorImpl<RenderCommand*>::const_iterator end,
+		SmallVectorImpl<RenderCommand*>::const_iterator& nextStart)
+	{
+		ASSERT(end > start);
+
+		RenderCommand* refCommand = *start;
+		GLShaderProgram* instancedShader = RenderResources::instancedShader(refCommand->material().shaderProgram());
+		// The following check should never fail as it is already checked by the calling function
+		FATAL_ASSERT_MSG(instancedShader != nullptr, "Unsupported shader for instanced element");
+		bool commandAdded = false;
+		RenderCommand* instancedCommand = RenderResources::renderCommandPool().retrieveOrAdd(instancedShader, commandAdded);
+		if (commandAdded) {
+			instancedCommand->setType(refCommand->type());
+		}
+
+		// All commands share the same shader, so the offsets of instance uniforms are retrieved only once
+		GLUniformBlockCache* refInstanceBlock = refCommand->material().uniformBlock(Material::InstanceBlockName);
+		FATAL_ASSERT_MSG(refInstanceBlock != nullptr, "Instanced element does not have an %s uniform block", Material::InstanceBlockName);
+		const GLUniformCache* modelMatrixUniform = refInstanceBlock->uniform(Material::ModelMatrixUniformName);
+		const GLUniformCache* colorUniform = refInstanceBlock->uniform(Material::ColorUniformName);
+		const GLUniformCache* texRectUniform = refInstanceBlock->uniform(Material::TexRectUniformName);
+		const GLUniformCache* spriteSizeUniform = refInstanceBlock->uniform(Material::SpriteSizeUniformName);
+		FATAL_ASSERT(modelMatrixUniform != nullptr && colorUniform != nullptr && texRectUniform != nullptr && spriteSizeUniform != nullptr);
+		const GLubyte* refBlockData = refInstanceBlock->dataPointer();
+		const std::ptrdiff_t modelMatrixOffset = modelMatrixUniform->dataPointer() - refBlockData;
+		const std::ptrdiff_t colorOffset = colorUniform->dataPointer() - refBlockData;
+		const std::ptrdiff_t texRectOffset = texRectUniform->dataPointer() - refBlockData;
+		const std::ptrdiff_t spriteSizeOffset = spriteSizeUniform->dataPointer() - refBlockData;
+
+		// Don't request more bytes than a common VBO can hold
+		const unsigned long maxVertexDataSize = RenderResources::buffersManager().specs(RenderBuffersManager::BufferTypes::Array).maxSize;
+		const unsigned long maxInstances = maxVertexDataSize / sizeof(RenderResources::InstanceFormatSprite);
+		nextStart = ((unsigned long)(end - start) > maxInstances ? start + maxInstances : end);
+		const unsigned int numInstances = (unsigned int)(nextStart - start);
+
+		const unsigned long nonBlockUniformsSize = instancedShader->uniformsSize();
+		instancedCommand->material().setUniformsDataPointer(acquireMemory(nonBlockUniformsSize));
+
+		// Setting sampler uniforms for GL_TEXTURE* units
+		const GLShaderUniforms::UniformHashMapType allUniforms = refCommand->material().allUniforms();
+		for (const GLUniformCache& uniformCache : allUniforms) {
+			if (uniformCache.uniform()->type() == GL_SAMPLER_2D) {
+				GLUniformCache* instancedUniformCache = instancedCommand->material().uniform(uniformCache.uniform()->name());
+				if (instancedUniformCache == nullptr) {
+					continue;
+				}
+				const int refValue = uniformCache.intValue(0);
+				const int instancedValue = instancedUniformCache->intValue(0);
+				// Also checking if the command has just been added, as the memory at the
+				// uniforms data pointer is not cleared and might contain the reference value
+				if (instancedValue != refValue || commandAdded) {
+					instancedUniformCache->setIntValue(refValue);
+				}
+			}
+		}
+
+		constexpr unsigned int NumFloatsInstanceFormat = sizeof(RenderResources::InstanceFormatSprite) / sizeof(GLfloat);
+		RenderResources::InstanceFormatSprite* destInstance = reinterpret_cast<RenderResources::InstanceFormatSprite*>(
+			instancedCommand->geometry().acquireVertexPointer(numInstances * NumFloatsInstanceFormat, NumFloatsInstanceFormat));
+
+		SmallVectorImpl<RenderCommand*>::const_iterator it = start;
+		while (it != nextStart) {
+			RenderCommand* command = *it;
+			// Also updates the depth stored in the model matrix
+			command->commitNodeTransformation();
+
+			const GLubyte* blockData = command->material().uniformBlock(Material::InstanceBlockName)->dataPointer();
+			memcpy(destInstance->modelMatrix, blockData + modelMatrixOffset, sizeof(destInstance->modelMatrix));
+			memcpy(destInstance->color, blockData + colorOffset, sizeof(destInstance->color));
+			memcpy(destInstance->texRect, blockData + texRectOffset, sizeof(destInstance->texRect));
+			memcpy(destInstance->spriteSize, blockData + spriteSizeOffset, sizeof(destInstance->spriteSize));
+			destInstance++;
+			++it;
+		}
+
+		instancedCommand->geometry().releaseVertexPointer();
+
+		for (unsigned int i = 0; i < GLTexture::MaxTextureUnits; i++) {
+			instancedCommand->material().setTexture(i, refCommand->material().texture(i));
+		}
+		instancedCommand->material().setBlendingEnabled(refCommand->material().isBlendingEnabled());
+		instancedCommand->material().setBlendingFactors(refCommand->material().srcBlendingFactor(), refCommand->material().destBlendingFactor());
+		instancedCommand->setBatchSize(numInstances);
+		instancedCommand->setNumInstances(numInstances);
+		instancedCommand->setLayer(refCommand->layer());
+		instancedCommand->setVisitOrder(refCommand->visitOrder());
+
+		// Sprite quads are generated from `gl_VertexID` as a triangle strip, the vertex buffer contains only per-instance data
+		instancedCommand->geometry().setPerInstanceVertices(true);
+		instancedCommand->geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, 4);
+		instancedCommand->geometry().setNumElementsPerVertex(NumFloatsInstanceFormat);
+		instancedCommand->geometry().setNumIndices(0);
+
+		return instancedCommand;
+	}
+
 	unsigned char* RenderBatcher::acquireMemory(unsigned int bytes)
 	{
 		FATAL_ASSERT(bytes <= UboMaxSize);
@@ -16,7 +16,6 @@ namespace nCine
 	public:
 		RenderBatcher();
 
-		void collectInstances(const SmallVectorImpl<RenderCommand*>& srcQueue, SmallVectorImpl<RenderCommand*>& destQueue);
 		void createBatches(const SmallVectorImpl<RenderCommand*>& srcQueue, SmallVectorImpl<RenderCommand*>& destQueue);
 		void reset();
 
@@ -38,6 +37,8 @@ namespace nCine
 		SmallVector<ManagedBuffer, 0> buffers_;
 
 		RenderCommand* collectCommands(SmallVectorImpl<RenderCommand*>::const_iterator start, SmallVectorImpl<RenderCommand*>::const_iterator end, SmallVectorImpl<RenderCommand*>::const_iterator& nextStart);
+		/// Collects commands into a single instanced draw call, writing one element of the per-instance vertex buffer for each of them
+		RenderCommand* collectInstances(SmallVectorImpl<RenderCommand*>::const_iterator start, SmallVectorImpl<RenderCommand*>::const_iterator end, SmallVectorImpl<RenderCommand*>::const_iterator& nextStart);
 
 		unsigned char* acquireMemory(unsigned int bytes);
 		void createBuffer(unsigned int size);
@@ -43,9 +43,13 @@ namespace nCine
 		}
 
 		unsigned int offset = 0;
+		if (geometry_.perInstanceVertices_) {
+			// Per-instance attributes are not affected by the first vertex, so the offset is applied to their pointers
+			offset = geometry_.vboParams().offset;
+		}
 #if (defined(WITH_OPENGLES) && !GL_ES_VERSION_3_2) || defined(DEATH_TARGET_EMSCRIPTEN)
 		// Simulating missing `glDrawElementsBaseVertex()` on OpenGL ES 3.0
-		if (geometry_.numIndices_ > 0) {
+		else if (geometry_.numIndices_ > 0) {
 			offset = geometry_.vboParams().offset + (geometry_.firstVertex_ * geometry_.numElementsPerVertex_ * sizeof(GLfloat));
 		}
 #endif
@@ -10,6 +10,12 @@
 #include "../Base/Algorithms.h"
 #include "../tracy_opengl.h"
 
+#if defined(NCINE_PROFILING)
+#	include "../Base/TimeStamp.h"
+#endif
+
+#include <cstring>
+
 namespace nCine
 {
 #if defined(DEATH_DEBUG)
@@ -80,9 +86,15 @@ namespace nCine
 	{
 		const bool batchingEnabled = theApplication().renderingSettings().batchingEnabled;
 
+#if defined(NCINE_PROFILING)
+		TimeStamp sortStart = TimeStamp::now();
+#endif
 		// Sorting the queues with the relevant orders
-		quicksort(opaqueQueue_.begin(), opaqueQueue_.end(), descendingOrder);
-		quicksort(transparentQueue_.begin(), transparentQueue_.end(), ascendingOrder);
+		sortQueue(opaqueQueue_, true);
+		sortQueue(transparentQueue_, false);
+#if defined(NCINE_PROFILING)
+		RenderStatistics::addSortTime(sortStart.secondsSince());
+#endif
 
 		SmallVectorImpl<RenderCommand*>* opaques = batchingEnabled ? &opaqueBatchedQueue_ : &opaqueQueue_;
 		SmallVectorImpl<RenderCommand*>* transparents = batchingEnabled ? &transparentBatchedQueue_ : &transparentQueue_;
@@ -94,6 +106,9 @@ namespace nCine
 			RenderResources::renderBatcher().createBatches(transparentQueue_, transparentBatchedQueue_);
 		}
 
+#if defined(NCINE_PROFILING)
+		TimeStamp commitStart = TimeStamp::now();
+#endif
 		// Avoid GPU stalls by uploading to VBOs, IBOs and UBOs before drawing
 		if (!opaques->empty()) {
 			ZoneScopedN("Commit opaques");
@@ -116,6 +131,9 @@ namespace nCine
 				transparentRenderCommand->commitAll();
 			}
 		}
+#if defined(NCINE_PROFILING)
+		RenderStatistics::addCommitTime(commitStart.secondsSince());
+#endif
 	}
 
 	void RenderQueue::draw()
@@ -197,6 +215,78 @@ namespace nCine
 		GLScissorTest::disable();
 	}
 
+	void RenderQueue::sortQueue(SmallVectorImpl<RenderCommand*>& queue, bool descending)
+	{
+		const unsigned int count = (unsigned int)queue.size();
+		if (count < MinRadixSortSize) {
+			if (descending) {
+				quicksort(queue.begin(), queue.end(), descendingOrder);
+			} else {
+				quicksort(queue.begin(), queue.end(), ascendingOrder);
+			}
+			return;
+		}
+
+		// Both keys are inverted for descending order, so the radix sort itself is always ascending
+		const uint64_t materialKeyMask = (descending ? ~uint64_t(0) : 0);
+		const uint32_t idKeyMask = (descending ? ~uint32_t(0) : 0);
+
+		sortEntries_.resize_for_overwrite(count);
+		sortEntriesTemp_.resize_for_overwrite(count);
+
+		// Keys are sorted as one 96-bit number, the least significant digits belong to the id sort key
+		constexpr unsigned int NumDigits = 12;
+		unsigned int histograms[NumDigits][256];
+		std::memset(histograms, 0, sizeof(histograms));
+
+		for (unsigned int i = 0; i < count; i++) {
+			SortEntry& entry = sortEntries_[i];
+			entry.materialSortKey = queue[i]->materialSortKey() ^ materialKeyMask;
+			entry.idSortKey = queue[i]->idSortKey() ^ idKeyMask;
+			entry.index = i;
+
+			for (unsigned int j = 0; j < 4; j++) {
+				histograms[j][(entry.idSortKey >> (j * 8)) & 0xFF]++;
+			}
+			for (unsigned int j = 0; j < 8; j++) {
+				histograms[4 + j][(entry.materialSortKey >> (j * 8)) & 0xFF]++;
+			}
+		}
+
+		SortEntry* src = sortEntries_.data();
+		SortEntry* dst = sortEntriesTemp_.data();
+		for (unsigned int digit = 0; digit < NumDigits; digit++) {
+			unsigned int* histogram = histograms[digit];
+			const unsigned int shift = (digit < 4 ? digit * 8 : (digit - 4) * 8);
+
+			// Skipping the pass if all entries share the same value of this digit, which is common for layers and ids
+			const unsigned int firstValue = (digit < 4 ? (src[0].idSortKey >> shift) : (src[0].materialSortKey >> shift)) & 0xFF;
+			if (histogram[firstValue] == count) {
+				continue;
+			}
+
+			unsigned int offset = 0;
+			for (unsigned int i = 0; i < 256; i++) {
+				const unsigned int bucketSize = histogram[i];
+				histogram[i] = offset;
+				offset += bucketSize;
+			}
+
+			for (unsigned int i = 0; i < count; i++) {
+				const unsigned int value = (digit < 4 ? (src[i].idSortKey >> shift) : (src[i].materialSortKey >> shift)) & 0xFF;
+				dst[histogram[value]++] = src[i];
+			}
+
+			std::swap(src, dst);
+		}
+
+		sortedQueue_.resize_for_overwrite(count);
+		for (unsigned int i = 0; i < count; i++) {
+			sortedQueue_[i] = queue[src[i].index];
+		}
+		std::memcpy(queue.data(), sortedQueue_.data(), count * sizeof(RenderCommand*));
+	}
+
 	void RenderQueue::clear()
 	{
 		opaqueQueue_.clear();
@@ -30,6 +30,17 @@ namespace nCine
 		void clear();
 
 	private:
+		/// Sorting entry with packed keys of a render command and its position in the unsorted queue
+		struct SortEntry
+		{
+			uint64_t materialSortKey;
+			uint32_t idSortKey;
+			uint32_t index;
+		};
+
+		/// Queues with fewer commands than this are sorted with a comparison sort
+		static constexpr unsigned int MinRadixSortSize = 64;
+
 		/// Array of opaque render command pointers
 		SmallVector<RenderCommand*, 0> opaqueQueue_;
 		/// Array of opaque batched render command pointers
@@ -38,6 +49,16 @@ namespace nCine
 		SmallVector<RenderCommand*, 0> transparentQueue_;
 		/// Array of transparent batched render command pointers
 		SmallVector<RenderCommand*, 0> transparentBatchedQueue_;
+
+		/// Sorting entries, reused between frames to avoid allocations
+		SmallVector<SortEntry, 0> sortEntries_;
+		/// Temporary buffer for sorting entries used by radix sort passes
+		SmallVector<SortEntry, 0> sortEntriesTemp_;
+		/// Temporary buffer used to reorder command pointers after sorting
+		SmallVector<RenderCommand*, 0> sortedQueue_;
+
+		/// Sorts the queue by material sort key and then by id sort key, in ascending or descending order
+		void sortQueue(SmallVectorImpl<RenderCommand*>& queue, bool descending);
 	};
 
 }
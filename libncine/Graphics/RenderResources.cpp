@@ -46,13 +46,14 @@ namespace nCine
 
 	std::unique_ptr<GLShaderProgram> RenderResources::defaultShaderPrograms_[DefaultShaderProgramsCount];
 	HashMap<const GLShaderProgram*, GLShaderProgram*> RenderResources::batchedShaders_(32);
+	HashMap<const GLShaderProgram*, GLShaderProgram*> RenderResources::instancedShaders_(32);
 
 	unsigned char RenderResources::cameraUniformsBuffer_[UniformsBufferSize];
 	HashMap<GLShaderProgram*, RenderResources::CameraUniformData> RenderResources::cameraUniformDataMap_(32);
 
 	Camera* RenderResources::currentCamera_ = nullptr;
 	std::unique_ptr<Camera> RenderResources::defaultCamera_;
-	Viewport* RenderResources::currentViewport_ = nullptr;
+	DEATH_THREAD_LOCAL Viewport* RenderResources::currentViewport_ = nullptr;
 
 	GLShaderProgram* RenderResources::shaderProgram(Material::ShaderProgramType shaderProgramType)
 	{
@@ -80,6 +81,27 @@ namespace nCine
 		return (batchedShaders_.erase(shader) > 0);
 	}
 
+	GLShaderProgram* RenderResources::instancedShader(const GLShaderProgram* shader)
+	{
+		auto it = instancedShaders_.find(shader);
+		return (it != instancedShaders_.end() ? it->second : nullptr);
+	}
+
+	bool RenderResources::registerInstancedShader(const GLShaderProgram* shader, GLShaderProgram* instancedShader)
+	{
+		FATAL_ASSERT(shader != nullptr);
+		FATAL_ASSERT(instancedShader != nullptr);
+		FATAL_ASSERT(shader != instancedShader);
+
+		return instancedShaders_.emplace(shader, instancedShader).second;
+	}
+
+	bool RenderResources::unregisterInstancedShader(const GLShaderProgram* shader)
+	{
+		ASSERT(shader != nullptr);
+		return (instancedShaders_.erase(shader) > 0);
+	}
+
 	RenderResources::CameraUniformData* RenderResources::findCameraUniformData(GLShaderProgram* shaderProgram)
 	{
 		auto it = cameraUniformDataMap_.find(shaderProgram);
@@ -111,6 +133,33 @@ namespace nCine
 		GLVertexFormat::Attribute* texCoordsAttribute = shaderProgram.attribute(Material::TexCoordsAttributeName);
 		GLVertexFormat::Attribute* meshIndexAttribute = shaderProgram.attribute(Material::MeshIndexAttributeName);
 
+		// Instanced shaders read all their attributes from the per-instance vertex buffer
+		if (shaderProgram.attribute(Material::ModelMatrixColumnAttributeNames[0]) != nullptr) {
+			for (unsigned int i = 0; i < countof(Material::ModelMatrixColumnAttributeNames); i++) {
+				GLVertexFormat::Attribute* columnAttribute = shaderProgram.attribute(Material::ModelMatrixColumnAttributeNames[i]);
+				if (columnAttribute != nullptr && columnAttribute->stride() == 0) {
+					columnAttribute->setVboParameters(sizeof(InstanceFormatSprite), reinterpret_cast<void*>(offsetof(InstanceFormatSprite, modelMatrix) + i * 4 * sizeof(GLfloat)));
+					columnAttribute->setDivisor(1);
+				}
+			}
+			GLVertexFormat::Attribute* colorAttribute = shaderProgram.attribute(Material::ColorAttributeName);
+			if (colorAttribute != nullptr && colorAttribute->stride() == 0) {
+				colorAttribute->setVboParameters(sizeof(InstanceFormatSprite), reinterpret_cast<void*>(offsetof(InstanceFormatSprite, color)));
+				colorAttribute->setDivisor(1);
+			}
+			GLVertexFormat::Attribute* texRectAttribute = shaderProgram.attribute(Material::TexRectAttributeName);
+			if (texRectAttribute != nullptr && texRectAttribute->stride() == 0) {
+				texRectAttribute->setVboParameters(sizeof(InstanceFormatSprite), reinterpret_cast<void*>(offsetof(InstanceFormatSprite, texRect)));
+				texRectAttribute->setDivisor(1);
+			}
+			GLVertexFormat::Attribute* spriteSizeAttribute = shaderProgram.attribute(Material::SpriteSizeAttributeName);
+			if (spriteSizeAttribute != nullptr && spriteSizeAttribute->stride() == 0) {
+				spriteSizeAttribute->setVboParameters(sizeof(InstanceFormatSprite), reinterpret_cast<void*>(offsetof(InstanceFormatSprite, spriteSize)));
+				spriteSizeAttribute->setDivisor(1);
+			}
+			return;
+		}
+
 		// The stride check avoid overwriting VBO parameters for custom mesh shaders attributes
 		if (positionAttribute != nullptr && texCoordsAttribute != nullptr && meshIndexAttribute != nullptr) {
 			if (positionAttribute->stride() == 0) {
@@ -229,7 +278,8 @@ namespace nCine
 			//{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_MESH_SPRITES_GRAY)], ShaderStrings::batched_meshsprites_vs + 1, ShaderStrings::sprite_gray_fs + 1, GLShaderProgram::Introspection::NoUniformsInBlocks, "Batched_MeshSprites_Gray" },
 			{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_MESH_SPRITES_NO_TEXTURE)], ShaderStrings::batched_meshsprites_notexture_vs + 1, ShaderStrings::sprite_notexture_fs + 1, GLShaderProgram::Introspection::NoUniformsInBlocks, "Batched_MeshSprites_NoTexture" },
 			//{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_ALPHA)], ShaderStrings::batched_textnodes_vs + 1, ShaderStrings::textnode_alpha_fs + 1, GLShaderProgram::Introspection::NoUniformsInBlocks, "Batched_TextNodes_Alpha" },
-			//{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_RED)], ShaderStrings::batched_textnodes_vs + 1, ShaderStrings::textnode_red_fs + 1, GLShaderProgram::Introspection::NoUniformsInBlocks, "Batched_TextNodes_Red" }
+			//{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_RED)], ShaderStrings::batched_textnodes_vs + 1, ShaderStrings::textnode_red_fs + 1, GLShaderProgram::Introspection::NoUniformsInBlocks, "Batched_TextNodes_Red" },
+			{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::INSTANCED_SPRITES)], ShaderStrings::instanced_sprites_vs + 1, ShaderStrings::sprite_fs + 1, GLShaderProgram::Introspection::Enabled, "Instanced_Sprites" }
 #else
 			{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::SPRITE)], "sprite_vs.glsl", "sprite_fs.glsl", GLShaderProgram::Introspection::Enabled, "Sprite" },
 			//{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::SPRITE_GRAY)], "sprite_vs.glsl", "sprite_gray_fs.glsl", GLShaderProgram::Introspection::Enabled, "Sprite_Gray" },
@@ -246,7 +296,8 @@ namespace nCine
 			//{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_MESH_SPRITES_GRAY)], "batched_meshsprites_vs.glsl", "sprite_gray_fs.glsl", GLShaderProgram::Introspection::NoUniformsInBlocks, "Batched_MeshSprites_Gray" },
 			{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_MESH_SPRITES_NO_TEXTURE)], "batched_meshsprites_notexture_vs.glsl", "sprite_notexture_fs.glsl", GLShaderProgram::Introspection::NoUniformsInBlocks, "Batched_MeshSprites_NoTexture" },
 			//{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_ALPHA)], "batched_textnodes_vs.glsl", "textnode_alpha_fs.glsl", GLShaderProgram::Introspection::NoUniformsInBlocks, "Batched_TextNodes_Alpha" },
-			//{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_RED)], "batched_textnodes_vs.glsl", "textnode_red_fs.glsl", GLShaderProgram::Introspection::NoUniformsInBlocks, "Batched_TextNodes_Red" }
+			//{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_RED)], "batched_textnodes_vs.glsl", "textnode_red_fs.glsl", GLShaderProgram::Introspection::NoUniformsInBlocks, "Batched_TextNodes_Red" },
+			{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::INSTANCED_SPRITES)], "instanced_sprites_vs.glsl", "sprite_fs.glsl", GLShaderProgram::Introspection::Enabled, "Instanced_Sprites" }
 #endif
 		};
 
@@ -394,5 +445,7 @@ namespace nCine
 		batchedShaders_.emplace(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::MESH_SPRITE_NO_TEXTURE)].get(), defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_MESH_SPRITES_NO_TEXTURE)].get());
 		//batchedShaders_.emplace(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::TEXTNODE_ALPHA)].get(), defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_ALPHA)].get());
 		//batchedShaders_.emplace(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::TEXTNODE_RED)].get(), defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_RED)].get());
+
+		instancedShaders_.emplace(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::SPRITE)].get(), defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::INSTANCED_SPRITES)].get());
 	}
 }
@@ -53,6 +53,15 @@ namespace nCine
 			int drawindex;
 		};
 
+		/// An instance format structure for sprites drawn with instanced rendering
+		struct InstanceFormatSprite
+		{
+			GLfloat modelMatrix[16];
+			GLfloat color[4];
+			GLfloat texRect[4];
+			GLfloat spriteSize[2];
+		};
+
 		struct CameraUniformData
 		{
 			CameraUniformData()
@@ -86,6 +95,10 @@ namespace nCine
 		static bool registerBatchedShader(const GLShaderProgram* shader, GLShaderProgram* batchedShader);
 		static bool unregisterBatchedShader(const GLShaderProgram* shader);
 
+		static GLShaderProgram* instancedShader(const GLShaderProgram* shader);
+		static bool registerInstancedShader(const GLShaderProgram* shader, GLShaderProgram* instancedShader);
+		static bool unregisterInstancedShader(const GLShaderProgram* shader);
+
 		static inline unsigned char* cameraUniformsBuffer() {
 			return cameraUniformsBuffer_;
 		}
@@ -116,6 +129,7 @@ namespace nCine
 		static constexpr unsigned int DefaultShaderProgramsCount = static_cast<unsigned int>(Material::ShaderProgramType::CUSTOM);
 		static std::unique_ptr<GLShaderProgram> defaultShaderPrograms_[DefaultShaderProgramsCount];
 		static HashMap<const GLShaderProgram*, GLShaderProgram*> batchedShaders_;
+		static HashMap<const GLShaderProgram*, GLShaderProgram*> instancedShaders_;
 
 		static constexpr unsigned int UniformsBufferSize = 128; // two 4x4 float matrices
 		static unsigned char cameraUniformsBuffer_[UniformsBufferSize];
@@ -123,7 +137,8 @@ namespace nCine
 
 		static Camera* currentCamera_;
 		static std::unique_ptr<Camera> defaultCamera_;
-		static Viewport* currentViewport_;
+		/// The viewport being visited or drawn, it's thread-local because viewports can be visited in parallel
+		static DEATH_THREAD_LOCAL Viewport* currentViewport_;
 
 		static void setCurrentCamera(Camera* camera);
 		static void updateCameraUniforms();
@@ -12,9 +12,10 @@ namespace nCine
 	RenderStatistics::CustomBuffers RenderStatistics::customVbos_;
 	RenderStatistics::CustomBuffers RenderStatistics::customIbos_;
 	unsigned int RenderStatistics::index_ = 0;
-	unsigned int RenderStatistics::culledNodes_[2] = { 0, 0 };
+	Atomic32 RenderStatistics::culledNodes_[2];
 	RenderStatistics::VaoPool RenderStatistics::vaoPool_;
 	RenderStatistics::CommandPool RenderStatistics::commandPool_;
+	RenderStatistics::Timings RenderStatistics::timings_[2];
 
 	void RenderStatistics::reset()
 	{
@@ -33,6 +34,7 @@ namespace nCine
 		// Ping pong index for last and current frame
 		index_ = (index_ + 1) % 2;
 		culledNodes_[index_] = 0;
+		timings_[index_].reset();
 
 		vaoPool_.reset();
 		commandPool_.reset();
@@ -3,6 +3,7 @@
 #if defined(NCINE_PROFILING)
 
 #include "RenderCommand.h"
+#include "../Threading/Atomic.h"
 
 namespace nCine
 {
@@ -132,6 +133,26 @@ namespace nCine
 			friend RenderStatistics;
 		};
 
+		class Timings
+		{
+		public:
+			/// Time in seconds spent sorting the render queues of all viewports
+			float sort;
+			/// Time in seconds spent batching and committing the render queues of all viewports
+			float commit;
+
+			Timings()
+				: sort(0.0f), commit(0.0f) {}
+
+		private:
+			void reset()
+			{
+				sort = 0.0f;
+				commit = 0.0f;
+			}
+			friend RenderStatistics;
+		};
+
 		/// Returns the aggregated command statistics for all types
 		static inline const Commands& allCommands() {
 			return allCommands_;
@@ -176,6 +197,11 @@ namespace nCine
 			return commandPool_;
 		}
 
+		/// Returns time spent sorting and committing render queues in the last frame
+		static inline const Timings& timings() {
+			return timings_[(index_ + 1) % 2];
+		}
+
 	private:
 		static Commands allCommands_;
 		static Commands typedCommands_[(int)RenderCommand::CommandTypes::Count];
@@ -184,9 +210,11 @@ namespace nCine
 		static CustomBuffers customVbos_;
 		static CustomBuffers customIbos_;
 		static unsigned int index_;
-		static unsigned int culledNodes_[2];
+		/// Culled nodes are counted atomically, because viewports can be visited in parallel
+		static Atomic32 culledNodes_[2];
 		static VaoPool vaoPool_;
 		static CommandPool commandPool_;
+		static Timings timings_[2];
 
 		static void reset();
 		static void gatherStatistics(const RenderCommand& command);
@@ -243,6 +271,12 @@ namespace nCine
 		static inline void addCommandPoolRetrieval() {
 			commandPool_.retrievals++;
 		}
+		static inline void addSortTime(float seconds) {
+			timings_[index_].sort += seconds;
+		}
+		static inline void addCommitTime(float seconds) {
+			timings_[index_].commit += seconds;
+		}
 
 		friend class ScreenViewport;
 		friend class RenderQueue;
@@ -262,7 +262,7 @@ namespace nCine
 			shouldDeleteChildrenOnDestruction_ = shouldDeleteChildrenOnDestruction;
 		}
 
-		/// Returns the last frame in which any of the viewports have updtated this node
+		/// Returns the last update in which any of the viewports have updtated this node (see `Application::numUpdates()`)
 		inline unsigned long int lastFrameUpdated() const {
 			return lastFrameUpdated_;
 		}
@@ -341,7 +341,7 @@ namespace nCine
 		/// Bitset that stores the various dirty states bits
 		BitSet<uint8_t> dirtyBits_;
 
-		/// The last frame any viewport updated this node
+		/// The last update any viewport updated this node
 		unsigned long int lastFrameUpdated_;
 
 		/// Deleted assignment operator
@@ -4,6 +4,7 @@
 #include "RenderResources.h"
 #include "RenderStatistics.h"
 #include "../Application.h"
+#include "../ServiceLocator.h"
 #include "DisplayMode.h"
 #include "GL/GLClearColor.h"
 #include "GL/GLViewport.h"
@@ -12,9 +13,40 @@
 
 namespace nCine
 {
+#if defined(WITH_THREADS)
+	/// Thread pool command that helps with the visit of viewports in the current frame
+	class ScreenViewport::VisitCommand : public IThreadCommand
+	{
+	public:
+		explicit VisitCommand(std::shared_ptr<VisitHandle> handle)
+			: handle_(std::move(handle)) {}
+
+		void Execute() override
+		{
+			// The viewport can't be destroyed while the mutex is locked, and it's unlocked only during a visit of a claimed viewport,
+			// which is always awaited by the main thread
+			handle_->mutex.Lock();
+			if (handle_->owner != nullptr) {
+				handle_->owner->visitClaimedViewports(true);
+			}
+			handle_->mutex.Unlock();
+		}
+
+	private:
+		std::shared_ptr<VisitHandle> handle_;
+	};
+#endif
+
 	ScreenViewport::ScreenViewport()
 		: Viewport()
 	{
+#if defined(WITH_THREADS)
+		visitHandle_ = std::make_shared<VisitHandle>();
+		visitHandle_->owner = this;
+		nextVisitIndex_ = 0;
+		runningVisits_ = 0;
+		queuedVisitCommands_ = 0;
+#endif
 		width_ = theApplication().width();
 		height_ = theApplication().height();
 		viewportRect_.Set(0, 0, width_, height_);
@@ -29,6 +61,16 @@ namespace nCine
 		type_ = Type::Screen;
 	}
 
+	ScreenViewport::~ScreenViewport()
+	{
+#if defined(WITH_THREADS)
+		// Commands that are still queued will find no owner and return immediately
+		visitHandle_->mutex.Lock();
+		visitHandle_->owner = nullptr;
+		visitHandle_->mutex.Unlock();
+#endif
+	}
+
 	void ScreenViewport::resize(int width, int height)
 	{
 		if (width == width_ && height == height_) {
@@ -48,6 +90,14 @@ namespace nCine
 
 	void ScreenViewport::update()
 	{
+		// The scenegraph can be updated more than once per frame with fixed update rate
+		for (unsigned int i = 0; i < chain_.size(); i++) {
+			if (chain_[i]) {
+				chain_[i]->stateBits_.reset(StateBitPositions::UpdatedBit);
+			}
+		}
+		stateBits_.reset(StateBitPositions::UpdatedBit);
+
 		for (int i = (int)chain_.size() - 1; i >= 0; i--) {
 			if (chain_[i] && !chain_[i]->stateBits_.test(StateBitPositions::UpdatedBit)) {
 				chain_[i]->update();
@@ -58,6 +108,13 @@ namespace nCine
 
 	void ScreenViewport::visit()
 	{
+#if defined(WITH_THREADS)
+		if (theApplication().renderingSettings().parallelVisitEnabled && theServiceLocator().hasThreadPool()) {
+			visitParallel();
+			return;
+		}
+#endif
+
 		for (int i = (int)chain_.size() - 1; i >= 0; i--) {
 			if (chain_[i] && !chain_[i]->stateBits_.test(StateBitPositions::VisitedBit)) {
 				chain_[i]->visit();
@@ -66,6 +123,65 @@ namespace nCine
 		Viewport::visit();
 	}
 
+#if defined(WITH_THREADS)
+	void ScreenViewport::visitParallel()
+	{
+		visitHandle_->mutex.Lock();
+		visitList_.clear();
+		for (int i = (int)chain_.size() - 1; i >= 0; i--) {
+			if (chain_[i] && !chain_[i]->stateBits_.test(StateBitPositions::VisitedBit)) {
+				visitList_.push_back(chain_[i]);
+			}
+		}
+		visitList_.push_back(this);
+		nextVisitIndex_ = 0;
+		runningVisits_ = 0;
+
+		// Commands that are still waiting in the queue since previous frames will help with this frame instead
+		const unsigned int numHelpers = (unsigned int)visitList_.size() - 1;
+		const unsigned int numCommands = (numHelpers > queuedVisitCommands_ ? numHelpers - queuedVisitCommands_ : 0);
+		queuedVisitCommands_ += numCommands;
+		visitHandle_->mutex.Unlock();
+
+		IThreadPool& threadPool = theServiceLocator().threadPool();
+		for (unsigned int i = 0; i < numCommands; i++) {
+			threadPool.EnqueueCommand(std::make_unique<VisitCommand>(visitHandle_));
+		}
+
+		// The calling thread claims viewports too, so the visit doesn't stall when worker threads are busy
+		visitHandle_->mutex.Lock();
+		visitClaimedViewports(false);
+		while (runningVisits_ > 0) {
+			visitCV_.Wait(visitHandle_->mutex);
+		}
+		visitHandle_->mutex.Unlock();
+	}
+
+	void ScreenViewport::visitClaimedViewports(bool fromWorker)
+	{
+		if (fromWorker) {
+			queuedVisitCommands_--;
+		}
+		while (nextVisitIndex_ < visitList_.size()) {
+			Viewport* viewport = visitList_[nextVisitIndex_];
+			nextVisitIndex_++;
+			runningVisits_++;
+			visitHandle_->mutex.Unlock();
+
+			// Every viewport is visited by exactly one thread and fills its own render queue in the same order
+			// as the serial visit, queues are then sorted and committed in the chain order on the main thread,
+			// so the result doesn't depend on which thread has claimed which viewport
+			viewport->visit();
+
+			visitHandle_->mutex.Lock();
+			runningVisits_--;
+			if (runningVisits_ == 0) {
+				visitCV_.Broadcast();
+			}
+		}
+	}
+#endif
+
 	void ScreenViewport::sortAndCommitQueue()
 	{
 #if defined(NCINE_PROFILING)
@@ -2,6 +2,12 @@
 
 #include "Viewport.h"
 
+#if defined(WITH_THREADS)
+#	include "../Threading/ThreadSync.h"
+
+#	include <memory>
+#endif
+
 namespace nCine
 {
 	/// The class handling the screen viewport
@@ -10,13 +16,43 @@ namespace nCine
 	public:
 		/// Creates the screen viewport
 		ScreenViewport();
+		~ScreenViewport();
 
 		/// Changes the size, viewport rectangle and projection matrix of the screen viewport
 		void resize(int width, int height);
 
 	private:
+#if defined(WITH_THREADS)
+		class VisitCommand;
+
+		/// State shared with visit commands, which can still be queued in the thread pool after the viewport is destroyed
+		struct VisitHandle
+		{
+			Mutex mutex;
+			/// Cleared when the viewport is destroyed
+			ScreenViewport* owner;
+		};
+
+		std::shared_ptr<VisitHandle> visitHandle_;
+		/// Viewports to be visited in the current frame when the parallel visit is enabled
+		SmallVector<Viewport*, 0> visitList_;
+		/// Index of the next viewport in the list to be claimed by a thread
+		unsigned int nextVisitIndex_;
+		/// Number of claimed viewports that are still being visited
+		unsigned int runningVisits_;
+		/// Number of visit commands in the thread pool queue that have not started yet
+		unsigned int queuedVisitCommands_;
+		CondVariable visitCV_;
+#endif
+
 		void update();
 		void visit();
+#if defined(WITH_THREADS)
+		/// Visits the chain and the screen viewport on worker threads and on the calling thread
+		void visitParallel();
+		/// Visits viewports from the list until there are none left to claim, the handle mutex has to be locked
+		void visitClaimedViewports(bool fromWorker);
+#endif
 		void sortAndCommitQueue();
 		void draw();
 
@@ -147,6 +147,7 @@ namespace nCine
 	Shader::~Shader()
 	{
 		RenderResources::unregisterBatchedShader(glShaderProgram_.get());
+		RenderResources::unregisterInstancedShader(glShaderProgram_.get());
 	}
 
 	bool Shader::loadFromMemory(const char* shaderName, Introspection introspection, const char* vertex, const char* fragment, int batchSize)
@@ -417,6 +418,11 @@ namespace nCine
 		RenderResources::registerBatchedShader(glShaderProgram_.get(), batchedShader.glShaderProgram_.get());
 	}
 
+	void Shader::registerInstancedShader(Shader& instancedShader)
+	{
+		RenderResources::registerInstancedShader(glShaderProgram_.get(), instancedShader.glShaderProgram_.get());
+	}
+
 	bool Shader::loadDefaultShader(DefaultVertex vertex, int batchSize)
 	{
 #if !defined(WITH_EMBEDDED_SHADERS)
@@ -452,6 +458,9 @@ namespace nCine
 			//case DefaultVertex::BATCHED_TEXTNODES:
 			//	vertexShader = "batched_textnodes_vs.glsl";
 			//	break;
+			case DefaultVertex::INSTANCED_SPRITES:
+				vertexShader = "instanced_sprites_vs.glsl"_s;
+				break;
 		}
 
 		if (batchSize > 0) {
@@ -496,6 +505,9 @@ namespace nCine
 			//case DefaultVertex::BATCHED_TEXTNODES:
 			//	vertexShader = ShaderStrings::batched_textnodes_vs + 1;
 			//	break;
+			case DefaultVertex::INSTANCED_SPRITES:
+				vertexShader = ShaderStrings::instanced_sprites_vs + 1;
+				break;
 		}
 
 		if (batchSize > 0) {
@@ -33,7 +33,8 @@ namespace nCine
 			BATCHED_SPRITES_NOTEXTURE,
 			BATCHED_MESHSPRITES,
 			BATCHED_MESHSPRITES_NOTEXTURE,
-			//BATCHED_TEXTNODES
+			//BATCHED_TEXTNODES,
+			INSTANCED_SPRITES
 		};
 
 		enum class DefaultFragment {
@@ -107,6 +108,8 @@ namespace nCine
 
 		/// Registers a shaders to be used for batches of render commands
 		void registerBatchedShader(Shader& batchedShader);
+		/// Registers a shaders to be used for instanced rendering of sprites
+		void registerInstancedShader(Shader& instancedShader);
 
 		GLShaderProgram* getHandle() {
 			return glShaderProgram_.get();
@@ -235,9 +235,17 @@ namespace nCine
 		const unsigned char* data = bufferPtr;
 
 		const GLenum format = ncFormatToNonInternal(format_);
+		// Rows are tightly packed, the default unpack alignment of 4 bytes is not satisfied by all widths of 1-3 channel formats
+		const bool isUnaligned = ((width * numChannels()) % 4 != 0);
+		if (isUnaligned) {
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		}
 		glGetError();
 		glTexture_->texSubImage2D(level, x, y, width, height, format, GL_UNSIGNED_BYTE, data);
 		const GLenum error = glGetError();
+		if (isUnaligned) {
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		}
 
 		return (error == GL_NO_ERROR);
 	}
@@ -16,6 +16,9 @@
 #	include <qoi.h>
 #endif
 
+#include <IO/MappedStream.h>
+#include <IO/MemoryStream.h>
+
 using namespace Death::IO;
 
 namespace nCine
@@ -31,11 +34,21 @@ namespace nCine
 			return;
 		}
 
-		auto buffer = std::make_unique<char[]>(fileSize);
-		fileHandle_->Read(buffer.get(), fileSize);
+		// Files which are already in memory can be decoded directly without any copying
+		const void* fileData;
+		std::unique_ptr<char[]> buffer;
+		if (fileHandle_->GetType() == Stream::Type::Mapped) {
+			fileData = static_cast<MappedStream*>(fileHandle_.get())->GetBuffer();
+		} else if (fileHandle_->GetType() == Stream::Type::Memory) {
+			fileData = static_cast<MemoryStream*>(fileHandle_.get())->GetBuffer();
+		} else {
+			buffer = std::make_unique<char[]>(fileSize);
+			fileHandle_->Read(buffer.get(), fileSize);
+			fileData = buffer.get();
+		}
 
 		qoi_desc desc = { };
-		void* data = qoi_decode(buffer.get(), fileSize, &desc, 4);
+		void* data = qoi_decode(fileData, fileSize, &desc, 4);
 		if (data == nullptr) {
 			return;
 		}
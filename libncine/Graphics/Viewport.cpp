@@ -318,7 +318,7 @@ namespace nCine
 		calculateCullingRect();
 		if (rootNode_ != nullptr) {
 			ZoneScoped;
-			if (rootNode_->lastFrameUpdated() < theApplication().numFrames()) {
+			if (rootNode_->lastFrameUpdated() < theApplication().numUpdates()) {
 				rootNode_->OnUpdate(theApplication().timeMult());
 			}
 			// AABBs should update after nodes have been transformed
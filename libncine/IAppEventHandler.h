@@ -22,6 +22,9 @@ namespace nCine
 		virtual void OnFrameStart() { }
 		/// Called every time the scenegraph has been traversed and all nodes have been transformed
 		virtual void OnPostUpdate() { }
+		/// Called before the scenegraph is visited if fixed update rate is enabled
+		/*! The `factor` is the fraction of a fixed update that elapsed since the last one, in range [0, 1) */
+		virtual void OnInterpolateFrame(float factor) { }
 		/// Called every time a viewport is going to be drawn
 		virtual void OnDrawViewport(Viewport& viewport) { }
 		/// Called at the end of each frame, just before swapping buffers
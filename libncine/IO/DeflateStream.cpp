@@ -0,0 +1,136 @@
+#include "DeflateStream.h"
+
+#include <algorithm>
+
+#include <zlib.h>
+
+namespace Death::IO
+{
+	DeflateStream::DeflateStream(Stream& inputStream, std::int32_t inputSize, std::int32_t uncompressedSize)
+		: _inputStream(&inputStream), _inputSize(inputSize), _position(0)
+	{
+		_type = Type::Deflate;
+		// Size is not known in advance if not specified
+		_size = uncompressedSize;
+
+		_inputBuffer = std::make_unique<std::uint8_t[]>(InputBufferSize);
+
+		_strm = std::make_unique<z_stream>();
+		_strm->zalloc = Z_NULL;
+		_strm->zfree = Z_NULL;
+		_strm->opaque = Z_NULL;
+		_strm->next_in = _inputBuffer.get();
+		_strm->avail_in = 0;
+		_state = inflateInit2(_strm.get(), -15);
+		if (_state != Z_OK) {
+			_inputStream = nullptr;
+		}
+	}
+
+	DeflateStream::~DeflateStream()
+	{
+		Close();
+	}
+
+	void DeflateStream::Close()
+	{
+		if (_inputStream != nullptr) {
+			inflateEnd(_strm.get());
+			_inputStream = nullptr;
+		}
+	}
+
+	std::int32_t DeflateStream::Seek(std::int32_t offset, SeekOrigin origin) const
+	{
+		std::int32_t seekValue;
+		switch (origin) {
+			case SeekOrigin::Begin:
+				seekValue = offset;
+				break;
+			case SeekOrigin::Current:
+				seekValue = _position + offset;
+				break;
+			case SeekOrigin::End:
+				seekValue = (_size >= 0 ? _size + offset : -1);
+				break;
+			default:
+				seekValue = -1;
+				break;
+		}
+
+		if (seekValue < _position) {
+			return -1;
+		}
+
+		std::uint8_t buffer[4096];
+		while (_position < seekValue) {
+			std::int32_t bytesRead = Read(buffer, std::min((std::int32_t)sizeof(buffer), seekValue - _position));
+			if (bytesRead <= 0) {
+				return -1;
+			}
+		}
+		return _position;
+	}
+
+	std::int32_t DeflateStream::GetPosition() const
+	{
+		return _position;
+	}
+
+	std::int32_t DeflateStream::Read(void* buffer, std::int32_t bytes) const
+	{
+		DEATH_ASSERT(buffer != nullptr, 0, "buffer is nullptr");
+
+		if (_inputStream == nullptr || bytes <= 0) {
+			return 0;
+		}
+
+		_strm->next_out = static_cast<Bytef*>(buffer);
+		_strm->avail_out = (uInt)bytes;
+
+		while (_strm->avail_out > 0 && _state == Z_OK) {
+			if (_strm->avail_in == 0 && FillInput() <= 0) {
+				// Input data are truncated
+				_state = Z_DATA_ERROR;
+				break;
+			}
+			_state = inflate(_strm.get(), Z_NO_FLUSH);
+		}
+
+		std::int32_t bytesRead = bytes - (std::int32_t)_strm->avail_out;
+
+		_position += bytesRead;
+		return bytesRead;
+	}
+
+	std::int32_t DeflateStream::Write(const void* buffer, std::int32_t bytes)
+	{
+		// Not supported
+		return 0;
+	}
+
+	bool DeflateStream::IsValid() const
+	{
+		return (_inputStream != nullptr && (_state == Z_OK || _state == Z_STREAM_END));
+	}
+
+	std::int32_t DeflateStream::FillInput() const
+	{
+		std::int32_t bytesToRead = InputBufferSize;
+		if (_inputSize >= 0 && bytesToRead > _inputSize) {
+			bytesToRead = _inputSize;
+		}
+
+		std::int32_t bytesRead = (bytesToRead > 0 ? _inputStream->Read(_inputBuffer.get(), bytesToRead) : 0);
+		if (bytesRead < 0) {
+			bytesRead = 0;
+		}
+		if (_inputSize >= 0) {
+			_inputSize -= bytesRead;
+		}
+
+		_strm->next_in = _inputBuffer.get();
+		_strm->avail_in = (uInt)bytesRead;
+		return bytesRead;
+	}
+}
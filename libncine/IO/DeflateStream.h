@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Stream.h"
+
+#include <memory>
+
+struct z_stream_s;
+
+namespace Death::IO
+{
+	/**
+		@brief Read-only stream decompressing raw Deflate data from another stream on demand
+
+		Only a bounded window is kept in memory, so the uncompressed data can be parsed while
+		decompressing, without allocating the whole compressed or uncompressed buffer. Decompression
+		is done by zlib, because libdeflate has no streaming API.
+	*/
+	class DeflateStream : public Stream
+	{
+	public:
+		/** @brief Creates the stream, at most @p inputSize bytes are consumed from @p inputStream, or until its end if `-1` */
+		DeflateStream(Stream& inputStream, std::int32_t inputSize = -1, std::int32_t uncompressedSize = -1);
+		~DeflateStream() override;
+
+		void Open(FileAccessMode mode) override { }
+		void Close() override;
+		/** @brief Only forward seeking is supported, skipped data is decompressed and discarded */
+		std::int32_t Seek(std::int32_t offset, SeekOrigin origin) const override;
+		std::int32_t GetPosition() const override;
+		std::int32_t Read(void* buffer, std::int32_t bytes) const override;
+		std::int32_t Write(const void* buffer, std::int32_t bytes) override;
+
+		bool IsValid() const override;
+
+	private:
+		static constexpr std::int32_t InputBufferSize = 16384;
+
+		DeflateStream(const DeflateStream&) = delete;
+		DeflateStream& operator=(const DeflateStream&) = delete;
+
+		Stream* _inputStream;
+		mutable std::int32_t _inputSize;
+		std::unique_ptr<std::uint8_t[]> _inputBuffer;
+		mutable std::int32_t _position;
+
+		/** @brief Reads next compressed data from the input stream, returns number of bytes read */
+		std::int32_t FillInput() const;
+
+		std::unique_ptr<z_stream_s> _strm;
+		mutable std::int32_t _state;
+	};
+}
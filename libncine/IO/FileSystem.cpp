@@ -1,5 +1,6 @@
 #include "FileSystem.h"
 #include "FileStream.h"
+#include "MappedStream.h"
 #include "MemoryStream.h"
 #include "../CommonWindows.h"
 #include "../Asserts.h"
@@ -2054,12 +2055,30 @@ namespace Death::IO
 
 	std::unique_ptr<Stream> FileSystem::Open(const String& path, FileAccessMode mode)
 	{
+		bool preferMapped = ((mode & FileAccessMode::MemoryMapped) == FileAccessMode::MemoryMapped);
+		mode &= ~FileAccessMode::MemoryMapped;
+
 		std::unique_ptr<Stream> stream;
 #if defined(DEATH_TARGET_ANDROID)
 		const char* assetName = AndroidAssetStream::TryGetAssetPath(String::nullTerminatedView(path).data());
 		if (assetName != nullptr) {
 			stream = std::make_unique<AndroidAssetStream>(assetName);
 		} else
+#endif
+#if defined(DEATH_TARGET_UNIX) || (defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_WINDOWS_RT))
+		if (preferMapped && mode == FileAccessMode::Read) {
+			// Missing, empty or too large files are not mapped at all, so the error is reported only once by the regular file stream
+			std::int64_t fileSize = (IsReadableFile(path) ? GetFileSize(path) : -1);
+			if (fileSize > 0 && fileSize <= INT32_MAX) {
+				auto mappedStream = std::make_unique<MappedStream>(path);
+				mappedStream->Open(mode);
+				if (mappedStream->IsValid()) {
+					return mappedStream;
+				}
+			}
+			// Fall back to regular file stream if the file cannot be mapped
+			stream = std::make_unique<FileStream>(path);
+		} else
 #endif
 		stream = std::make_unique<FileStream>(path);
 
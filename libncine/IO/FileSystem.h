@@ -217,7 +217,12 @@ namespace Death::IO
 		static void SyncToPersistent();
 #endif
 
-		/** @brief Opens file stream with specified access mode */
+		/**
+			@brief Opens file stream with specified access mode
+
+			If @ref FileAccessMode::MemoryMapped is specified together with @ref FileAccessMode::Read, the file is mapped
+			to memory if supported, otherwise regular file stream is returned.
+		*/
 		static std::unique_ptr<Stream> Open(const Containers::String& path, FileAccessMode mode);
 
 #if defined(DEATH_TARGET_UNIX) || (defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_WINDOWS_RT))
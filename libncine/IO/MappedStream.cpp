@@ -0,0 +1,114 @@
+#include "MappedStream.h"
+#include "../Asserts.h"
+
+#include <cstring>
+
+namespace Death::IO
+{
+	MappedStream::MappedStream(const Containers::String& path)
+		: _seekOffset(0), _isOpened(false)
+	{
+		_type = Type::Mapped;
+		_path = path;
+	}
+
+	void MappedStream::Open(FileAccessMode mode)
+	{
+		if (_isOpened) {
+			LOGW("File \"%s\" is already opened", _path.data());
+			return;
+		}
+
+#if defined(DEATH_TARGET_UNIX) || (defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_WINDOWS_RT))
+		if (mode != FileAccessMode::Read) {
+			LOGE("Cannot open the file \"%s\", wrong open mode", _path.data());
+			return;
+		}
+
+		auto mappedFile = FileSystem::OpenAsMemoryMapped(_path, mode);
+		if (!mappedFile) {
+			return;
+		}
+		if (mappedFile->size() > INT32_MAX) {
+			LOGE("Cannot open the file \"%s\", file is too large", _path.data());
+			return;
+		}
+
+		_data = std::move(*mappedFile);
+		_size = (std::int32_t)_data.size();
+		_seekOffset = 0;
+		_isOpened = true;
+#else
+		LOGE("Cannot open the file \"%s\", memory mapping is not supported", _path.data());
+#endif
+	}
+
+	void MappedStream::Close()
+	{
+#if defined(DEATH_TARGET_UNIX) || (defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_WINDOWS_RT))
+		_data = { };
+#endif
+		_size = 0;
+		_seekOffset = 0;
+		_isOpened = false;
+	}
+
+	std::int32_t MappedStream::Seek(std::int32_t offset, SeekOrigin origin) const
+	{
+		std::int32_t seekValue;
+		switch (origin) {
+			case SeekOrigin::Begin:
+				seekValue = offset;
+				break;
+			case SeekOrigin::Current:
+				seekValue = _seekOffset + offset;
+				break;
+			case SeekOrigin::End:
+				seekValue = _size + offset;
+				break;
+			default:
+				seekValue = -1;
+				break;
+		}
+
+		if (seekValue < 0 || seekValue > _size) {
+			seekValue = -1;
+		} else {
+			_seekOffset = seekValue;
+		}
+		return seekValue;
+	}
+
+	std::int32_t MappedStream::GetPosition() const
+	{
+		return _seekOffset;
+	}
+
+	std::int32_t MappedStream::Read(void* buffer, std::int32_t bytes) const
+	{
+		DEATH_ASSERT(buffer != nullptr, 0, "buffer is nullptr");
+
+		std::int32_t bytesRead = 0;
+
+		if (_isOpened) {
+			bytesRead = (_seekOffset + bytes > _size ? (_size - _seekOffset) : bytes);
+			if (bytesRead > 0) {
+				std::memcpy(buffer, GetBuffer() + _seekOffset, bytesRead);
+				_seekOffset += bytesRead;
+			}
+		}
+
+		return bytesRead;
+	}
+
+	std::int32_t MappedStream::Write(const void* buffer, std::int32_t bytes)
+	{
+		// Not supported
+		return 0;
+	}
+
+	bool MappedStream::IsValid() const
+	{
+		return _isOpened;
+	}
+}
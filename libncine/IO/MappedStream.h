@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Stream.h"
+#include "FileSystem.h"
+
+namespace Death::IO
+{
+	/**
+		@brief Read-only stream over a memory-mapped file
+
+		The whole file is accessible through @ref GetBuffer() without copying, so it can be used by parsers
+		which work directly with memory. Reading values is only a copy from the mapped memory.
+
+		@partialsupport Available only on @ref DEATH_TARGET_UNIX "Unix" and non-RT @ref DEATH_TARGET_WINDOWS "Windows" platforms,
+			the stream can't be opened on other platforms.
+	*/
+	class MappedStream : public Stream
+	{
+	public:
+		explicit MappedStream(const Containers::String& path);
+
+		/** @brief Maps the file to memory, only @ref FileAccessMode::Read is supported */
+		void Open(FileAccessMode mode) override;
+		void Close() override;
+		std::int32_t Seek(std::int32_t offset, SeekOrigin origin) const override;
+		std::int32_t GetPosition() const override;
+		std::int32_t Read(void* buffer, std::int32_t bytes) const override;
+		std::int32_t Write(const void* buffer, std::int32_t bytes) override;
+
+		bool IsValid() const override;
+
+		/** @brief Returns pointer to the beginning of the file, it's valid until the stream is closed */
+		const std::uint8_t* GetBuffer() const {
+#if defined(DEATH_TARGET_UNIX) || (defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_WINDOWS_RT))
+			return reinterpret_cast<const std::uint8_t*>(_data.data());
+#else
+			return nullptr;
+#endif
+		}
+
+	private:
+		MappedStream(const MappedStream&) = delete;
+		MappedStream& operator=(const MappedStream&) = delete;
+
+#if defined(DEATH_TARGET_UNIX) || (defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_WINDOWS_RT))
+		Containers::Array<char, FileSystem::MapDeleter> _data;
+#endif
+		mutable std::int32_t _seekOffset;
+		bool _isOpened;
+	};
+}
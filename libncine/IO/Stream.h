@@ -14,6 +14,9 @@ namespace Death::IO
 		Read = 0x01,
 		Write = 0x02,
 
+		/** @brief Prefer memory-mapped @ref MappedStream for read-only access, see @ref FileSystem::Open() */
+		MemoryMapped = 0x40,
+
 #if !defined(DEATH_TARGET_WINDOWS) || defined(DEATH_TARGET_MINGW)
 		FileDescriptor = 0x80,
 #endif
@@ -35,7 +38,9 @@ namespace Death::IO
 			None,
 			File,
 			Memory,
-			AndroidAsset
+			AndroidAsset,
+			Deflate,
+			Mapped
 		};
 
 		explicit Stream() : _type(Type::None), _size(0) { }
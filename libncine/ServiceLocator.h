@@ -34,6 +34,10 @@ namespace nCine
 		IThreadPool& threadPool() {
 			return *threadPool_;
 		}
+		/// Returns true if a thread pool provider is registered, the null one discards all commands
+		bool hasThreadPool() const {
+			return (threadPool_ != &nullThreadPool_);
+		}
 		/// Registers a thread pool provider
 		void registerThreadPool(std::unique_ptr<IThreadPool> service);
 		/// Unregisters the thread pool provider and reinstates the null one
@@ -0,0 +1,25 @@
+uniform mat4 uProjectionMatrix;
+uniform mat4 uViewMatrix;
+
+in vec4 aModelMatrix0;
+in vec4 aModelMatrix1;
+in vec4 aModelMatrix2;
+in vec4 aModelMatrix3;
+in vec4 aColor;
+in vec4 aTexRect;
+in vec2 aSpriteSize;
+
+out vec2 vTexCoords;
+out vec4 vColor;
+
+void main()
+{
+	mat4 modelMatrix = mat4(aModelMatrix0, aModelMatrix1, aModelMatrix2, aModelMatrix3);
+	vec2 aPosition = vec2(0.5 - float(gl_VertexID >> 1), 0.5 - float(gl_VertexID % 2));
+	vec2 aTexCoords = vec2(1.0 - float(gl_VertexID >> 1), 1.0 - float(gl_VertexID % 2));
+	vec4 position = vec4(aPosition.x * aSpriteSize.x, aPosition.y * aSpriteSize.y, 0.0, 1.0);
+
+	gl_Position = uProjectionMatrix * uViewMatrix * modelMatrix * position;
+	vTexCoords = vec2(aTexCoords.x * aTexRect.x + aTexRect.y, aTexCoords.y * aTexRect.z + aTexRect.w);
+	vColor = aColor;
+}
@@ -6,6 +6,7 @@ struct ShaderStrings
 	static char const * const batched_meshsprites_vs;
 	static char const * const batched_sprites_notexture_vs;
 	static char const * const batched_sprites_vs;
+	static char const * const instanced_sprites_vs;
 	static char const * const meshsprite_notexture_vs;
 	static char const * const meshsprite_vs;
 	static char const * const sprite_fs;